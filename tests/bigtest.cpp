@@ -0,0 +1,1057 @@
+/*
+ * This file is a part of TTMath Bignum Library
+ * and is distributed under the 3-Clause BSD Licence.
+ * Author: Tomasz Sowa <t.sowa@ttmath.org>
+ */
+
+/* 
+ * Copyright (c) 2006-2009, Tomasz Sowa
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *    
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *    
+ *  * Neither the name Tomasz Sowa nor the names of contributors to this
+ *    project may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include "bigtest.h"
+#include <sstream>
+#include <vector>
+#include <cstring>
+#include <limits>
+
+
+
+uuint BigTest::rand()
+{
+uuint result = 0;
+
+	// xorshift generator with 32 bits state, called once or twice for one word
+	for(uuint i=0 ; i<TTMATH_BITS_PER_UINT/32 ; ++i)
+	{
+		rand_state ^= rand_state << 13;
+		rand_state ^= rand_state >> 17;
+		rand_state ^= rand_state << 5;
+
+		result = (result << 16 << 16) | rand_state;
+	}
+
+return result;
+}
+
+
+bool BigTest::rand_bool()
+{
+	return (rand() & 1) != 0;
+}
+
+
+/*
+	a random value with all bits of the mantissa set by the generator
+	and the value between 2^min_exponent and 2^(max_exponent+1)
+*/
+template<uuint exp, uuint man>
+void BigTest::rand_big(Big<exp, man> & result, int min_exponent, int max_exponent)
+{
+	result.SetOne();
+
+	for(uuint i=0 ; i<man ; ++i)
+		result.mantissa.table[i] = rand();
+
+	result.mantissa.table[man-1] |= TTMATH_UINT_HIGHEST_BIT;
+
+	int e = min_exponent + int(rand() % uuint(max_exponent - min_exponent + 1));
+	result.exponent = e - int(man * TTMATH_BITS_PER_UINT) + 1;
+
+	if( rand_bool() )
+		result.SetSign();
+}
+
+
+
+void BigTest::start(const std::string & name)
+{
+	std::cerr << name << ": ";
+	was_error = false;
+}
+
+
+void BigTest::start(const char * name, uuint exp, uuint man)
+{
+	std::cerr << "Big<" << exp << "," << man << ">::";
+	start(name);
+}
+
+
+void BigTest::error(const std::string & msg)
+{
+	if( !was_error )
+		std::cerr << std::endl;
+
+	std::cerr << "   " << msg << std::endl;
+	was_error = true;
+}
+
+
+void BigTest::stop()
+{
+	if( !was_error )
+		std::cerr << "ok" << std::endl;
+}
+
+
+
+/*
+	Div() gives the quotient with an error less than one ulp: |a - q*b| < ulp(q) * |b|
+	the left and the right side are calculated exactly on a wider type,
+	and when the quotient can be represented exactly it must be exact: (x*y)/y == x
+*/
+template<uuint exp, uuint man>
+void BigTest::test_div()
+{
+Big<exp, man> a, b, q;
+Big<exp, 3*man+1> wa, wb, wq, diff, ulp;
+
+	start("Div", exp, man);
+
+	for(int i=0 ; i<300 ; ++i)
+	{
+		rand_big(a, -100, 100);
+		rand_big(b, -100, 100);
+		q = a;
+
+		if( q.Div(b) )
+		{
+			error("carry from Div(): " + a.ToString() + " / " + b.ToString());
+			continue;
+		}
+
+		wa.FromBig(a);
+		wb.FromBig(b);
+		wq.FromBig(q);
+
+		diff = wq;
+		diff.Mul(wb);
+		diff.Sub(wa, false);
+		diff.Abs();
+
+		ulp = wb;
+		ulp.Abs();
+		ulp.exponent.Add(q.exponent);
+
+		if( diff >= ulp )
+			error("incorrect rounding: " + a.ToString() + " / " + b.ToString() + " = " + q.ToString());
+
+		// x and y have only half of the mantissa bits so x*y is exact
+		rand_big(a, -100, 100);
+		rand_big(b, -100, 100);
+		a.mantissa.Rcr(man * TTMATH_BITS_PER_UINT / 2);
+		b.mantissa.Rcr(man * TTMATH_BITS_PER_UINT / 2);
+		a.Standardizing();
+		b.Standardizing();
+
+		q = a;
+		q.Mul(b);
+		q.Div(b);
+
+		if( q != a )
+			error("not exact: (" + a.ToString() + " * " + b.ToString() + ") / " + b.ToString() + " = " + q.ToString());
+	}
+
+	stop();
+}
+
+
+
+/*
+	the reference conversion - digit by digit
+*/
+uuint BigTest::decimal_digits_to_uint(const char * s, uuint len)
+{
+uuint result = 0;
+
+	for(uuint i=0 ; i<len ; ++i)
+		result = result * 10 + uuint(s[i] - '0');
+
+return result;
+}
+
+
+void BigTest::test_decimal_digits(const char * s, uuint len)
+{
+	uuint expected = decimal_digits_to_uint(s, len);
+	uuint result   = Misc::DecimalDigitsToUInt(s, len);
+
+	if( result != expected )
+	{
+		std::ostringstream msg;
+		msg << "DecimalDigitsToUInt(\"" << std::string(s, len) << "\") = " << result;
+		error(msg.str());
+	}
+
+#if (defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined _M_IX86 || defined _M_X64
+
+	if( len == 8 && (result = Misc::EightDecimalDigitsToUInt(s)) != expected )
+	{
+		std::ostringstream msg;
+		msg << "EightDecimalDigitsToUInt(\"" << std::string(s, len) << "\") = " << result;
+		error(msg.str());
+	}
+
+#endif
+}
+
+
+/*
+	Misc::DecimalDigitsToUInt() and Misc::EightDecimalDigitsToUInt() (SWAR)
+	for all lengths and for each alignment of the string
+*/
+void BigTest::test_decimal_digits()
+{
+// the biggest number of digits which fits in uint
+const uuint max_len = (TTMATH_BITS_PER_UINT == 64) ? 19 : 9;
+char buffer[8 + 32];
+uuint align, len, i, d, k;
+
+	start("Misc::DecimalDigitsToUInt");
+
+	for(align=0 ; align<8 ; ++align)
+	{
+		char * s = buffer + align;
+
+		for(len=1 ; len<=max_len ; ++len)
+		{
+			// all the same digits: 000..., 111..., 999...
+			for(d=0 ; d<10 ; ++d)
+			{
+				for(i=0 ; i<len ; ++i)
+					s[i] = char('0' + d);
+
+				test_decimal_digits(s, len);
+			}
+
+			// one digit among zeros on each position
+			for(i=0 ; i<len ; ++i)
+			{
+				for(k=0 ; k<len ; ++k)
+					s[k] = '0';
+
+				s[i] = char('0' + 1 + i % 9);
+				test_decimal_digits(s, len);
+			}
+
+			// mixed digits
+			for(k=0 ; k<20 ; ++k)
+			{
+				for(i=0 ; i<len ; ++i)
+					s[i] = char('0' + rand() % 10);
+
+				test_decimal_digits(s, len);
+			}
+		}
+	}
+
+	stop();
+}
+
+
+
+/*
+	ToChars() should give the same string as ToString(), an exact buffer is enough,
+	a buffer smaller by one character gives err_overflow and the characters
+	after the buffer are not touched
+*/
+template<uuint exp, uuint man>
+void BigTest::test_tochars(const Big<exp, man> & x, const Conv & conv)
+{
+const size_t guard = 16;
+std::string expected;
+std::vector<char> buffer;
+ToCharsResult res;
+size_t len, i;
+
+	x.ToString(expected, conv);
+	len = expected.size();
+	buffer.resize(len + guard);
+
+	for(i=0 ; i<buffer.size() ; ++i)
+		buffer[i] = '#';
+
+	res = x.ToChars(&buffer[0], &buffer[0] + len, conv);
+
+	if( res.ec != err_ok || res.ptr != &buffer[0] + len || std::string(&buffer[0], len) != expected )
+		error("ToChars() with an exact buffer: " + expected);
+
+	for(i=0 ; i<buffer.size() ; ++i)
+		buffer[i] = '#';
+
+	res = x.ToChars(&buffer[0], &buffer[0] + len - 1, conv);
+
+	if( res.ec != err_overflow || res.ptr != &buffer[0] + len - 1 )
+		error("ToChars() with a too small buffer: " + expected);
+
+	for(i=len-1 ; i<buffer.size() ; ++i)
+		if( buffer[i] != '#' )
+		{
+			error("ToChars() has written after the buffer: " + expected);
+			break;
+		}
+}
+
+
+template<uuint exp, uuint man>
+void BigTest::test_tochars()
+{
+Big<exp, man> x;
+Conv conv;
+ToCharsResult res;
+char buffer[4];
+const uuint bases[] = {2, 8, 10, 16, 3};
+
+	start("ToChars", exp, man);
+
+	for(int i=0 ; i<100 ; ++i)
+	{
+		rand_big(x, -300, 300);
+
+		for(uuint b=0 ; b<sizeof(bases)/sizeof(uuint) ; ++b)
+		{
+			conv = Conv();
+			conv.base = bases[b];
+			test_tochars(x, conv);
+
+			// a short result (all digits are created in a local buffer and then rounded)
+			conv.round = 3;
+			test_tochars(x, conv);
+
+			conv.scient_from = 2;
+			test_tochars(x, conv);
+		}
+	}
+
+	x.SetZero();
+	test_tochars(x, Conv());
+
+	x.SetNan();
+	test_tochars(x, Conv());
+
+	x = 1;
+	res = x.ToChars(buffer, buffer, 10);
+
+	if( res.ec != err_overflow || res.ptr != buffer )
+		error("ToChars() with an empty buffer");
+
+	res = x.ToChars(buffer, buffer + sizeof(buffer), 1);
+
+	if( res.ec != err_improper_argument || res.ptr != buffer )
+		error("ToChars() with base 1");
+
+	stop();
+}
+
+
+/*
+	FromChars() should read the same value as FromString() and return the pointer
+	after the last character of the value, the value is not changed on errors
+*/
+template<uuint exp, uuint man>
+void BigTest::test_fromchars()
+{
+Big<exp, man> x, expected, old_value;
+std::string str;
+FromCharsResult res;
+Conv conv;
+const char * p;
+
+	start("FromChars", exp, man);
+	old_value = 123;
+
+	for(int i=0 ; i<100 ; ++i)
+	{
+		rand_big(x, -300, 300);
+		conv.base = (i % 2) ? 10 : 16;
+		x.ToString(str, conv);
+
+		// the rest of the input after the value is not read
+		// (in base 16 the exponent is given as "*10^" and it is not read at all)
+		str += "xyz";
+		expected.FromString(str, conv, &p);
+
+		x = old_value;
+		res = x.FromChars(str.c_str(), str.c_str() + str.size(), conv);
+
+		if( res.ec != err_ok || res.ptr != p || x != expected || (conv.base == 10 && p != str.c_str() + str.size() - 3) )
+			error("FromChars(): " + str);
+	}
+
+	// the input is read only to 'last'
+	str = "123.456";
+	x = old_value;
+	res = x.FromChars(str.c_str(), str.c_str() + 5);
+
+	if( res.ec != err_ok || res.ptr != str.c_str() + 5 || x != Big<exp, man>("123.4") )
+		error("FromChars(): part of " + str);
+
+	// nothing to read
+	const char * no_value[] = {"", "-", "x1", "+1", " 1", "-x"};
+
+	for(size_t i=0 ; i<sizeof(no_value)/sizeof(const char*) ; ++i)
+	{
+		p = no_value[i];
+		x = old_value;
+		res = x.FromChars(p, p + std::strlen(p));
+
+		if( res.ec != err_nothing_has_read || res.ptr != p || x != old_value )
+			error(std::string("FromChars(): no value in \"") + p + "\"");
+	}
+
+	x = old_value;
+	res = x.FromChars(0, 0);
+
+	if( res.ec != err_nothing_has_read || res.ptr != 0 || x != old_value )
+		error("FromChars(): null input");
+
+	// too big exponent
+	str = "1e99999999999999999999999999999999999999 ";
+	x = old_value;
+	res = x.FromChars(str.c_str(), str.c_str() + str.size());
+
+	if( res.ec != err_overflow || res.ptr != str.c_str() + str.size() - 1 || x != old_value )
+		error("FromChars(): overflow " + str);
+
+	x = old_value;
+	res = x.FromChars(str.c_str(), str.c_str() + str.size(), 17);
+
+	if( res.ec != err_improper_argument || res.ptr != str.c_str() || x != old_value )
+		error("FromChars(): base 17");
+
+	stop();
+}
+
+
+/*
+	the characters which don't fit in the BufferString are dropped
+	and nothing is written after its buffer
+*/
+void BigTest::test_buffer_string()
+{
+char buffer[8] = {'#', '#', '#', '#', '#', '#', '#', '#'};
+BufferString<char> str(buffer, 5);
+const char abc[] = "abc";
+
+	start("BufferString");
+
+	str.append(abc, abc + 3);
+
+	if( str.Overflow() || str.size() != 3 || std::string(buffer, 3) != "abc" )
+		error("append()");
+
+	str.insert(1, 2, 'x');
+
+	if( str.Overflow() || str.size() != 5 || std::string(buffer, 5) != "axxbc" )
+		error("insert()");
+
+	str.insert(0, 2, 'y');
+
+	if( !str.Overflow() || str.size() != 5 || std::string(buffer, 5) != "yyaxx" )
+		error("insert() with overflow");
+
+	str.erase(1, 2);
+
+	if( str.size() != 3 || std::string(buffer, 3) != "yxx" || str.find('x', 0) != 1 )
+		error("erase()");
+
+	str += 'z';
+	str += 'z';
+	str += 'z';
+	str.append(abc, abc + 3);
+
+	if( str.size() != 5 || std::string(buffer, 5) != "yxxzz" )
+		error("operator+=() and append() with overflow");
+
+	if( buffer[5] != '#' || buffer[6] != '#' || buffer[7] != '#' )
+		error("the characters after the buffer were changed");
+
+	stop();
+}
+
+
+
+/*
+	BigFormatter::Format() should give the same strings as Big::ToString()
+	with the same Conv, the vector version should add the strings separated
+	by the separator at the end of the result
+*/
+template<uuint exp, uuint man>
+void BigTest::test_formatter(BigFormatter<exp, man> & formatter, const std::vector< Big<exp, man> > & values)
+{
+std::string result, expected, all, all_expected;
+uuint c, expected_c = 0;
+
+	for(size_t i=0 ; i<values.size() ; ++i)
+	{
+		uuint value_c = values[i].ToString(expected, formatter.GetConv());
+		c = formatter.Format(values[i], result);
+
+		if( c != value_c || result != expected )
+		{
+			std::ostringstream msg;
+			msg << "Format() in base " << formatter.GetConv().base << ": " << result << " (expected: " << expected << ")";
+			error(msg.str());
+		}
+
+		all_expected += (i > 0) ? ";" : "prefix:";
+		all_expected += expected;
+
+		if( value_c )
+			expected_c = 1;
+	}
+
+	all = "prefix:";
+	c = formatter.Format(values, all, ';');
+
+	if( c != expected_c || all != all_expected )
+		error("Format() for a vector");
+
+#ifndef TTMATH_DONT_USE_WCHAR
+
+	std::wstring wresult, wexpected;
+
+	for(size_t i=0 ; i<values.size() ; i+=7)
+	{
+		values[i].ToString(wexpected, formatter.GetConv());
+		formatter.Format(values[i], wresult);
+
+		if( wresult != wexpected )
+			error("Format() for wstring: " + values[i].ToString(formatter.GetConv()));
+	}
+
+#endif
+}
+
+
+template<uuint exp, uuint man>
+void BigTest::test_formatter()
+{
+std::vector< Big<exp, man> > values(100);
+std::vector< Big<exp, man> > no_values;
+BigFormatter<exp, man> formatter;
+std::string result;
+Conv conv;
+
+	start("BigFormatter", exp, man);
+
+	for(size_t i=0 ; i<values.size() ; ++i)
+	{
+		// small and big exponents (Format() uses the table of powers only for the small ones)
+		if( i % 4 == 0 )
+			rand_big(values[i], -4 * int(man * TTMATH_BITS_PER_UINT), 4 * int(man * TTMATH_BITS_PER_UINT));
+		else
+			rand_big(values[i], -200, 200);
+
+		// some integers
+		if( i % 5 == 0 )
+			values[i].SkipFraction();
+	}
+
+	values[1].SetZero();
+	values[2].SetNan();
+	values[3] = 10;
+
+	// each base, changed by SetConv() so the table of powers is made again
+	// (base 10 is used twice: the table from another base would give wrong digits)
+	for(uuint base=2 ; base<=17 ; ++base)
+	{
+		conv = Conv();
+		conv.base = (base == 17) ? 10 : base;
+		formatter.SetConv(conv);
+		test_formatter(formatter, values);
+
+		// other settings without changing the base
+		conv.round       = 5;
+		conv.scient_from = 3;
+		conv.comma       = ',';
+		formatter.SetConv(conv);
+		test_formatter(formatter, values);
+	}
+
+	// a new formatter with the base given in the constructor
+	BigFormatter<exp, man> formatter16(16);
+	test_formatter(formatter16, values);
+
+	// the vector version doesn't clear the result
+	result = "abc";
+
+	if( formatter.Format(no_values, result, ';') != 0 || result != "abc" )
+		error("Format() for an empty vector");
+
+	stop();
+}
+
+
+
+/*
+	the same bits of two values (FromDouble() for NaN sets only the NaN flag
+	so the mantissa and the exponent are not compared then)
+*/
+/*
+	ToString() of values with big exponents (base^new_exp is calculated on a wider type
+	and not exactly), the digits (without base_round) are compared with the same value
+	in Big<exp, 4*man>, the difference is less than a few units of the last bit
+*/
+template<uuint exp, uuint man>
+void BigTest::test_tostring_big_exponent()
+{
+Big<exp, man> x;
+Big<exp, 4*man> wide, read, diff;
+Int<exp> e;
+Conv conv;
+std::string str;
+
+	start("ToString() with a big exponent", exp, man);
+	conv.base_round = false;
+
+	for(int i=0 ; i<200 ; ++i)
+	{
+		rand_big(x, 0, 0);
+
+		e.SetMax();
+		e.Rcr(1 + rand() % (exp * TTMATH_BITS_PER_UINT - 2), 0);
+		e.Sub(man * TTMATH_BITS_PER_UINT);
+
+		if( rand_bool() )
+			e.ChangeSign();
+
+		x.exponent = e;
+		x.ToString(str, conv);
+
+		wide.FromBig(x);
+		read.FromString(str);
+
+		diff = read;
+		diff.Sub(wide);
+		diff.Div(wide);
+		diff.Abs();
+		diff.exponent.AddInt(man * TTMATH_BITS_PER_UINT - 4);
+
+		if( read.IsNan() || diff > 1 )
+			error("ToString(): " + str + " for " + wide.ToString(conv));
+	}
+
+	stop();
+}
+
+
+template<uuint exp, uuint man>
+bool BigTest::same_bits(const Big<exp, man> & a, const Big<exp, man> & b)
+{
+	if( a.IsNan() || b.IsNan() )
+		return a.IsNan() && b.IsNan();
+
+return a.mantissa == b.mantissa && a.exponent == b.exponent && a.info == b.info;
+}
+
+
+/*
+	the same bits of two doubles or two floats (NaN is equal to NaN)
+*/
+template<class float_type>
+bool BigTest::same_bits(float_type a, float_type b)
+{
+	return std::memcmp(&a, &b, sizeof(float_type)) == 0;
+}
+
+
+/*
+	a double or a float from random bits (it can be NaN, infinity or an unnormalized value)
+*/
+template<class float_type>
+float_type BigTest::rand_float()
+{
+unsigned char bytes[sizeof(float_type)];
+float_type result;
+
+	for(size_t i=0 ; i<sizeof(float_type) ; ++i)
+		bytes[i] = (unsigned char)rand();
+
+	std::memcpy(&result, bytes, sizeof(float_type));
+
+return result;
+}
+
+
+/*
+	FromDouble(), ToDouble() and ToFloat() on arrays (and std::vector<>) give the same
+	values as the methods for one value, and the carry is set if at least
+	one value has a carry
+*/
+template<uuint exp, uuint man>
+void BigTest::test_array_conversions()
+{
+const double inf  = std::numeric_limits<double>::infinity();
+const double nan  = std::numeric_limits<double>::quiet_NaN();
+const double dmin = std::numeric_limits<double>::min();
+const double dmax = std::numeric_limits<double>::max();
+const double denorm_min = std::numeric_limits<double>::denorm_min();
+const double special[] = {0.0, -0.0, 1.0, -1.5, nan, -nan, inf, -inf, dmin, -dmin, dmin / 2, denorm_min,
+						  -denorm_min, dmax, -dmax, 0.1, 3.4e38, 3.5e38, 1.1e-38, 1e-40, 1e-50, -1e-50};
+std::vector<double> values, doubles;
+std::vector<float> floats;
+std::vector< Big<exp, man> > bigs;
+Big<exp, man> x;
+double d;
+float f;
+uuint c, expected_c;
+size_t i;
+
+	start("FromDouble/ToDouble/ToFloat (arrays)", exp, man);
+
+	values.assign(special, special + sizeof(special) / sizeof(double));
+
+	for(i=0 ; i<300 ; ++i)
+		values.push_back(rand_float<double>());
+
+	for(i=0 ; i<100 ; ++i)
+		values.push_back(double(rand_float<float>()));
+
+	c = Big<exp, man>::FromDouble(values, bigs);
+
+	if( c != 0 || bigs.size() != values.size() )
+		error("FromDouble(std::vector<double>) has returned a carry or a wrong size");
+
+	for(i=0 ; i<values.size() && i<bigs.size() ; ++i)
+	{
+		x.FromDouble(values[i]);
+
+		if( !same_bits(x, bigs[i]) )
+		{
+			std::ostringstream msg;
+			msg << "FromDouble(array) gives a different value than FromDouble(double) for: " << values[i];
+			error(msg.str());
+		}
+	}
+
+	// values out of the range of double and float
+	for(i=0 ; i<50 ; ++i)
+	{
+		rand_big(x, -1200, 1200);
+		bigs.push_back(x);
+	}
+
+	x.SetNan();
+	bigs.push_back(x);
+
+	for(int test=0 ; test<3 ; ++test)
+	{
+		// the first time all values, then only values which give no carry for double/float
+		std::vector< Big<exp, man> > part;
+
+		for(i=0 ; i<bigs.size() ; ++i)
+			if( test == 0 || (test == 1 && bigs[i].ToDouble(d) == 0) || (test == 2 && bigs[i].ToFloat(f) == 0) )
+				part.push_back(bigs[i]);
+
+		if( test < 2 )
+		{
+			c = Big<exp, man>::ToDouble(part, doubles);
+			expected_c = 0;
+
+			for(i=0 ; i<part.size() && i<doubles.size() ; ++i)
+			{
+				expected_c |= part[i].ToDouble(d);
+
+				if( !same_bits(d, doubles[i]) )
+					error("ToDouble(array) gives a different value than ToDouble(double&) for: " + part[i].ToString());
+			}
+
+			if( doubles.size() != part.size() || c != expected_c || (test == 0 && c == 0) )
+				error("ToDouble(std::vector<Big>) has returned a wrong carry or size");
+		}
+
+		if( test != 1 )
+		{
+			c = Big<exp, man>::ToFloat(part, floats);
+			expected_c = 0;
+
+			for(i=0 ; i<part.size() && i<floats.size() ; ++i)
+			{
+				expected_c |= part[i].ToFloat(f);
+
+				if( !same_bits(f, floats[i]) )
+					error("ToFloat(array) gives a different value than ToFloat(float&) for: " + part[i].ToString());
+			}
+
+			if( floats.size() != part.size() || c != expected_c || (test == 0 && c == 0) )
+				error("ToFloat(std::vector<Big>) has returned a wrong carry or size");
+		}
+	}
+
+	// empty arrays
+	values.clear();
+	bigs.push_back(x);
+
+	if( Big<exp, man>::FromDouble(values, bigs) != 0 || !bigs.empty() )
+		error("FromDouble() with an empty array");
+
+	if( Big<exp, man>::ToDouble(bigs, doubles) != 0 || !doubles.empty() ||
+		Big<exp, man>::ToFloat(bigs, floats) != 0 || !floats.empty() )
+		error("ToDouble() or ToFloat() with an empty array");
+
+	stop();
+}
+
+
+
+/*
+	the number of the digits of the mantissa in the string (the leading and the trailing zeroes
+	are not counted), the digits are read to the end of the string or to the exponent
+*/
+uuint BigTest::significant_digits(const std::string & str)
+{
+size_t i, first = std::string::npos, last = 0;
+
+	for(i=0 ; i<str.size() && str[i] != 'e' && str[i] != '*' ; ++i)
+	{
+		if( str[i] >= '1' && str[i] <= '9' )
+		{
+			if( first == std::string::npos )
+				first = i;
+
+			last = i;
+		}
+	}
+
+	if( first == std::string::npos )
+		return 0;
+
+	// the decimal point between them
+	uuint point = (str.find('.', first) < last) ? 1 : 0;
+
+return uuint(last - first + 1 - point);
+}
+
+
+/*
+	ToString() with conv.shortest is read back by FromString() to exactly the same value
+	(the same bits of the mantissa and the exponent) and it has not more than
+	max_digits significant digits (if max_digits is not zero)
+*/
+template<uuint exp, uuint man>
+void BigTest::test_shortest(const Big<exp, man> & x, uuint max_digits)
+{
+Big<exp, man> y;
+Conv conv;
+std::string str;
+
+	conv.shortest = true;
+	x.ToString(str, conv);
+
+	if( y.FromString(str, conv) != 0 || y.mantissa != x.mantissa || y.exponent != x.exponent || y.IsSign() != x.IsSign() )
+		error("ToString() is not read back to the same value: " + str);
+
+	if( max_digits != 0 && significant_digits(str) > max_digits )
+	{
+		std::ostringstream msg;
+		msg << "ToString() gives more than " << max_digits << " digits: " << str;
+		error(msg.str());
+	}
+}
+
+
+/*
+	values with the binary exponent in <-2^max_exponent_scale, -2^min_exponent_scale> and
+	<2^min_exponent_scale, 2^max_exponent_scale> (the scale is taken randomly):
+	random mantissas, powers of two, and values which are halfway between two strings
+	in decimal (read from a string with the last digit 5 and as m * 2^-k)
+*/
+template<uuint exp, uuint man>
+void BigTest::test_shortest(int min_exponent_scale, int max_exponent_scale)
+{
+Big<exp, man> x;
+Int<exp> e, decimal_e;
+std::string str, exponent_str;
+uuint digits, i;
+int s;
+bool is_sign;
+
+	for(int test=0 ; test<100 ; ++test)
+	{
+		// the binary exponent
+		s = min_exponent_scale + int(rand() % uuint(max_exponent_scale - min_exponent_scale + 1));
+		e.SetMax();
+		e.Rcr(uuint(exp * TTMATH_BITS_PER_UINT - 1 - s), 0);
+		e.table[0] ^= rand() & 0xffff;
+		e.Sub(man * TTMATH_BITS_PER_UINT);
+
+		// the decimal exponent is about e * 0.3
+		decimal_e = e;
+		decimal_e.Rcr(2, 0);
+		is_sign = rand_bool();
+
+		if( is_sign )
+		{
+			e.ChangeSign();
+			decimal_e.ChangeSign();
+		}
+
+		rand_big(x, 0, 0);
+		x.exponent = e;
+		test_shortest(x);
+
+		x.mantissa.SetZero();
+		x.mantissa.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
+		test_shortest(x);
+
+		// e.g. 1234565e-1000 (7 digits) is between 123456e-999 and 123457e-999
+		digits = 1 + rand() % (man * 17);
+		str.clear();
+
+		for(i=0 ; i<digits ; ++i)
+			str += char('1' + rand() % 9);
+
+		decimal_e.ToString(exponent_str);
+		str += "5e" + exponent_str;
+
+		if( x.FromString(str) == 0 )
+			test_shortest(x, digits + 1);
+	}
+}
+
+
+template<uuint exp, uuint man>
+void BigTest::test_shortest()
+{
+Big<exp, man> x, y;
+std::string str;
+int i;
+
+	start("ToString(shortest)", exp, man);
+
+	for(i=0 ; i<300 ; ++i)
+	{
+		rand_big(x, -300, 300);
+		test_shortest(x);
+	}
+
+	// powers of two about one
+	for(i=-300 ; i<=300 ; ++i)
+	{
+		x = 1;
+		x.exponent.Add(Int<exp>(i));
+		test_shortest(x);
+	}
+
+	// m * 2^-k (exactly halfway between the strings with k-1 and with k digits after the point)
+	for(i=0 ; i<300 ; ++i)
+	{
+		x = int(rand() % 1000000) * 2 + 1;
+		x.exponent.Sub(Int<exp>(1 + int(rand() % 60)));
+		test_shortest(x);
+	}
+
+	const char * short_values[] = {"2.675", "0.1", "0.3", "1e23", "9.999", "123456789e-20",
+		"1e-25", "1e-250", "1e250", "1.5e-1000", "7e1000", "2.2250738585072014e-308", "5e-324",
+		"1.7976931348623157e308"};
+
+	for(size_t v=0 ; v<sizeof(short_values)/sizeof(const char*) ; ++v)
+	{
+		x = short_values[v];
+		test_shortest(x, significant_digits(short_values[v]));
+
+		x.Div(3);
+		test_shortest(x);
+	}
+
+	// the binary exponent from small to the greatest one
+	test_shortest<exp, man>(6, 12);
+	test_shortest<exp, man>(12, 30);
+	test_shortest<exp, man>(30, int(exp * TTMATH_BITS_PER_UINT) - 2);
+
+	// the smallest and the greatest values
+	x.SetMin();
+	test_shortest(x);
+	x.SetMax();
+	test_shortest(x);
+
+	x.SetMax();
+	x.exponent.SubOne();
+	test_shortest(x);
+
+	x.SetMin();
+	x.exponent.AddOne();
+	test_shortest(x);
+
+	x.SetOne();
+	x.exponent.SetMin();
+	test_shortest(x);
+
+	x.SetOne();
+	x.exponent.SetMax();
+	test_shortest(x);
+
+	stop();
+}
+
+
+
+void BigTest::go()
+{
+	rand_state = 2463534242u;
+
+	test_decimal_digits();
+
+	test_div<1,1>();
+	test_div<1,2>();
+	test_div<1,3>();
+	test_div<2,4>();
+	test_div<1,8>();
+	test_div<2,16>();
+
+	test_buffer_string();
+	test_tochars<1,1>();
+	test_tochars<1,2>();
+	test_tochars<2,4>();
+	test_tochars<1,8>();
+	test_fromchars<1,1>();
+	test_fromchars<1,2>();
+	test_fromchars<2,4>();
+
+	test_formatter<1,1>();
+	test_formatter<1,2>();
+	test_formatter<2,4>();
+
+	test_tostring_big_exponent<1,1>();
+	test_tostring_big_exponent<1,2>();
+	test_tostring_big_exponent<2,4>();
+
+	test_shortest<1,1>();
+	test_shortest<1,2>();
+	test_shortest<2,1>();
+	test_shortest<2,4>();
+
+	test_array_conversions<1,1>();
+	test_array_conversions<1,2>();
+	test_array_conversions<2,4>();
+}
+
@@ -0,0 +1,106 @@
+/*
+ * This file is a part of TTMath Bignum Library
+ * and is distributed under the 3-Clause BSD Licence.
+ * Author: Tomasz Sowa <t.sowa@ttmath.org>
+ */
+
+/* 
+ * Copyright (c) 2006-2009, Tomasz Sowa
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *    
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *    
+ *  * Neither the name Tomasz Sowa nor the names of contributors to this
+ *    project may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#ifndef headerfilebigtest
+#define headerfilebigtest
+
+#include <string>
+#include <vector>
+#include <iostream>
+
+#include <ttmath/ttmath.h>
+
+using namespace ttmath;
+typedef ttmath::uint uuint;
+
+
+/*
+	the tests for Big<> (and the Misc methods used by Big<>) - they don't read a file but generate values
+	from a simple pseudo random generator (the same values on each run)
+*/
+class BigTest
+{
+
+	uuint rand_state;
+
+	bool was_error;
+
+public:
+
+	void go();
+
+
+private:
+
+	uuint rand();
+	bool rand_bool();
+
+	template<uuint exp, uuint man> void rand_big(Big<exp, man> & result, int min_exponent, int max_exponent);
+
+	void start(const std::string & name);
+	void start(const char * name, uuint exp, uuint man);
+	void error(const std::string & msg);
+	void stop();
+
+	template<uuint exp, uuint man> void test_div();
+	template<uuint exp, uuint man> void test_tochars(const Big<exp, man> & x, const Conv & conv);
+	template<uuint exp, uuint man> void test_tochars();
+	template<uuint exp, uuint man> void test_fromchars();
+	void test_buffer_string();
+	template<uuint exp, uuint man> void test_formatter(BigFormatter<exp, man> & formatter, const std::vector< Big<exp, man> > & values);
+	template<uuint exp, uuint man> void test_formatter();
+	template<uuint exp, uuint man> void test_tostring_big_exponent();
+
+	template<uuint exp, uuint man> bool same_bits(const Big<exp, man> & a, const Big<exp, man> & b);
+	template<class float_type> bool same_bits(float_type a, float_type b);
+	template<class float_type> float_type rand_float();
+	template<uuint exp, uuint man> void test_array_conversions();
+
+	uuint significant_digits(const std::string & str);
+	template<uuint exp, uuint man> void test_shortest(const Big<exp, man> & x, uuint max_digits = 0);
+	template<uuint exp, uuint man> void test_shortest(int min_exponent_scale, int max_exponent_scale);
+	template<uuint exp, uuint man> void test_shortest();
+
+	uuint decimal_digits_to_uint(const char * s, uuint len);
+	void test_decimal_digits(const char * s, uuint len);
+	void test_decimal_digits();
+
+};
+
+
+#endif
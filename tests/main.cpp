@@ -39,6 +39,7 @@
 #include <iostream>
 #include <ttmath/ttmath.h>
 #include "uinttest.h"
+#include "bigtest.h"
 
 
 
@@ -55,6 +56,14 @@ void test_uint()
 }
 
 
+void test_big()
+{
+	BigTest test;
+
+	test.go();
+}
+
+
 
 int main()
 {
@@ -62,6 +71,7 @@ using namespace ttmath;
 
 
 	test_uint();
+	test_big();
 
 
 return 0;
@@ -271,6 +271,314 @@ void UIntTest::test_addtwoints()
 }
 
 
+template<uuint type_size>
+void UIntTest::test_mul()
+{
+	UInt<type_size> a, b, result, new_result;
+	UInt<type_size*2> big_result;
+	static const uuint algorithms[] = { 1, 2, 3, 4, 5, 6, 100 };
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(b);
+	read_uint(result);
+
+	uuint carry;
+	read_uint(carry);
+
+	std::cerr << '[' << row << "] Mul<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	for(size_t i=0 ; i<sizeof(algorithms)/sizeof(uuint) ; ++i)
+	{
+		new_result = a;
+		int new_carry = new_result.Mul(b, algorithms[i]);
+
+		if( !check_result_or_carry(result, new_result, carry, new_carry) )
+		{
+			std::cerr << " (algorithm " << algorithms[i] << ")" << std::endl;
+			return;
+		}
+
+		if( carry == 0 )
+		{
+			a.MulBig(b, big_result, algorithms[i]);
+			new_carry = new_result.FromUInt(big_result);
+
+			if( !check_result_carry(result, new_result, 0, new_carry) )
+			{
+				std::cerr << " (MulBig algorithm " << algorithms[i] << ")" << std::endl;
+				return;
+			}
+		}
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
+template<uuint type_size>
+void UIntTest::test_sqr()
+{
+	UInt<type_size> a, result, new_result;
+	UInt<type_size*2> big_result;
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(result);
+
+	uuint carry;
+	read_uint(carry);
+
+	std::cerr << '[' << row << "] Sqr<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	new_result = a;
+	int new_carry = new_result.Sqr();
+
+	if( !check_result_or_carry(result, new_result, carry, new_carry) )
+	{
+		std::cerr << " (Sqr)" << std::endl;
+		return;
+	}
+
+	if( carry == 0 )
+	{
+		a.SqrBig(big_result);
+		new_carry = new_result.FromUInt(big_result);
+
+		if( !check_result_carry(result, new_result, 0, new_carry) )
+		{
+			std::cerr << " (SqrBig)" << std::endl;
+			return;
+		}
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
+template<uuint type_size>
+void UIntTest::test_div()
+{
+	UInt<type_size> a, b, quotient, remainder, new_quotient, new_remainder;
+	static const uuint algorithms[] = { 2, 3, 4, 5, 100 };
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(b);
+	read_uint(quotient);
+	read_uint(remainder);
+
+	uuint err;
+	read_uint(err);
+
+	std::cerr << '[' << row << "] Div<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	for(size_t i=0 ; i<sizeof(algorithms)/sizeof(uuint) ; ++i)
+	{
+		new_quotient = a;
+		int new_err = new_quotient.Div(b, new_remainder, algorithms[i]);
+
+		if( !check_result_or_carry(quotient, new_quotient, err, new_err) )
+		{
+			std::cerr << " (algorithm " << algorithms[i] << ")" << std::endl;
+			return;
+		}
+
+		if( err == 0 && !check_result_carry(remainder, new_remainder, 0, 0) )
+		{
+			std::cerr << " (remainder, algorithm " << algorithms[i] << ")" << std::endl;
+			return;
+		}
+	}
+
+	UIntDivisor<type_size> divisor;
+	uuint new_err = divisor.Set(b);
+
+	if( new_err != err )
+	{
+		std::cerr << "Incorrect carry: " << new_err << " (expected: " << err << ") (UIntDivisor::Set)" << std::endl;
+		return;
+	}
+
+	if( err == 0 )
+	{
+		divisor.DivMod(a, new_quotient, new_remainder);
+
+		if( !check_result_carry(quotient, new_quotient, 0, 0) ||
+			!check_result_carry(remainder, new_remainder, 0, 0) )
+		{
+			std::cerr << " (UIntDivisor::DivMod)" << std::endl;
+			return;
+		}
+
+		new_remainder = a;
+		divisor.Mod(new_remainder);
+
+		if( !check_result_carry(remainder, new_remainder, 0, 0) )
+		{
+			std::cerr << " (UIntDivisor::Mod)" << std::endl;
+			return;
+		}
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
+template<uuint type_size>
+void UIntTest::test_powmod()
+{
+	UInt<type_size> a, pow, modulus, result, new_result;
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(pow);
+	read_uint(modulus);
+	read_uint(result);
+
+	uuint err;
+	read_uint(err);
+
+	std::cerr << '[' << row << "] PowMod<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	new_result = a;
+	uuint new_err = new_result.PowMod(pow, modulus);
+
+	if( new_err != err )
+	{
+		std::cerr << "Incorrect carry: " << new_err << " (expected: " << err << ")" << std::endl;
+		return;
+	}
+
+	if( err == 0 && !check_result_carry(result, new_result, 0, 0) )
+	{
+		std::cerr << " (UInt::PowMod)" << std::endl;
+		return;
+	}
+
+	if( (modulus.table[0] & 1) == 1 )
+	{
+		UIntMontgomery<type_size> mont(modulus);
+
+		new_result = a;
+		new_err    = mont.PowMod(new_result, pow);
+
+		if( new_err != err )
+		{
+			std::cerr << "Incorrect carry: " << new_err << " (expected: " << err << ") (UIntMontgomery)" << std::endl;
+			return;
+		}
+
+		if( err == 0 && !check_result_carry(result, new_result, 0, 0) )
+		{
+			std::cerr << " (UIntMontgomery::PowMod)" << std::endl;
+			return;
+		}
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
+
+template<uuint type_size>
+void UIntTest::test_tostring()
+{
+	UInt<type_size> a, new_a;
+	std::string str, new_str;
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+
+	uuint base;
+	read_uint(base);
+
+	skip_white_characters();
+	const char * str_begin = pline;
+	uuint new_carry = new_a.FromString(pline, base, &pline);
+	str.assign(str_begin, pline);
+
+	for(size_t i=0 ; i<str.size() ; ++i)
+		str[i] = char(upper_char(str[i]));
+
+	uuint carry;
+	read_uint(carry);
+
+	std::cerr << '[' << row << "] ToString<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	if( new_carry != carry )
+	{
+		std::cerr << "Incorrect carry: " << new_carry << " (expected: " << carry << ") (UInt::FromString)" << std::endl;
+		return;
+	}
+
+	// the same digits without a terminating zero
+	UInt<type_size> chars_a;
+	FromCharsResult from_res = chars_a.FromChars(str.data(), str.data() + str.size(), base);
+
+	if( from_res.ptr != str.data() + str.size() || from_res.ec != (carry ? err_overflow : err_ok) )
+	{
+		std::cerr << "Incorrect result: " << from_res.ec << " (UInt::FromChars)" << std::endl;
+		return;
+	}
+
+	if( carry == 0 )
+	{
+		if( !check_result_carry(a, new_a, 0, 0) || !check_result_carry(a, chars_a, 0, 0) )
+		{
+			std::cerr << " (UInt::FromString)" << std::endl;
+			return;
+		}
+
+		a.ToString(new_str, base);
+
+		if( (str.size() == 1 || str[0] != '0') && new_str != str )
+		{
+			std::cerr << "Incorrect string: " << new_str << " (expected: " << str << ") (UInt::ToString)" << std::endl;
+			return;
+		}
+
+		// the buffer has exactly the size of the string and one character less
+		std::vector<char> buffer(new_str.size());
+		ToCharsResult to_res = a.ToChars(&buffer[0], &buffer[0] + buffer.size(), base);
+
+		if( to_res.ec != err_ok || std::string(&buffer[0], to_res.ptr) != new_str ||
+			a.ToChars(&buffer[0], &buffer[0] + buffer.size() - 1, base).ec != err_overflow )
+		{
+			std::cerr << "Incorrect string: " << std::string(&buffer[0], to_res.ptr) << " (expected: " << new_str << ") (UInt::ToChars)" << std::endl;
+			return;
+		}
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
 int UIntTest::upper_char(int c)
 {
 	if( c>='a' && c<='z' )
@@ -331,6 +639,139 @@ return true;
 
 
 
+template<uuint type_size>
+void UIntTest::test_sqrt()
+{
+	UInt<type_size> a, result, remainder, new_result, new_remainder;
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(result);
+	read_uint(remainder);
+
+	uuint square;
+	read_uint(square);
+
+	std::cerr << '[' << row << "] Sqrt<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	new_result = a;
+	new_result.Sqrt();
+
+	if( !check_result_carry(result, new_result, 0, 0) )
+	{
+		std::cerr << " (Sqrt)" << std::endl;
+		return;
+	}
+
+	new_result = a;
+	new_result.Sqrt(new_remainder);
+
+	if( !check_result_carry(result, new_result, 0, 0) || !check_result_carry(remainder, new_remainder, 0, 0) )
+	{
+		std::cerr << " (Sqrt(remainder))" << std::endl;
+		return;
+	}
+
+	if( a.IsPerfectSquare() != (square != 0) )
+	{
+		std::cerr << "Incorrect IsPerfectSquare(): " << a.IsPerfectSquare() << " (expected: " << square << ")" << std::endl;
+		return;
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
+template<uuint type_size>
+void UIntTest::test_root()
+{
+	UInt<type_size> a, result, new_result;
+	uuint n, err;
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(n);
+	read_uint(result);
+	read_uint(err);
+
+	std::cerr << '[' << row << "] Root<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	new_result = a;
+	uuint new_err = new_result.Root(ttmath::uint(n));
+
+	if( new_err != err )
+	{
+		std::cerr << "Incorrect error: " << new_err << " (expected: " << err << ")" << std::endl;
+		return;
+	}
+
+	if( err == 0 && !check_result_carry(result, new_result, 0, 0) )
+	{
+		std::cerr << " (Root)" << std::endl;
+		return;
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
+template<uuint type_size>
+void UIntTest::test_perfectpower()
+{
+	UInt<type_size> a, base, new_base;
+	uuint power, degree;
+	ttmath::uint new_degree;
+
+	if( !check_minmax_bits(type_size) )
+		return;
+
+	read_uint(a);
+	read_uint(power);
+	read_uint(base);
+	read_uint(degree);
+
+	std::cerr << '[' << row << "] IsPerfectPower<" << type_size << ">: ";
+
+	if( !check_end() )
+		return;
+
+	bool new_power = a.IsPerfectPower(&new_base, &new_degree);
+
+	if( new_power != (power != 0) )
+	{
+		std::cerr << "Incorrect result: " << new_power << " (expected: " << power << ")" << std::endl;
+		return;
+	}
+
+	if( power != 0 )
+	{
+		if( !check_result_carry(base, new_base, 0, 0) )
+		{
+			std::cerr << " (base)" << std::endl;
+			return;
+		}
+
+		if( new_degree != degree )
+		{
+			std::cerr << "Incorrect degree: " << new_degree << " (expected: " << degree << ")" << std::endl;
+			return;
+		}
+	}
+
+	std::cerr << "ok" << std::endl;
+}
+
+
 void UIntTest::test_method()
 {
 const char * p = pline;
@@ -374,6 +815,110 @@ const char * p = pline;
 		pline = p; test_addtwoints<9>();
 	}
 	else
+	if( method == "MUL" )
+	{
+		pline = p; test_mul<1>();
+		pline = p; test_mul<2>();
+		pline = p; test_mul<3>();
+		pline = p; test_mul<4>();
+		pline = p; test_mul<5>();
+		pline = p; test_mul<6>();
+		pline = p; test_mul<7>();
+		pline = p; test_mul<8>();
+		pline = p; test_mul<9>();
+	}
+	else
+	if( method == "SQR" )
+	{
+		pline = p; test_sqr<1>();
+		pline = p; test_sqr<2>();
+		pline = p; test_sqr<3>();
+		pline = p; test_sqr<4>();
+		pline = p; test_sqr<5>();
+		pline = p; test_sqr<6>();
+		pline = p; test_sqr<7>();
+		pline = p; test_sqr<8>();
+		pline = p; test_sqr<9>();
+	}
+	else
+	if( method == "DIV" )
+	{
+		pline = p; test_div<1>();
+		pline = p; test_div<2>();
+		pline = p; test_div<3>();
+		pline = p; test_div<4>();
+		pline = p; test_div<5>();
+		pline = p; test_div<6>();
+		pline = p; test_div<7>();
+		pline = p; test_div<8>();
+		pline = p; test_div<9>();
+	}
+	else
+	if( method == "POWMOD" )
+	{
+		pline = p; test_powmod<1>();
+		pline = p; test_powmod<2>();
+		pline = p; test_powmod<3>();
+		pline = p; test_powmod<4>();
+		pline = p; test_powmod<5>();
+		pline = p; test_powmod<6>();
+		pline = p; test_powmod<7>();
+		pline = p; test_powmod<8>();
+		pline = p; test_powmod<9>();
+	}
+	else
+	if( method == "SQRT" )
+	{
+		pline = p; test_sqrt<1>();
+		pline = p; test_sqrt<2>();
+		pline = p; test_sqrt<3>();
+		pline = p; test_sqrt<4>();
+		pline = p; test_sqrt<5>();
+		pline = p; test_sqrt<6>();
+		pline = p; test_sqrt<7>();
+		pline = p; test_sqrt<8>();
+		pline = p; test_sqrt<9>();
+	}
+	else
+	if( method == "ROOT" )
+	{
+		pline = p; test_root<1>();
+		pline = p; test_root<2>();
+		pline = p; test_root<3>();
+		pline = p; test_root<4>();
+		pline = p; test_root<5>();
+		pline = p; test_root<6>();
+		pline = p; test_root<7>();
+		pline = p; test_root<8>();
+		pline = p; test_root<9>();
+	}
+	else
+	if( method == "PERFECTPOWER" )
+	{
+		pline = p; test_perfectpower<1>();
+		pline = p; test_perfectpower<2>();
+		pline = p; test_perfectpower<3>();
+		pline = p; test_perfectpower<4>();
+		pline = p; test_perfectpower<5>();
+		pline = p; test_perfectpower<6>();
+		pline = p; test_perfectpower<7>();
+		pline = p; test_perfectpower<8>();
+		pline = p; test_perfectpower<9>();
+	}
+	else
+	if( method == "TOSTRING" )
+	{
+		pline = p; test_tostring<1>();
+		pline = p; test_tostring<2>();
+		pline = p; test_tostring<3>();
+		pline = p; test_tostring<4>();
+		pline = p; test_tostring<5>();
+		pline = p; test_tostring<6>();
+		pline = p; test_tostring<7>();
+		pline = p; test_tostring<8>();
+		pline = p; test_tostring<9>();
+	}
+	else
 	{
 		std::cerr << '[' << row << "] ";
 		std::cerr << "method " << method << " is not supported" << std::endl;
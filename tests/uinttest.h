@@ -80,6 +80,14 @@ bool read_uint(UInt<type_size> & result);
 	template<uuint type_size> void test_add();
 	template<uuint type_size> void test_addint();
 	template<uuint type_size> void test_addtwoints();
+	template<uuint type_size> void test_mul();
+	template<uuint type_size> void test_sqr();
+	template<uuint type_size> void test_div();
+	template<uuint type_size> void test_powmod();
+	template<uuint type_size> void test_sqrt();
+	template<uuint type_size> void test_root();
+	template<uuint type_size> void test_perfectpower();
+	template<uuint type_size> void test_tostring();
 
 	template<uuint type_size> bool check_result_carry(const ttmath::UInt<type_size> & result, const ttmath::UInt<type_size> & new_result,
 						int carry, int new_carry);
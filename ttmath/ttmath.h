@@ -57,6 +57,7 @@
 
 #include "ttmathbig.h"
 #include "ttmathobjects.h"
+#include "ttmathformatter.h"
 
 
 namespace ttmath
@@ -449,7 +450,7 @@ namespace ttmath
 
 			// d_numerator = x^2
 			d_numerator = x;
-			d_numerator.Mul(x);
+			d_numerator.Sqr();
 
 			d_denominator = 2;
 		}
@@ -719,7 +720,7 @@ namespace ttmath
 	ValueType nominator_temp, denominator_temp, old_result = result;
 	uint c = 0;
 
-	x2.Mul(x);
+	x2.Sqr();
 	two = 2;
 
 	nominator.SetOne();
@@ -944,7 +945,7 @@ namespace ttmath
 		old_result    = result;
 		nominator     = x;
 		nominator_add = x;
-		nominator_add.Mul(x);
+		nominator_add.Sqr();
 
 		denominator.SetOne();
 		denominator_add = 2;
@@ -1363,7 +1364,7 @@ namespace ttmath
 		uint c = 0;
 		one.SetOne();
 
-		c += xx.Mul(x);
+		c += xx.Sqr();
 		c += xx.Add(one);
 		one.exponent.SubOne(); // one=0.5
 		// xx is >= 1 
@@ -1407,7 +1408,7 @@ namespace ttmath
 		return result; // NaN is set by default
 		}
 
-		c += xx.Mul(x);
+		c += xx.Sqr();
 		c += xx.Sub(one);
 		// xx is >= 0
 		// we can't call a PowFrac when the 'x' is zero
@@ -47,15 +47,17 @@
 #include "ttmaththreads.h"
 
 #include <iostream>
-
-#ifdef TTMATH_MULTITHREADS
-#include <signal.h>
-#endif
+#include <cmath>
+#include <csignal>
 
 namespace ttmath
 {
 
 
+template <uint exp, uint man>
+class BigFormatter;
+
+
 /*!
 	\brief Big implements the floating point numbers
 */
@@ -141,6 +143,7 @@ public:
 		-  asm_gcc_64  - with asm for GCC (64 bit)
 		-  no_asm_32   - pure C++ version (32 bit) - without any asm code
 		-  no_asm_64   - pure C++ version (64 bit) - without any asm code
+		-  asm_gcc_64_adx - with asm for GCC (64 bit) and MULX/ADCX/ADOX instructions
 	*/
 	static const char * LibTypeStr()
 	{
@@ -1305,8 +1308,6 @@ private:
 	TTMATH_REFERENCE_ASSERT( ss2 )
 
 	UInt<man*2> man_result;
-	uint c = 0;
-	uint i;
 
 		if( IsNan() || ss2.IsNan() )
 			return CheckCarry(1);
@@ -1323,6 +1324,21 @@ private:
 		// man_result = mantissa * ss2.mantissa
 		mantissa.MulBig(ss2.mantissa, man_result);
 
+	return MulSetResult(man_result, ss2.exponent, IsSign() != ss2.IsSign(), round);
+	}
+
+
+	/*!
+		an auxiliary method for the multiplication and squaring
+
+		it sets the mantissa from the product of the mantissas (man_result)
+		and calculates the new exponent, 'negative' is the sign of the result
+	*/
+	uint MulSetResult(UInt<man*2> & man_result, const Int<exp> & ss2_exponent, bool negative, bool round)
+	{
+	uint c = 0;
+	uint i;
+
 		// 'i' will be from 0 to man*TTMATH_BITS_PER_UINT
 		// because mantissa and ss2.mantissa are standardized 
 		// (the highest bit in man_result is set to 1 or
@@ -1334,7 +1350,7 @@ private:
 		if( exp_add )
 			c += exponent.Add( exp_add );
 
-		c += exponent.Add( ss2.exponent );
+		c += exponent.Add( ss2_exponent );
 
 		for(i=0 ; i<man ; ++i)
 			mantissa.table[i] = man_result.table[i+man];
@@ -1345,17 +1361,17 @@ private:
 			c += RoundHalfToEven(is_half);		
 		}
 
-		if( IsSign() == ss2.IsSign() )
-		{
-			// the signs are the same, the result is positive
-			Abs();
-		}
-		else
+		if( negative )
 		{
 			// the signs are different, the result is negative
 			// if the value is zero it will be corrected later in Standardizing method
 			SetSign();
 		}
+		else
+		{
+			// the signs are the same, the result is positive
+			Abs();
+		}
 
 		c += Standardizing();
 
@@ -1373,14 +1389,33 @@ public:
 	uint Mul(const Big<exp, man> & ss2, bool round = true)
 	{
 		if( this == &ss2 )
-		{
-			Big<exp, man> copy_ss2(ss2);
-			return MulRef(copy_ss2, round);
-		}
-		else
-		{
-			return MulRef(ss2, round);
-		}
+			return Sqr(round);
+
+	return MulRef(ss2, round);
+	}
+
+
+	/*!
+		squaring this = this * this
+		this method returns a carry
+
+		the result is the same as from Mul(*this) but the mantissa is squared
+		by UInt::SqrBig() which is faster than the multiplication
+	*/
+	uint Sqr(bool round = true)
+	{
+	UInt<man*2> man_result;
+
+		if( IsNan() )
+			return CheckCarry(1);
+
+		if( IsZero() )
+			return 0;
+
+		mantissa.SqrBig(man_result);
+		Int<exp> exponent_copy(exponent);
+
+	return MulSetResult(man_result, exponent_copy, false, round);
 	}
 
 
@@ -1393,6 +1428,10 @@ private:
 		-  0 - ok
 		-  1 - carry (in a division carry can be as well)
 		-  2 - improper argument (ss2 is zero)
+
+		the mantissas are divided by UInt::Div() or by UInt::Div5() (the Newton division)
+		when the mantissa has at least TTMATH_USE_NEWTON_DIVISION_FROM_SIZE words,
+		both give the same quotient so the rounding is the same
 	*/
 	uint DivRef(const Big<exp, man> & ss2, bool round = true)
 	{
@@ -1428,7 +1467,10 @@ private:
 			man2.table[i+man] = 0;
 		}
 
-		man1.Div(man2);
+		if( man >= TTMATH_USE_NEWTON_DIVISION_FROM_SIZE )
+			man1.Div5(man2);
+		else
+			man1.Div(man2);
 
 		i = man1.CompensationToLeft();
 
@@ -1614,7 +1656,7 @@ public:
 			if( pow.IsZero() )
 				break;
 
-			c += start.Mul(start);
+			c += start.Sqr();
 		}
 
 		*this = result;
@@ -1709,7 +1751,7 @@ public:
 			if( pow < one )
 				break;
 
-			c += start.Mul(start);
+			c += start.Sqr();
 		}
 
 		*this = result;
@@ -1827,6 +1869,8 @@ public:
 		this function calculates the square root
 		e.g. let this=9 then this.Sqrt() gives 3
 
+		the result is correctly rounded (to the nearest value)
+
 		return:
 		-  0 - ok
 		-  1 - carry
@@ -1843,36 +1887,176 @@ public:
 		if( IsZero() )
 			return 0;
 
-		Big<exp, man> old(*this);
-		Big<exp, man> ln;
-		uint c = 0;
+		/*
+			this = mantissa * 2^exponent
+			we're taking an integer v = mantissa * 2^sh (sh is man*TTMATH_BITS_PER_UINT
+			or one less so that exponent-sh is even) and calculating an integer r = sqrt(v)
+			which has man*TTMATH_BITS_PER_UINT bits, the result is r * 2^((exponent-sh)/2)
+		*/
+		Int<exp> new_exponent(exponent);
+		sint rem;
+		uint c = new_exponent.DivInt(2, &rem);
 
-		// we're using the formula: sqrt(x) = e ^ (ln(x) / 2)
-		c += ln.Ln(*this);
-		c += ln.exponent.SubOne(); // ln = ln / 2
-		c += Exp(ln);
+		bool odd = (rem != 0);
+		UInt<man> r;
 
-		// above formula doesn't give accurate results for some integers
-		// e.g. Sqrt(81) would not be 9 but a value very closed to 9
-		// we're rounding the result, calculating result*result and comparing
-		// with the old value, if they are equal then the result is an integer too
+		if( rem == 1 )
+			c += new_exponent.AddOne();
 
-		if( !c && old.IsInteger() && !IsInteger() )
-		{
-			Big<exp, man> temp(*this);
-			c += temp.Round();
+		c += new_exponent.Sub( sint(man*TTMATH_BITS_PER_UINT/2) );
 
-			Big<exp, man> temp2(temp);
-			c += temp.Mul(temp2);
+		Sqrt_Approximate(odd, r);
 
-			if( temp == old )
-				*this = temp2;
+		if( Sqrt_Round(odd, r) )
+		{
+			// r was rounded up to 2^(man*TTMATH_BITS_PER_UINT)
+			r.SetZero();
+			r.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
+			c += new_exponent.AddOne();
 		}
 
+		mantissa = r;
+		exponent = new_exponent;
+
 	return CheckCarry(c);
 	}
 
 
+private:
+
+
+	/*!
+		an auxiliary function for calculating the square root
+
+		it calculates an approximation of sqrt(x) * 2^(man*TTMATH_BITS_PER_UINT) where x is
+		the mantissa moved to <0.5, 1) (or to <0.25, 0.5) if 'odd' is true),
+		first 1/sqrt(x) is taken from the 'double' type and then it is improved by Newton's
+		iterations y = y + y * (1 - x*y*y) / 2 (each iteration doubles the number of correct bits,
+		we don't need a division here), at the end sqrt(x) = x*y + y * (x - (x*y)^2) / 2
+	*/
+	void Sqrt_Approximate(bool odd, UInt<man> & r) const
+	{
+	Big<exp, man> x, y, s, t;
+	double d;
+
+		x.mantissa = mantissa;
+		x.info     = 0;
+		x.exponent = -sint(man*TTMATH_BITS_PER_UINT) - (odd ? 1 : 0);
+
+		x.ToDouble(d);
+
+		// FromDouble() doesn't touch the mantissa and the exponent for NaN
+		// so the compiler would warn about uninitialized 'y' (d is never NaN here)
+		y.SetZero();
+		y.FromDouble(1.0 / std::sqrt(d));
+
+		for(uint bits = 50 ; bits < man*TTMATH_BITS_PER_UINT/2 + 8 ; bits *= 2)
+		{
+			t = y;
+			t.Sqr();
+			t.Mul(x);
+			s.SetOne();
+			s.Sub(t);
+			s.Mul(y);
+
+			if( !s.IsZero() )
+			{
+				s.exponent.SubOne();
+				y.Add(s);
+			}
+		}
+
+		s = x;
+		s.Mul(y);
+		t = s;
+		t.Sqr();
+		t.ChangeSign();
+		t.Add(x);
+		t.Mul(y);
+
+		if( !t.IsZero() )
+		{
+			t.exponent.SubOne();
+			s.Add(t);
+		}
+
+		// s should be from <0.5, 1)
+		if( s.exponent == -sint(man*TTMATH_BITS_PER_UINT) )
+		{
+			r = s.mantissa;
+		}
+		else
+		if( s.exponent > -sint(man*TTMATH_BITS_PER_UINT) )
+		{
+			r.SetMax();
+		}
+		else
+		{
+			r.SetZero();
+			r.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
+		}
+	}
+
+
+	/*!
+		an auxiliary function for calculating the square root
+
+		r is an approximation of sqrt(v) where v = mantissa * 2^(man*TTMATH_BITS_PER_UINT)
+		(or 2^(man*TTMATH_BITS_PER_UINT-1) if 'odd' is true), the method corrects r
+		on integers so that r*r <= v < (r+1)*(r+1) and then rounds it to the nearest value
+		(r is rounded up if v - r*r > r, a half cannot be here)
+
+		it returns true if r was rounded up to 2^(man*TTMATH_BITS_PER_UINT)
+		(r is zero then)
+	*/
+	bool Sqrt_Round(bool odd, UInt<man> & r) const
+	{
+	UInt<2*man> v, square, remainder, twice_r;
+	uint i;
+
+		for(i=0 ; i<man ; ++i)
+		{
+			v.table[i]     = 0;
+			v.table[man+i] = mantissa.table[i];
+		}
+
+		if( odd )
+			v.Rcr(1);
+
+		while( true )
+		{
+			r.SqrBig(square);
+
+			if( square > v )
+			{
+				r.SubOne();
+				continue;
+			}
+
+			remainder = v;
+			remainder.Sub(square);
+
+			for(i=0 ; i<man ; ++i)
+			{
+				twice_r.table[i]     = r.table[i];
+				twice_r.table[man+i] = 0;
+			}
+
+			twice_r.Rcl(1);
+
+			if( remainder <= twice_r )
+				break;
+
+			// (r+1)*(r+1) <= v
+			r.AddOne();
+		}
+
+		twice_r.Rcr(1);
+
+	return (remainder > twice_r) ? (r.AddOne() != 0) : false;
+	}
+
+
 private:
 
 #ifdef TTMATH_CONSTANTSGENERATOR
@@ -1952,21 +2136,18 @@ public:
 	/*!
 		Exponent this = exp(x) = e^x
 
-		we're using the fact that our value is stored in form of:
-
-			x = mantissa * 2^exponent
-
-		then
+		x is reduced by ln(2): x = k*ln(2) + r where k = round(x/ln(2)) and |r| <= ln(2)/2
+		then e^x = e^r * 2^k (k is added to the exponent)
 
-			e^x = e^(mantissa* 2^exponent) or
-			e^x = (e^mantissa)^(2^exponent)
+		e^r is calculated with one more word in the mantissa by the Taylor series
+		of e^(r/2^s) and s squarings (ExpSquaring())
+		(for mantissas from TTMATH_USE_LN_EXP_TABLES_FROM_SIZE to TTMATH_LN_EXP_TABLES_MAX_SIZE words
+		r is reduced by the tables at first - ExpTables())
 
-		'Exp' returns a carry if we can't count the result ('x' is too big)
+		'Exp' returns a carry if we can't count the result ('x' is too big or too small)
 	*/
 	uint Exp(const Big<exp,man> & x)
 	{
-	uint c = 0;
-		
 		if( x.IsNan() )
 			return CheckCarry(1);
 
@@ -1976,52 +2157,28 @@ public:
 		return 0;
 		}
 
-		// m will be the value of the mantissa in range (-1,1)
-		Big<exp,man> m(x);
-		m.exponent = -sint(man*TTMATH_BITS_PER_UINT);
-
-		// 'e_' will be the value of '2^exponent'
-		//   e_.mantissa.table[man-1] = TTMATH_UINT_HIGHEST_BIT;  and
-		//   e_.exponent.Add(1) mean:
-		//     e_.mantissa.table[0] = 1;
-		//     e_.Standardizing();
-		//     e_.exponent.Add(man*TTMATH_BITS_PER_UINT)
-		//     (we must add 'man*TTMATH_BITS_PER_UINT' because we've taken it from the mantissa)
-		Big<exp,man> e_(x);
-		e_.mantissa.SetZero();
-		e_.mantissa.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
-		c += e_.exponent.Add(1);
-		e_.Abs();
-
-		/*
-			now we've got:
-			m - the value of the mantissa in range (-1,1)
-			e_ - 2^exponent
+		Int<exp> k;
+		Big<exp, man+1> r;
 
-			e_ can be as:
-			...2^-2, 2^-1, 2^0, 2^1, 2^2 ...
-			...1/4 , 1/2 , 1  , 2  , 4   ...
+		if( ExpReduce(x, k, r) )
+			return CheckCarry(1);
 
-			above one e_ is integer
+		if( man >= TTMATH_USE_LN_EXP_TABLES_FROM_SIZE && man <= TTMATH_LN_EXP_TABLES_MAX_SIZE )
+			ExpTables(r);
+		else
+			ExpSquaring(r);
 
-			if e_ is greater than 1 we calculate the exponent as:
-				e^(m * e_) = ExpSurrounding0(m) ^ e_
-			and if e_ is smaller or equal one we calculate the exponent in this way:
-				e^(m * e_) = ExpSurrounding0(m* e_)
-			because if e_ is smaller or equal 1 then the product of m*e_ is smaller or equal m
-		*/
+		uint c = FromBig(r);
 
-		if( e_ <= 1 )
-		{
-			m.Mul(e_);
-			ExpSurrounding0(m);
-		}
-		else
+		// rounding the lowest word which has been cut off
+		if( (r.mantissa.table[0] & TTMATH_UINT_HIGHEST_BIT) != 0 && mantissa.AddOne() )
 		{
-			ExpSurrounding0(m);
-			c += PowUInt(e_);
+			mantissa.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
+			c += exponent.AddOne();
 		}
-	
+
+		c += exponent.Add(k);
+
 	return CheckCarry(c);
 	}
 
@@ -2030,139 +2187,890 @@ public:
 
 private:
 
-#ifdef TTMATH_CONSTANTSGENERATOR
-public:
-#endif
 
 	/*!
-		Natural logarithm this = ln(x) where x in range <1,2)
+		an auxiliary method for Exp()
 
-		we're using the formula:
-		ln x = 2 * [ (x-1)/(x+1) + (1/3)((x-1)/(x+1))^3 + (1/5)((x-1)/(x+1))^5 + ... ]
+		k = round(x / ln(2)), r = x - k*ln(2)
+		(calculated on Big<exp, man+exp+1> so the bits which are lost when subtracting
+		k*ln(2) are still there)
+
+		it returns 1 if k is too big
 	*/
-	void LnSurrounding1(const Big<exp,man> & x, uint * steps = 0)
+	static uint ExpReduce(const Big<exp,man> & x, Int<exp> & k, Big<exp, man+1> & r)
 	{
-		Big<exp,man> old_value, next_part, denominator, one, two, x1(x), x2(x);
+	Big<exp, man+exp+1> x2, ln2, k2;
 
-		one.SetOne();
+		// FromBig() sets only the NaN flag for NaN so the compiler would warn
+		// about uninitialized 'x2' (x is never NaN here)
+		x2.SetZero();
+		x2.FromBig(x);
+		ln2.SetLn2();
 
-		if( x == one )
+		k2 = x2;
+
+		if( k2.Div(ln2) || k2.Round() || k2.ToInt(k) )
+			return 1;
+
+		if( !k.IsZero() )
 		{
-			// LnSurrounding1(1) is 0
-			SetZero();
-			return;
+			ln2.Mul(k2);
+			x2.Sub(ln2);
 		}
 
-		two = 2;
+		r.FromBig(x2);
 
-		x1.Sub(one);
-		x2.Add(one);
+	return 0;
+	}
 
-		x1.Div(x2);
-		x2 = x1;
-		x2.Mul(x1);
 
-		denominator.SetOne();
-		SetZero();
+	/*!
+		an auxiliary method for Exp()
 
-		old_value = *this;
-		uint i;
+		r = e^r where |r| <= ln(2)/2
 
+		r is divided by 2^s and u = e^(r/2^s) - 1 is calculated from the Taylor series
+		(each term is made from the previous one by one multiplication and a division
+		of the mantissa by a word), then e^r = (1+u)^(2^s) by s squarings (1+u)^2 = 1 + 2u + u^2,
+		about s bits are lost so s is not greater than a half of the bits in one word
 
-	#ifdef TTMATH_CONSTANTSGENERATOR
-		for(i=1 ; true ; ++i)
-	#else
-		// we begin from 1 in order to not test at the beginning
-		for(i=1 ; i<=TTMATH_ARITHMETIC_MAX_LOOP ; ++i)
-	#endif
+		if |r| is already smaller than 2^(-reduced_bits) fewer squarings are made
+	*/
+	template<uint work_man>
+	static void ExpSquaring(Big<exp, work_man> & r, uint reduced_bits = 0)
+	{
+		if( r.IsZero() )
 		{
-			bool testing = ((i & 3) == 0); // it means '(i % 4) == 0'
+			r.SetOne();
+			return;
+		}
 
-			next_part = x1;
+		uint bits = work_man * TTMATH_BITS_PER_UINT;
+		uint s;
 
-			if( next_part.Div(denominator) )
-				// if there is a carry here we only break the loop 
-				// however the result we return as good
-				// it means there are too many parts of the formula
-				break;
+		for(s=1 ; s < TTMATH_BITS_PER_UINT/2 && (s+reduced_bits)*(s+reduced_bits) < bits ; ++s);
 
-			// there shouldn't be a carry here
-			Add(next_part);
+		r.exponent.SubInt(s);
 
-			if( testing )
-			{
-				if( old_value == *this )
-					// we've added next (step_test) parts of the formula but the result
-					// is still the same then we break the loop
-					break;
-				else
-					old_value = *this;
-			}
+		Big<exp, work_man> u(r), term(r), old_value;
+		uint i;
 
-			if( x1.Mul(x2) )
-				// if there is a carry here the result we return as good
-				break;
+		for(i=2 ; i<=TTMATH_ARITHMETIC_MAX_LOOP ; ++i)
+		{
+			term.Mul(r);
+			term.mantissa.DivInt(i);
+			term.Standardizing();
 
-			if( denominator.Add(two) )
+			old_value = u;
+			u.Add(term);
+
+			if( term.IsZero() || u == old_value )
 				break;
 		}
 
-		// this = this * 2
-		// ( there can't be a carry here because we calculate the logarithm between <1,2) )
-		exponent.AddOne();
-
-		if( steps )
-			*steps = i;
-	}
-
+		for(i=0 ; i<s ; ++i)
+		{
+			term = u;
+			term.Sqr();
 
+			if( !u.IsZero() )
+				u.exponent.AddOne();
 
+			u.Add(term);
+		}
 
-public:
+		r.SetOne();
+		r.Add(u);
+	}
 
 
 	/*!
-		Natural logarithm this = ln(x)
-		(a logarithm with the base equal 'e')
+		the tables for reducing the arguments of Ln() and Exp() (with one more word in the mantissa)
 
-		we're using the fact that our value is stored in form of:
-
-			x = mantissa * 2^exponent
+		Ln():
+		x in <1,2) is multiplied by ln_q1[i]/2^16 where i is made from the first 8 bits
+		of the fraction and then by ln_q2[j+256]/2^24 where j = round((y-1)*2^16),
+		ln1[i] = ln(2^16 / ln_q1[i]), ln2[j+256] = ln(2^24 / ln_q2[j+256]),
+		at the end |y-1| is about 2^(-17)
 
-		then
+		Exp():
+		e^r = e^(j1/2^8) * e^(j2/2^16) * e^(r - j1/2^8 - j2/2^16) where |r| <= ln(2)/2,
+		exp1[j1+90] = e^(j1/2^8), exp2[j2+128] = e^(j2/2^16)
+	*/
+	struct LnExpTables
+	{
+		uint ln_q1[256];
+		uint ln_q2[513];
+		Big<exp, man+1> ln1[256];
+		Big<exp, man+1> ln2[513];
+		Big<exp, man+1> exp1[181];
+		Big<exp, man+1> exp2[257];
+	};
 
-			ln(x) = ln (mantissa * 2^exponent) = ln (mantissa) + (exponent * ln (2))
 
-		the mantissa we'll show as a value from range <1,2) because the logarithm
-		is decreasing too fast when 'x' is going to 0
+	/*!
+		an auxiliary method for the tables
 
-		return values:
-		-  	0 - ok
-		-  	1 - overflow (carry)
-		-  	2 - incorrect argument (x<=0)
+		result = ln(p/q) = 2 * atanh( (p-q)/(p+q) ), p and q are integers smaller than 2^26,
+		the series is calculated on integers (fixed point) so each part is made from
+		the previous one by multiplications and divisions by words
 	*/
-	uint Ln(const Big<exp,man> & x)
+	static void LnExpTablesLn(uint p, uint q, Big<exp, man+1> & result)
 	{
-		if( x.IsNan() )
-			return CheckCarry(1);
+	UInt<man+3> part, sum, temp;
+	uint a = (p > q) ? p - q : q - p;
+	uint b = p + q;
 
-		if( x.IsSign() || x.IsZero() )
+		if( a == 0 )
 		{
-			SetNan();
-			return 2;
+			result.SetZero();
+			return;
 		}
 
-		Big<exp,man> exponent_temp;
-		exponent_temp.FromInt( x.exponent );
+		// part = (a/b) * 2^((man+1)*TTMATH_BITS_PER_UINT)
+		part.SetZero();
+		part.table[man+1] = a;
+		part.DivInt(b);
+		sum.SetZero();
 
-		// m will be the value of the mantissa in range <1,2)
-		Big<exp,man> m(x);
-		m.exponent = -sint(man*TTMATH_BITS_PER_UINT - 1);
+		for(uint i=1 ; !part.IsZero() ; i+=2)
+		{
+			temp = part;
+			temp.DivInt(i);
+			sum.Add(temp);
 
-		// we must add 'man*TTMATH_BITS_PER_UINT-1' because we've taken it from the mantissa
-		uint c = exponent_temp.Add(man*TTMATH_BITS_PER_UINT-1);
+			part.MulInt(a);
+			part.DivInt(b);
+			part.MulInt(a);
+			part.DivInt(b);
+		}
 
-	    LnSurrounding1(m);
+		result.FromUInt(sum);
+		result.exponent.SubInt((man+1)*TTMATH_BITS_PER_UINT - 1);
+
+		if( p < q )
+			result.SetSign();
+	}
+
+
+	/*!
+		an auxiliary method for the tables
+
+		result = e^(j / 2^bits) calculated from the Taylor series on integers (fixed point)
+	*/
+	static void LnExpTablesExp(uint j, uint bits, Big<exp, man+1> & result)
+	{
+	UInt<man+3> part, sum;
+
+		// part = 1 * 2^((man+1)*TTMATH_BITS_PER_UINT)
+		part.SetZero();
+		part.table[man+1] = 1;
+		sum = part;
+
+		for(uint i=1 ; ; ++i)
+		{
+			part.MulInt(j);
+			part.Rcr(bits);
+			part.DivInt(i);
+
+			if( part.IsZero() )
+				break;
+
+			sum.Add(part);
+		}
+
+		result.FromUInt(sum);
+		result.exponent.SubInt((man+1)*TTMATH_BITS_PER_UINT);
+	}
+
+
+	/*!
+		an auxiliary method for the tables
+
+		it calculates all values in the tables
+		(the multipliers can be taken from a double, the logarithms are made for them)
+	*/
+	static void LnExpTablesGenerate(LnExpTables & tables)
+	{
+	sint i;
+
+		for(i=0 ; i<256 ; ++i)
+		{
+			// about 2^16 / (1 + (i+0.5)/2^8), values in <1, 1+2^(-8)) are not reduced
+			// so there is no cancellation when x is close to one
+			tables.ln_q1[i] = (i == 0) ? 65536 : uint(33554432.0 / double(513 + 2*i) + 0.5);
+			LnExpTablesLn(65536, tables.ln_q1[i], tables.ln1[i]);
+		}
+
+		for(i=-256 ; i<=256 ; ++i)
+		{
+			// about 2^24 / (1 + i/2^16)
+			tables.ln_q2[i+256] = uint(1099511627776.0 / double(65536 + i) + 0.5);
+			LnExpTablesLn(16777216, tables.ln_q2[i+256], tables.ln2[i+256]);
+		}
+
+		for(i=0 ; i<=90 ; ++i)
+		{
+			LnExpTablesExp(uint(i), 8, tables.exp1[90+i]);
+			tables.exp1[90-i].SetOne();
+			tables.exp1[90-i].Div(tables.exp1[90+i]);
+		}
+
+		for(i=0 ; i<=128 ; ++i)
+		{
+			LnExpTablesExp(uint(i), 16, tables.exp2[128+i]);
+			tables.exp2[128-i].SetOne();
+			tables.exp2[128-i].Div(tables.exp2[128+i]);
+		}
+	}
+
+
+#ifndef TTMATH_MULTITHREADS
+
+	/*!
+		an auxiliary method for Ln() and Exp()
+
+		it returns the tables for this type, they are calculated once (when used the first time)
+		(local_tables is used only in the multithreaded version)
+	*/
+	static const LnExpTables & GetLnExpTables(std::vector<LnExpTables> &)
+	{
+		// this guardian is initialized before the program runs (static POD type)
+		static int guardian = 0;
+		static LnExpTables tables;
+
+		if( guardian == 0 )
+		{
+			LnExpTablesGenerate(tables);
+			guardian = 1;
+		}
+
+	return tables;
+	}
+
+#else
+
+	/*!
+		an auxiliary method for Ln() and Exp()
+
+		it returns the tables for this type, they are calculated once (when used the first time)
+
+		if the lock cannot be taken the tables are calculated in local_tables
+		(one element) which belongs to the caller
+	*/
+	static const LnExpTables & GetLnExpTables(std::vector<LnExpTables> & local_tables)
+	{
+		// this guardian is initialized before the program runs (static POD type)
+		volatile static std::sig_atomic_t guardian = 0;
+		static LnExpTables * ptables;
+
+		// double-checked locking
+		if( guardian == 0 )
+		{
+			ThreadLock thread_lock;
+
+			// locking
+			if( thread_lock.Lock() )
+			{
+				static LnExpTables tables;
+
+				if( guardian == 0 )
+				{
+					ptables = &tables;
+					LnExpTablesGenerate(tables);
+					guardian = 1;
+				}
+			}
+			else
+			{
+				// there was a problem with locking, we calculate the tables directly
+				// in the caller's object (they are too big for the stack)
+				local_tables.resize(1);
+				LnExpTablesGenerate(local_tables[0]);
+
+			return local_tables[0];
+			}
+
+			// automatically unlocking
+		}
+
+	return *ptables;
+	}
+
+#endif
+
+
+	/*!
+		an auxiliary method for Exp()
+
+		r = e^r where |r| <= ln(2)/2, r is reduced by the tables (see LnExpTables)
+		to |r| <= 2^(-17) and then ExpSquaring() is used
+	*/
+	static void ExpTables(Big<exp, man+1> & r)
+	{
+	std::vector<LnExpTables> local_tables;
+	const LnExpTables & tables = GetLnExpTables(local_tables);
+	sint j1, j2;
+
+		j1 = ExpTablesIndex(r, 8);
+		j2 = ExpTablesIndex(r, 16);
+
+		ExpSquaring(r, 17);
+
+		r.Mul(tables.exp1[90 + j1]);
+		r.Mul(tables.exp2[128 + j2]);
+	}
+
+
+	/*!
+		an auxiliary method for ExpTables()
+
+		it returns j = round(r * 2^bits) and r = r - j/2^bits
+	*/
+	static sint ExpTablesIndex(Big<exp, man+1> & r, uint bits)
+	{
+	Big<exp, man+1> t(r);
+	sint j = 0;
+
+		if( t.IsZero() )
+			return 0;
+
+		t.exponent.AddInt(bits);
+		t.Round();
+		t.ToInt(j);
+
+		if( j != 0 )
+		{
+			t = j;
+			t.exponent.SubInt(bits);
+			r.Sub(t);
+		}
+
+	return j;
+	}
+
+
+private:
+
+#ifdef TTMATH_CONSTANTSGENERATOR
+public:
+#endif
+
+	/*!
+		Natural logarithm this = ln(x) where x in range <1,2)
+
+		we're using the formula:
+		ln x = 2 * [ (x-1)/(x+1) + (1/3)((x-1)/(x+1))^3 + (1/5)((x-1)/(x+1))^5 + ... ]
+	*/
+	void LnSurrounding1(const Big<exp,man> & x, uint * steps = 0)
+	{
+		Big<exp,man> old_value, next_part, denominator, one, two, x1(x), x2(x);
+
+		one.SetOne();
+
+		if( x == one )
+		{
+			// LnSurrounding1(1) is 0
+			SetZero();
+			return;
+		}
+
+		two = 2;
+
+		x1.Sub(one);
+		x2.Add(one);
+
+		x1.Div(x2);
+		x2 = x1;
+		x2.Sqr();
+
+		denominator.SetOne();
+		SetZero();
+
+		old_value = *this;
+		uint i;
+
+
+	#ifdef TTMATH_CONSTANTSGENERATOR
+		for(i=1 ; true ; ++i)
+	#else
+		// we begin from 1 in order to not test at the beginning
+		for(i=1 ; i<=TTMATH_ARITHMETIC_MAX_LOOP ; ++i)
+	#endif
+		{
+			bool testing = ((i & 3) == 0); // it means '(i % 4) == 0'
+
+			next_part = x1;
+
+			if( next_part.Div(denominator) )
+				// if there is a carry here we only break the loop 
+				// however the result we return as good
+				// it means there are too many parts of the formula
+				break;
+
+			// there shouldn't be a carry here
+			Add(next_part);
+
+			if( testing )
+			{
+				if( old_value == *this )
+					// we've added next (step_test) parts of the formula but the result
+					// is still the same then we break the loop
+					break;
+				else
+					old_value = *this;
+			}
+
+			if( x1.Mul(x2) )
+				// if there is a carry here the result we return as good
+				break;
+
+			if( denominator.Add(two) )
+				break;
+		}
+
+		// this = this * 2
+		// ( there can't be a carry here because we calculate the logarithm between <1,2) )
+		exponent.AddOne();
+
+		if( steps )
+			*steps = i;
+	}
+
+
+private:
+
+
+	/*!
+		an auxiliary method for the AGM logarithm
+
+		a = AGM(a, b) - the arithmetic-geometric mean of a and b (both greater than zero)
+
+		a(n+1) = (a(n) + b(n)) / 2, b(n+1) = sqrt(a(n) * b(n)),
+		when a and b have the same first half of the bits the next arithmetic mean
+		is the result (the convergence is quadratic)
+	*/
+	template<uint work_man>
+	static void LnAgmMean(Big<exp, work_man> & a, Big<exp, work_man> b)
+	{
+	Big<exp, work_man> a_old, diff;
+	Int<exp> diff_exponent;
+	const Int<exp> half_bits( sint(work_man * TTMATH_BITS_PER_UINT / 2) );
+
+		for(uint i=0 ; i<TTMATH_ARITHMETIC_MAX_LOOP ; ++i)
+		{
+			diff = a;
+			diff.Sub(b);
+
+			if( diff.IsZero() )
+				break;
+
+			diff_exponent = a.exponent;
+			diff_exponent.Sub(diff.exponent);
+
+			a_old = a;
+			a.Add(b);
+			a.exponent.SubOne();
+
+			if( diff_exponent > half_bits )
+				break;
+
+			b.Mul(a_old);
+			b.Sqrt();
+		}
+	}
+
+
+	/*!
+		an auxiliary method for the AGM logarithm
+
+		pi is calculated by the Gauss-Legendre (Brent-Salamin) algorithm:
+		a = 1, b = 1/sqrt(2), t = 1/4 and in each step
+		a' = (a+b)/2, b' = sqrt(a*b), t' = t - 2^i * (a-a')^2, then pi = (a+b)^2 / (4t)
+	*/
+	template<uint work_man>
+	static void LnAgmPi(Big<exp, work_man> & pi)
+	{
+	Big<exp, work_man> a, b, t, t_old, a_old, diff;
+
+		a.SetOne();
+		b.SetOne();
+		b.exponent.SubOne();
+		b.Sqrt();
+		t.SetOne();
+		t.exponent.SubInt(2);
+
+		for(uint i=0 ; i<TTMATH_ARITHMETIC_MAX_LOOP ; ++i)
+		{
+			a_old = a;
+			a.Add(b);
+			a.exponent.SubOne();
+
+			b.Mul(a_old);
+			b.Sqrt();
+
+			diff = a_old;
+			diff.Sub(a);
+
+			if( diff.IsZero() )
+				break;
+
+			diff.Sqr();
+			diff.exponent.AddInt(i);
+
+			t_old = t;
+			t.Sub(diff);
+
+			if( t == t_old )
+				break;
+		}
+
+		pi = a;
+		pi.Add(b);
+		pi.Sqr();
+		t.exponent.AddInt(2);
+		pi.Div(t);
+	}
+
+
+	/*!
+		an auxiliary method for the AGM logarithm
+
+		ln(2) = ln(2^m) / m where ln(2^m) = pi / (2*AGM(1, 4/2^m)) for 2^m greater
+		than the square root of the precision
+	*/
+	template<uint work_man>
+	static void LnAgmLn2(const Big<exp, work_man> & pi, Big<exp, work_man> & ln2)
+	{
+	Big<exp, work_man> a, b, m;
+	uint bits = work_man * TTMATH_BITS_PER_UINT / 2 + 1;
+
+		a.SetOne();
+		b.SetOne();
+		b.exponent.SubInt(bits - 2);
+		LnAgmMean(a, b);
+
+		a.exponent.AddOne();
+		ln2 = pi;
+		ln2.Div(a);
+
+		m = bits;
+		ln2.Div(m);
+	}
+
+
+#ifndef TTMATH_MULTITHREADS
+
+	/*!
+		an auxiliary method for the AGM logarithm
+
+		it sets pi and ln(2), the builtin values are used if the mantissa is not greater
+		than TTMATH_BUILTIN_VARIABLES_SIZE, otherwise the constants are calculated
+		by the AGM once and remembered
+	*/
+	template<uint work_man>
+	static void LnAgmConstants(Big<exp, work_man> & pi, Big<exp, work_man> & ln2)
+	{
+		if( work_man <= TTMATH_BUILTIN_VARIABLES_SIZE )
+		{
+			pi.SetPi();
+			ln2.SetLn2();
+			return;
+		}
+
+		// this guardian is initialized before the program runs (static POD type)
+		static int guardian = 0;
+		static Big<exp, work_man> cached_pi, cached_ln2;
+
+		if( guardian == 0 )
+		{
+			LnAgmPi(cached_pi);
+			LnAgmLn2(cached_pi, cached_ln2);
+			guardian = 1;
+		}
+
+		pi  = cached_pi;
+		ln2 = cached_ln2;
+	}
+
+#else
+
+	/*!
+		an auxiliary method for the AGM logarithm
+
+		it sets pi and ln(2), the builtin values are used if the mantissa is not greater
+		than TTMATH_BUILTIN_VARIABLES_SIZE, otherwise the constants are calculated
+		by the AGM once and remembered
+	*/
+	template<uint work_man>
+	static void LnAgmConstants(Big<exp, work_man> & pi, Big<exp, work_man> & ln2)
+	{
+		if( work_man <= TTMATH_BUILTIN_VARIABLES_SIZE )
+		{
+			pi.SetPi();
+			ln2.SetLn2();
+			return;
+		}
+
+		// this guardian is initialized before the program runs (static POD type)
+		volatile static std::sig_atomic_t guardian = 0;
+		static Big<exp, work_man> * pcached_pi;
+		static Big<exp, work_man> * pcached_ln2;
+
+		// double-checked locking
+		if( guardian == 0 )
+		{
+			ThreadLock thread_lock;
+
+			// locking
+			if( thread_lock.Lock() )
+			{
+				static Big<exp, work_man> cached_pi, cached_ln2;
+
+				if( guardian == 0 )
+				{
+					pcached_pi  = &cached_pi;
+					pcached_ln2 = &cached_ln2;
+					LnAgmPi(cached_pi);
+					LnAgmLn2(cached_pi, cached_ln2);
+					guardian = 1;
+				}
+			}
+			else
+			{
+				// there was a problem with locking, we calculate the constants directly
+				LnAgmPi(pi);
+				LnAgmLn2(pi, ln2);
+
+			return;
+			}
+
+			// automatically unlocking
+		}
+
+		pi  = *pcached_pi;
+		ln2 = *pcached_ln2;
+	}
+
+#endif
+
+
+	/*!
+		an auxiliary method for Ln()
+
+		it returns true if |x - 1| < 2^(-TTMATH_BITS_PER_UINT), the logarithm of such a value
+		is too small to be calculated by LnAgm() (too many bits would be lost when k*ln(2)
+		is subtracted)
+	*/
+	static bool LnCloseToOne(const Big<exp,man> & x)
+	{
+	Big<exp,man> diff(x), limit;
+
+		limit.SetOne();
+		diff.Sub(limit);
+		limit.exponent.SubInt(TTMATH_BITS_PER_UINT);
+
+	return diff.SmallerWithoutSignThan(limit);
+	}
+
+
+	/*!
+		Natural logarithm this = ln(x) calculated from the arithmetic-geometric mean
+		(x > 0 and x is not close to one)
+
+		x is multiplied by 2^k so that s = x * 2^k is greater than 2^(bits/2), then
+		ln(s) = pi / (2*AGM(1, 4/s)) (the error is about 1/s^2) and ln(x) = ln(s) - k*ln(2),
+		the calculations are made with two more words in the mantissa
+		(a few bits are lost when k*ln(2) is subtracted)
+	*/
+	uint LnAgm(const Big<exp,man> & x)
+	{
+	Big<exp, man+2> a, s, pi, ln2, k;
+	sint bits = sint((man+2) * TTMATH_BITS_PER_UINT / 2 + 1);
+
+		// ln(x) = ln(s) + k*ln(2), where s = (x's mantissa) * 2^bits and
+		// k = x.exponent + (the bits of the mantissa) - bits
+		k.FromInt(x.exponent);
+		k.Add( Big<exp, man+2>(sint(man * TTMATH_BITS_PER_UINT) - bits) );
+
+		s.FromBig(x);
+		s.exponent = bits - sint((man+2) * TTMATH_BITS_PER_UINT);
+
+		a.SetOne();
+		a.exponent.AddInt(2);
+		a.Div(s);
+
+		s.SetOne();
+		LnAgmMean(s, a);
+
+		LnAgmConstants(pi, ln2);
+		s.exponent.AddOne();
+		pi.Div(s);
+
+		ln2.Mul(k);
+		pi.Add(ln2);
+
+		uint c = FromBig(pi);
+
+		// rounding the lowest words which have been cut off
+		if( (pi.mantissa.table[1] & TTMATH_UINT_HIGHEST_BIT) != 0 && mantissa.AddOne() )
+		{
+			mantissa.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
+			c += exponent.AddOne();
+		}
+
+	return c;
+	}
+
+
+	/*!
+		Natural logarithm this = ln(x) where the argument is reduced by the tables
+		(x > 0 and x is not close to one)
+
+		the mantissa in <1,2) is multiplied by two words from the tables (see LnExpTables)
+		so y is close to one, then ln(y) = 2 * [ z + (1/3)z^3 + (1/5)z^5 + ... ] where
+		z = (y-1)/(y+1), |z| is about 2^(-18) so each part gives 36 bits
+	*/
+	uint LnTables(const Big<exp,man> & x)
+	{
+	std::vector<LnExpTables> local_tables;
+	const LnExpTables & tables = GetLnExpTables(local_tables);
+	Big<exp, man+1> y, z, z2, part, sum, old_sum, one, k;
+	uint i = (x.mantissa.table[man-1] >> (TTMATH_BITS_PER_UINT - 9)) & 0xff;
+	sint j = 0;
+
+		one.SetOne();
+
+		// y = the mantissa in range <1,2)
+		y.FromBig(x);
+		y.exponent = -sint(man*TTMATH_BITS_PER_UINT) - sint(TTMATH_BITS_PER_UINT - 1);
+
+		y.MulUInt(tables.ln_q1[i]);
+		y.exponent.SubInt(16);
+
+		z = y;
+		z.Sub(one);
+
+		if( !z.IsZero() )
+		{
+			z.exponent.AddInt(16);
+			z.Round();
+			z.ToInt(j);
+		}
+
+		y.MulUInt(tables.ln_q2[256 + j]);
+		y.exponent.SubInt(24);
+
+		z = y;
+		z.Sub(one);
+		part = y;
+		part.Add(one);
+		z.Div(part);
+
+		sum = z;
+
+		if( !z.IsZero() )
+		{
+			z2 = z;
+			z2.Sqr();
+			part = z;
+
+			for(uint d=3 ; d<=TTMATH_ARITHMETIC_MAX_LOOP ; d+=2)
+			{
+				part.Mul(z2);
+				z = part;
+				z.mantissa.DivInt(d);
+				z.Standardizing();
+
+				old_sum = sum;
+				sum.Add(z);
+
+				if( z.IsZero() || sum == old_sum )
+					break;
+			}
+
+			sum.exponent.AddOne();
+		}
+
+		sum.Add(tables.ln1[i]);
+		sum.Add(tables.ln2[256 + j]);
+
+		// ln(x) = ln(mantissa) + k*ln(2)
+		k.FromInt(x.exponent);
+		k.Add( Big<exp, man+1>(sint(man * TTMATH_BITS_PER_UINT - 1)) );
+		z.SetLn2();
+		z.Mul(k);
+		sum.Add(z);
+
+		uint c = FromBig(sum);
+
+		// rounding the lowest word which has been cut off
+		if( (sum.mantissa.table[0] & TTMATH_UINT_HIGHEST_BIT) != 0 && mantissa.AddOne() )
+		{
+			mantissa.table[man-1] = TTMATH_UINT_HIGHEST_BIT;
+			c += exponent.AddOne();
+		}
+
+	return c;
+	}
+
+
+public:
+
+
+	/*!
+		Natural logarithm this = ln(x)
+		(a logarithm with the base equal 'e')
+
+		we're using the fact that our value is stored in form of:
+
+			x = mantissa * 2^exponent
+
+		then
+
+			ln(x) = ln (mantissa * 2^exponent) = ln (mantissa) + (exponent * ln (2))
+
+		the mantissa we'll show as a value from range <1,2) because the logarithm
+		is decreasing too fast when 'x' is going to 0
+
+		if the mantissa has from TTMATH_USE_LN_EXP_TABLES_FROM_SIZE to TTMATH_LN_EXP_TABLES_MAX_SIZE
+		words the argument is reduced by the tables (LnTables()), otherwise if the mantissa has
+		at least TTMATH_USE_AGM_LOGARITHM_FROM_SIZE words the logarithm is calculated from
+		the arithmetic-geometric mean by LnAgm() (both only if x is not very close to one)
+
+		return values:
+		-  	0 - ok
+		-  	1 - overflow (carry)
+		-  	2 - incorrect argument (x<=0)
+	*/
+	uint Ln(const Big<exp,man> & x)
+	{
+		if( x.IsNan() )
+			return CheckCarry(1);
+
+		if( x.IsSign() || x.IsZero() )
+		{
+			SetNan();
+			return 2;
+		}
+
+		if( man >= TTMATH_USE_LN_EXP_TABLES_FROM_SIZE && man <= TTMATH_LN_EXP_TABLES_MAX_SIZE && !LnCloseToOne(x) )
+			return CheckCarry(LnTables(x));
+
+		if( man >= TTMATH_USE_AGM_LOGARITHM_FROM_SIZE && !LnCloseToOne(x) )
+			return CheckCarry(LnAgm(x));
+
+		Big<exp,man> exponent_temp;
+		exponent_temp.FromInt( x.exponent );
+
+		// m will be the value of the mantissa in range <1,2)
+		Big<exp,man> m(x);
+		m.exponent = -sint(man*TTMATH_BITS_PER_UINT - 1);
+
+		// we must add 'man*TTMATH_BITS_PER_UINT-1' because we've taken it from the mantissa
+		uint c = exponent_temp.Add(man*TTMATH_BITS_PER_UINT-1);
+
+	    LnSurrounding1(m);
 
 		Big<exp,man> ln2;
 		ln2.SetLn2();
@@ -3110,6 +4018,201 @@ private:
 #endif
 
 
+public:
+
+
+	/*!
+		this method converts 'count' doubles from 'values' into 'result'
+		(result[i] = values[i], the same as FromDouble() for each value)
+
+		on 64bit platforms normalized values are put directly into the mantissa
+		and the exponent, zeroes, unnormalized values and NaN/infinity are converted
+		by FromDouble(double)
+
+		it never returns a carry
+	*/
+	static uint FromDouble(const double * values, Big<exp, man> * result, std::size_t count)
+	{
+	#ifdef TTMATH_PLATFORM64
+
+		for( ; count > 0 ; ++values, ++result, --count )
+		{
+			union
+			{
+				double d;
+				uint u;
+			} temp;
+
+			temp.d = *values;
+			uint e = (temp.u & 0x7FF0000000000000ul) >> 52;
+
+			if( e > 0 && e < 2047 )
+				result->FromDouble_SetNormalized(e, (temp.u & 0xFFFFFFFFFFFFFul) << 11, temp.u >> 63);
+			else
+				result->FromDouble(*values);
+		}
+
+	#else
+
+		for( ; count > 0 ; ++values, ++result, --count )
+			result->FromDouble(*values);
+
+	#endif
+
+	return 0;
+	}
+
+
+	/*!
+		this method converts all doubles from 'values' into 'result'
+		(result has the same size as values then)
+	*/
+	static uint FromDouble(const std::vector<double> & values, std::vector< Big<exp, man> > & result)
+	{
+		result.resize(values.size());
+
+		if( values.empty() )
+			return 0;
+
+	return FromDouble(&values[0], &result[0], values.size());
+	}
+
+
+	/*!
+		this method converts 'count' values into doubles
+		(result[i] = values[i], the same as ToDouble(double &) for each value)
+
+		values which give normalized doubles are put together directly from
+		the fields, the rest is converted by ToDouble(double &)
+
+		it returns 1 if at least one value was too big or too small for a double
+	*/
+	static uint ToDouble(const Big<exp, man> * values, double * result, std::size_t count)
+	{
+	uint c = 0;
+
+		for( ; count > 0 ; ++values, ++result, --count )
+			c += values->ToDouble_Normalized(*result);
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		this method converts all values into doubles
+		(result has the same size as values then)
+	*/
+	static uint ToDouble(const std::vector< Big<exp, man> > & values, std::vector<double> & result)
+	{
+		result.resize(values.size());
+
+		if( values.empty() )
+			return 0;
+
+	return ToDouble(&values[0], &result[0], values.size());
+	}
+
+
+	/*!
+		this method converts 'count' values into floats
+		(result[i] = values[i], the same as ToFloat(float &) for each value)
+
+		it returns 1 if at least one value was too big or too small for a float
+	*/
+	static uint ToFloat(const Big<exp, man> * values, float * result, std::size_t count)
+	{
+	double result_double;
+	uint c = 0;
+
+		for( ; count > 0 ; ++values, ++result, --count )
+		{
+			// the same as in ToFloat(float &)
+			uint cd = values->ToDouble_Normalized(result_double);
+			*result = float(result_double);
+
+			if( *result == -0.0f )
+				*result = 0.0f;
+
+			if( cd || values->IsInf(*result) || (*result == 0.0f && result_double != 0.0) )
+				c = 1;
+		}
+
+	return c;
+	}
+
+
+	/*!
+		this method converts all values into floats
+		(result has the same size as values then)
+	*/
+	static uint ToFloat(const std::vector< Big<exp, man> > & values, std::vector<float> & result)
+	{
+		result.resize(values.size());
+
+		if( values.empty() )
+			return 0;
+
+	return ToFloat(&values[0], &result[0], values.size());
+	}
+
+
+private:
+
+
+	/*!
+		an auxiliary method for the conversions of arrays
+
+		it sets a normalized double (0 < e < 2047) from its fields:
+		e - the biased exponent, m - the fraction moved to the highest bits, s - the sign bit
+	*/
+	void FromDouble_SetNormalized(uint e, uint m, uint s)
+	{
+		exponent = sint(e) - 1023 - sint(man*TTMATH_BITS_PER_UINT) + 1;
+		mantissa.table[man-1] = m | TTMATH_UINT_HIGHEST_BIT;
+
+		for(uint i=0 ; i<man-1 ; ++i)
+			mantissa.table[i] = 0;
+
+		info = (s != 0) ? TTMATH_BIG_SIGN : 0;
+	}
+
+
+	/*!
+		an auxiliary method for the conversions of arrays
+
+		the same as ToDouble(double &) but a value which gives a normalized double
+		(-1023 < e < 1024) is put together directly from the fields
+	*/
+	uint ToDouble_Normalized(double & result) const
+	{
+	#ifdef TTMATH_PLATFORM64
+
+		const sint e_correction = sint(man*TTMATH_BITS_PER_UINT) - 1;
+		sint e;
+
+		if( !IsZero() && !IsNan() && exponent.ToInt(e) == 0 &&
+			e > -1023 - e_correction && e < 1024 - e_correction )
+		{
+			union
+			{
+				double d;
+				uint u;
+			} temp;
+
+			temp.u  = IsSign() ? 0x8000000000000000ul : 0;
+			temp.u |= uint(e + e_correction + 1023) << 52;
+			temp.u |= (mantissa.table[man-1] >> 11) & 0xFFFFFFFFFFFFFul;
+			result  = temp.d;
+
+		return 0;
+		}
+
+	#endif
+
+	return ToDouble(result);
+	}
+
+
 public:
 
 
@@ -3836,6 +4939,107 @@ public:
 #endif
 
 
+	/*!
+		a method for converting into the buffer first...last-1 (without a terminating zero),
+		similar to std::to_chars()
+		struct Conv is defined in ttmathtypes.h, look there for more information about parameters
+
+		if the buffer is too small then err_overflow is returned
+		(ToCharsResult is defined in ttmathtypes.h)
+
+		all digits of the new mantissa are created first and then they are rounded (conv.round)
+		so if the buffer is smaller than ToChars_BufferSize(conv.base) characters the value
+		is converted in a local buffer of that size (and then copied), the local buffer is on
+		the stack if it is not greater than TTMATH_STACK_BUFFER_MAX_SIZE words, otherwise
+		it is allocated on the heap,
+		err_overflow can be returned if that local buffer is too small for the value
+		before rounding e.g. with a big conv.scient_from and a small conv.round
+	*/
+	ToCharsResult ToChars(char * first, char * last, const Conv & conv) const
+	{
+	ToCharsResult res;
+	const size_t max_size   = (man + exp + 2) * TTMATH_BITS_PER_UINT + 64;
+	const size_t stack_size = (max_size < TTMATH_STACK_BUFFER_MAX_SIZE * sizeof(uint)) ? max_size : TTMATH_STACK_BUFFER_MAX_SIZE * sizeof(uint);
+	char stack_buffer[stack_size];
+	std::vector<char> heap_buffer;
+
+		if( conv.base<2 || conv.base>16 )
+		{
+			res.ptr = first;
+			res.ec  = err_improper_argument;
+			return res;
+		}
+
+		res.ptr = last;
+		res.ec  = err_overflow;
+
+		if( first >= last )
+			return res;
+
+		size_t size       = size_t(last - first);
+		size_t local_size = ToChars_BufferSize(conv.base);
+		bool use_local    = size < local_size;
+		char * buffer     = first;
+
+		if( use_local )
+		{
+			if( local_size <= stack_size )
+			{
+				buffer = stack_buffer;
+			}
+			else
+			{
+				heap_buffer.resize(local_size);
+				buffer = &heap_buffer[0];
+			}
+		}
+
+		BufferString<char> result(buffer, use_local ? local_size : size);
+
+		if( ToStringBase<BufferString<char>, char>(result, conv) || result.Overflow() || result.size() > size )
+			return res;
+
+		if( use_local )
+			std::memcpy(first, buffer, result.size());
+
+		res.ptr = first + result.size();
+		res.ec  = err_ok;
+
+	return res;
+	}
+
+
+	/*!
+		a method for converting into the buffer first...last-1 (without a terminating zero),
+		similar to std::to_chars()
+	*/
+	ToCharsResult ToChars(char * first, char * last, uint base = 10) const
+	{
+		Conv conv;
+		conv.base = base;
+
+	return ToChars(first, last, conv);
+	}
+
+
+
+	/*!
+		how many characters ToChars() needs for all digits of the mantissa and the exponent
+		before rounding (in the given base), with some room for the sign, the comma,
+		the exponent sign and a few zeros
+	*/
+	static size_t ToChars_BufferSize(uint base)
+	{
+	uint digit_bits = 1;
+
+		// the number of bits which one digit has at least (floor(log2(base)))
+		while( (uint(2) << digit_bits) <= base )
+			++digit_bits;
+
+	return (man + exp + 2) * TTMATH_BITS_PER_UINT / digit_bits + 64;
+	}
+
+
 
 private:
 
@@ -3844,7 +5048,8 @@ private:
 		an auxiliary method for converting into the string
 	*/
 	template<class string_type, class char_type>
-	uint ToStringBase(string_type & result, const Conv & conv) const
+	uint ToStringBase(string_type & result, const Conv & conv,
+					  const std::vector< UInt<3*man+1> > * powers = 0) const
 	{
 		static char error_overflow_msg[] = "overflow";
 		static char error_nan_msg[]      = "NaN";
@@ -3869,6 +5074,15 @@ private:
 		return 0;
 		}
 
+		if( conv.shortest && conv.round >= 0 )
+		{
+			// the shortest string is not rounded
+			Conv conv_shortest(conv);
+			conv_shortest.round = -1;
+
+		return ToStringBase<string_type, char_type>(result, conv_shortest, powers);
+		}
+
 		/*
 			since 'base' is greater or equal 2 that 'new_exp' of type 'Int<exp>' should
 			hold the new value of exponent but we're using 'Int<exp+1>' because
@@ -3886,7 +5100,7 @@ private:
 		*/
 		Int<exp+1> new_exp;
 
-		if( ToString_CreateNewMantissaAndExponent<string_type, char_type>(result, conv, new_exp) )
+		if( ToString_CreateNewMantissaAndExponent<string_type, char_type>(result, conv, new_exp, powers) )
 		{
 			Misc::AssignString(result, error_overflow_msg);
 			return 1;
@@ -3917,6 +5131,12 @@ private:
 	friend class Big<exp-1,man>;
 
 
+	/*!
+		BigFormatter (ttmathformatter.h) calls ToStringBase() with its own table of powers
+	*/
+	friend class BigFormatter<exp,man>;
+
+
 	/*!
 		an auxiliary method for converting into the string
 
@@ -3972,121 +5192,192 @@ private:
 		new_exp we calculate in this way:
 			2^exponent <= base^new_exp
 			new_exp >= log base (2^exponent)   <- logarithm with the base 'base' from (2^exponent)
-			
-			but we need new_exp as integer then we test:
-			if new_exp is greater than zero and with fraction we add one to new_exp
-			  new_exp = new_exp + 1    (if new_exp>0 and with fraction)
-			and at the end we take the integer part:
-			  new_exp = int(new_exp)
+			new_exp = ceil( exponent * log base (2) )
+
+			the logarithm is not calculated, we have log base (2) as a fixed-point constant
+			(look at ToString_EstimateExponent()) and new_exp can be one too small then,
+			in such a case the new mantissa would be too big and we try again with new_exp+1
 	*/
 	template<class string_type, class char_type>
 	uint ToString_CreateNewMantissaAndExponent(	string_type & new_man, const Conv & conv,
-												Int<exp+1> & new_exp) const
+												Int<exp+1> & new_exp,
+												const std::vector< UInt<3*man+1> > * powers = 0) const
 	{
 	uint c = 0;
 
 		if( conv.base<2 || conv.base>16 )
 			return 1;
-	
+
+		if( conv.shortest && ToString_CreateNewMantissaShortest<string_type, char_type>(new_man, conv.base, new_exp) == 0 )
+			return 0;
+
 		// special method for base equal 2
 		if( conv.base == 2 )
 			return ToString_CreateNewMantissaAndExponent_Base2(new_man, new_exp);
 
-		// special method for base equal 4
-		if( conv.base == 4 )
-			return ToString_CreateNewMantissaAndExponent_BasePow2(new_man, new_exp, 2);
+		// special method for base equal 4
+		if( conv.base == 4 )
+			return ToString_CreateNewMantissaAndExponent_BasePow2(new_man, new_exp, 2);
+
+		// special method for base equal 8
+		if( conv.base == 8 )
+			return ToString_CreateNewMantissaAndExponent_BasePow2(new_man, new_exp, 3);
+
+		// special method for base equal 16
+		if( conv.base == 16 )
+			return ToString_CreateNewMantissaAndExponent_BasePow2(new_man, new_exp, 4);
+
+
+		ToString_EstimateExponent(conv.base, new_exp);
+
+		if( ToString_CreateNewMantissaTryExponent<string_type, char_type>(new_man, conv, new_exp, powers) )
+		{
+			// the estimated new_exp was too small
+			c += new_exp.AddOne();
+			c += ToString_CreateNewMantissaTryExponent<string_type, char_type>(new_man, conv, new_exp, powers);
+		}
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		an auxiliary method for converting into the string
+
+		it calculates new_exp = ceil( exponent * log base (2) ) without the logarithm:
+		log base (2) is taken as a fixed-point constant with two words (rounded down,
+		rounded up for a negative exponent) and multiplied by the exponent,
+		the result is never too big and at most one too small if the exponent has
+		not more than 2*TTMATH_BITS_PER_UINT-2 bits (for a bigger exponent
+		ToString_EstimateExponentLn() is used)
+
+		base is from <2,16> (the powers of two are used only by the shortest conversion,
+		ToString_CreateNewMantissaShortest())
+	*/
+	void ToString_EstimateExponent(uint base, Int<exp+1> & new_exp) const
+	{
+		// log base (2) * 2^128
+		static const unsigned int log_tab[15][4] = {
+			{ 0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff }, // 2
+			{ 0xa1849cc1, 0xa9a9e94e, 0x043eaf77, 0x91f52142 }, // 3
+			{ 0x80000000, 0x00000000, 0x00000000, 0x00000000 }, // 4
+			{ 0x6e40d1a4, 0x143dcb94, 0x33d52236, 0x8f0d1d89 }, // 5
+			{ 0x6308c91b, 0x702a7cf4, 0xff85a5c1, 0xb80aaa91 }, // 6
+			{ 0x5b3064eb, 0x3aa6d388, 0x9bd82cc1, 0x1a7209d2 }, // 7
+			{ 0x55555555, 0x55555555, 0x55555555, 0x55555555 }, // 8
+			{ 0x50c24e60, 0xd4d4f4a7, 0x021f57bb, 0xc8fa90a1 }, // 9
+			{ 0x4d104d42, 0x7de7fbcc, 0x47c4acd6, 0x05be48bc }, // 10
+			{ 0x4a002707, 0x75914e88, 0x70b46692, 0x0e51e1f7 }, // 11
+			{ 0x4768ce0d, 0x05818e12, 0x7f122e2f, 0x4c79f9ca }, // 12
+			{ 0x452e53e3, 0x65907bda, 0x2bf75000, 0xcfb72251 }, // 13
+			{ 0x433cfffb, 0x4b5aae55, 0xc2d2e895, 0x86d2b763 }, // 14
+			{ 0x41867711, 0xb4f85355, 0x37bbdca4, 0xfca609de }, // 15
+			{ 0x40000000, 0x00000000, 0x00000000, 0x00000000 }  // 16
+		};
+
+		TTMATH_ASSERT( base>=2 && base<=16 )
+
+		const unsigned int * log = log_tab[base-2];
+		UInt<exp+3> product, log_value;
+		Int<exp+3> abs_exponent(exponent);
+		bool is_sign = abs_exponent.IsSign();
+		uint table_id, index;
+
+		abs_exponent.Abs();
+
+		if( abs_exponent.FindLeadingBit(table_id, index) &&
+			table_id*TTMATH_BITS_PER_UINT + index + 1 > 2*TTMATH_BITS_PER_UINT - 2 )
+		{
+			ToString_EstimateExponentLn(base, new_exp);
+			return;
+		}
+
+		log_value.SetZero();
+
+	#ifdef TTMATH_PLATFORM32
+		log_value.table[0] = log[1];
+		log_value.table[1] = log[0];
+	#else
+		log_value.table[0] = (uint(log[2]) << 32) | log[3];
+		log_value.table[1] = (uint(log[0]) << 32) | log[1];
+	#endif
+
+		if( is_sign )
+			log_value.AddOne(); // rounded up
 
-		// special method for base equal 8
-		if( conv.base == 8 )
-			return ToString_CreateNewMantissaAndExponent_BasePow2(new_man, new_exp, 3);
+		// the product has at most exp+2 words
+		product = abs_exponent;
+		product.Mul(log_value);
 
-		// special method for base equal 16
-		if( conv.base == 16 )
-			return ToString_CreateNewMantissaAndExponent_BasePow2(new_man, new_exp, 4);
+		bool fraction = (product.table[0] != 0 || product.table[1] != 0);
+		product.Rcr(2 * TTMATH_BITS_PER_UINT);
+		new_exp = product; // the integer part has at most exp words
+
+		if( is_sign )
+			new_exp.ChangeSign();  // -floor(x) = ceil(-x)
+		else
+		if( fraction )
+			new_exp.AddOne();
+	}
 
 
-		// this = mantissa * 2^exponent
+	/*!
+		an auxiliary method for converting into the string
+
+		it calculates new_exp = ceil( exponent * ln(2) / ln(base) ) on floating point values,
+		it's used only for very big (or very small) exponents which don't fit
+		in the precision of the constants from ToString_EstimateExponent()
+	*/
+	void ToString_EstimateExponentLn(uint base, Int<exp+1> & new_exp) const
+	{
+	Big<exp+1,man> new_exp_, ln_base(base), ln2;
 
-		// temp = +1 * 2^exponent  
-		// we're using a bigger type than 'big<exp,man>' (look below)
-		Big<exp+1,man> temp;
-		temp.info = 0;
-		temp.exponent = exponent;
-		temp.mantissa.SetOne();
-		c += temp.Standardizing();
+		new_exp_.FromInt(exponent);
+		ln2.SetLn2();
+		ln_base.Ln(ln_base);
 
-		// new_exp_ = log base (2^exponent)   
-		// if new_exp_ is positive and with fraction then we add one 
-		Big<exp+1,man> new_exp_;
-		c += new_exp_.ToString_Log(temp, conv.base); // this logarithm isn't very complicated
+		new_exp_.Mul(ln2);
+		new_exp_.Div(ln_base);
 
 		// rounding up to the nearest integer
 		if( !new_exp_.IsInteger() )
 		{
 			if( !new_exp_.IsSign() )
-				c += new_exp_.AddOne(); // new_exp_ > 0 and with fraction
+				new_exp_.AddOne(); // new_exp_ > 0 and with fraction
 
 			new_exp_.SkipFraction();
 		}
 
-		if( ToString_CreateNewMantissaTryExponent<string_type, char_type>(new_man, conv, new_exp_, new_exp) )
-		{
-			// in very rare cases there can be an overflow from ToString_CreateNewMantissaTryExponent
-			// it means that new_exp_ was too small (the problem comes from floating point numbers precision)
-			// so we increse new_exp_ and try again
-			new_exp_.AddOne();
-			c += ToString_CreateNewMantissaTryExponent<string_type, char_type>(new_man, conv, new_exp_, new_exp);
-		}
-
-	return (c==0)? 0 : 1;
+		// |new_exp_| <= |exponent| so it fits in Int<exp+1>
+		new_exp_.ToInt(new_exp);
 	}
 
 
-
 	/*!
 		an auxiliary method for converting into the string
 
-		trying to calculate new_man for given exponent (new_exp_)
-		if there is a carry it can mean that new_exp_ is too small
+		trying to calculate new_man for given exponent (new_exp)
+		if there is a carry it can mean that new_exp is too small
 	*/
 	template<class string_type, class char_type>
 	uint ToString_CreateNewMantissaTryExponent(	string_type & new_man, const Conv & conv,
-												const Big<exp+1,man> & new_exp_, Int<exp+1> & new_exp) const
+												Int<exp+1> & new_exp,
+												const std::vector< UInt<3*man+1> > * powers) const
 	{
 	uint c = 0;
+	UInt<man> new_man_value;
+
+		// new_man_value = mantissa * 2^exponent / base^new_exp
+		// (calculated on integers if the value is not too big or too small)
+		c = ToString_NewMantissaExact(conv.base, new_exp, new_man_value, powers);
+
+		if( c == 2 )
+			c = ToString_NewMantissaBig(conv.base, new_exp, new_man_value);
+
+		if( c )
+			return 1;
 
-		// because 'base^new_exp' is >= '2^exponent' then 
-		// because base is >= 2 then we've got:
-		// 'new_exp_' must be smaller or equal 'new_exp'
-		// and we can pass it into the Int<exp> type
-		// (in fact we're using a greater type then it'll be ok)
-		c += new_exp_.ToInt(new_exp);
-
-		// base_ = base
-		Big<exp+1,man> base_(conv.base);
-
-		// base_ = base_ ^ new_exp_
-		c += base_.Pow( new_exp_ ); // use new_exp_ so Pow(Big<> &) version will be used
-		// if we hadn't used a bigger type than 'Big<exp,man>' then the result
-		// of this formula 'Pow(...)' would have been with an overflow
-
-		// temp = mantissa * 2^exponent / base_^new_exp_
-		Big<exp+1,man> temp;
-		temp.info = 0;
-		temp.mantissa = mantissa;
-		temp.exponent = exponent;
-		c += temp.Div(base_);
-
-		// moving all bits of the mantissa into the right 
-		// (how many times to move depend on the exponent)
-		c += temp.ToString_MoveMantissaIntoRight();
-
-		// because we took 'new_exp' as small as it was
-		// possible ([log base (2^exponent)] + 1) that after the division 
-		// (temp.Div( base_ )) the value of exponent should be equal zero or 
-		// minimum smaller than zero then we've got the mantissa which has 
-		// maximum valid bits
-		temp.mantissa.ToString(new_man, conv.base);
+		ToString_MantissaDigits(new_man_value, new_man, conv.base);
 
 		if( IsInteger() )
 		{
@@ -4104,169 +5395,466 @@ private:
 
 
 	/*!
-		this method calculates the logarithm
-		it is used by ToString_CreateNewMantissaAndExponent() method
+		an auxiliary method for converting into the string
+
+		it calculates new_man_value = mantissa * 2^exponent / base^new_exp exactly on integers
+		(truncated) when the exponent is from <-2*man*TTMATH_BITS_PER_UINT, 2*man*TTMATH_BITS_PER_UINT>
 
-		it's not too complicated
-		because x=+1*2^exponent (mantissa is one) then during the calculation
-		the Ln(x) will not be making the long formula from LnSurrounding1()
-		and only we have to calculate 'Ln(base)' but it'll be calculated
-		only once, the next time we will get it from the 'history'
+		powers (if given) is a table of base^0, base^1, base^2... (look at BigFormatter),
+		if base^|new_exp| is not there it's calculated by PowerOfBase()
 
-        x is greater than 0
-		base is in <2,16> range
+		return values:
+			0 - ok
+			1 - the new mantissa is too big (new_exp is too small)
+			2 - the exponent is too big or too small for this method
 	*/
-	uint ToString_Log(const Big<exp,man> & x, uint base)
+	uint ToString_NewMantissaExact(	uint base, const Int<exp+1> & new_exp, UInt<man> & new_man_value,
+									const std::vector< UInt<3*man+1> > * powers) const
 	{
-		TTMATH_REFERENCE_ASSERT( x )
-		TTMATH_ASSERT( base>=2 && base<=16 )
+	UInt<3*man+1> value, power_temp;
+	const UInt<3*man+1> * power = &power_temp;
+	const sint max_exponent = sint(2 * man * TTMATH_BITS_PER_UINT);
+	sint e, k;
+	uint i, abs_k;
+
+		if( exponent > max_exponent || exponent < -max_exponent )
+			return 2;
+
+		// |new_exp| <= |exponent|
+		e = exponent.ToInt();
+		k = new_exp.ToInt();
+
+		abs_k = uint((k < 0) ? -k : k);
+
+		// base^|k| < base * 2^|e|
+		if( powers && abs_k < powers->size() )
+			power = &(*powers)[abs_k];
+		else
+		if( PowerOfBase(power_temp, base, abs_k) )
+			return 2;
+
+		value = mantissa;
+
+		if( k <= 0 && value.Mul(*power) )
+			return 2;
+
+		if( e >= 0 )
+			value.Rcl(uint(e));
+		else
+			value.Rcr(uint(-e)); // floor(floor(x / 2^-e) / power) = floor(x / (2^-e * power))
+
+		if( k > 0 )
+			value.Div(*power);
+
+		for(i=man ; i<3*man+1 ; ++i)
+			if( value.table[i] != 0 )
+				return 1;
+
+		for(i=0 ; i<man ; ++i)
+			new_man_value.table[i] = value.table[i];
+
+	return 0;
+	}
+
+
+	/*!
+		an auxiliary method for converting into the string
+
+		it calculates new_man_value = mantissa * 2^exponent / base^new_exp on floating point
+		values (when the exponent is too big for ToString_NewMantissaExact()),
+		we're using a bigger type than Big<exp,man> because base^new_exp can be too big,
+		when new_exp is negative we multiply by base^-new_exp instead of dividing
+
+		base^|new_exp| is calculated by squarings and each squaring doubles the relative
+		error so about log2(|new_exp|) bits are lost, the mantissa has exp+1 more words
+		for them (similarly as in ExpReduce())
+
+		it returns 1 if new_exp is too small
+	*/
+	uint ToString_NewMantissaBig(uint base, const Int<exp+1> & new_exp, UInt<man> & new_man_value) const
+	{
+	uint c = 0;
+	Big<exp+1, man+exp+1> power(base), temp;
+	Int<exp+1> abs_new_exp(new_exp);
+
+		abs_new_exp.Abs();
+		c += power.Pow( UInt<exp+1>(abs_new_exp) );
+
+		temp.SetZero();
+		c += temp.FromBig(*this);
+		temp.Abs();
+
+		if( new_exp.IsSign() )
+			c += temp.Mul(power);
+		else
+			c += temp.Div(power);
+
+		// the integer part (the fraction is cut off)
+		c += temp.ToUInt(new_man_value);
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		an auxiliary method for converting into the string (when conv.shortest is true)
+
+		it looks for the shortest new_man * base^new_exp which FromString() reads back
+		exactly to this value
+
+		all values between the midpoints to the previous and to the next value are
+		rounded to this value by FromString() (the midpoints too if the mantissa is even
+		because FromString() rounds half to even), the midpoint to the previous value
+		is closer when the mantissa is a power of two (the previous value has a smaller
+		exponent), so we're looking for the greatest new_exp for which a multiple of
+		base^new_exp is in that interval and then we take the multiple nearest to this value
 
-		Big<exp,man> temp;
-		temp.SetOne();
+		everything is calculated exactly on integers so this is made only when
+		the exponent is from <-2*man*TTMATH_BITS_PER_UINT, 2*man*TTMATH_BITS_PER_UINT>
+		(FromString() calculates exactly only there too), otherwise the digits
+		are found by ToString_CreateNewMantissaShortestBig(), for a base which is
+		a power of two all digits of the mantissa are exact and they are printed
+		by the other methods (this method returns 1 then)
+	*/
+	template<class string_type, class char_type>
+	uint ToString_CreateNewMantissaShortest(string_type & new_man, uint base, Int<exp+1> & new_exp) const
+	{
+	const sint max_exponent = sint(2 * man * TTMATH_BITS_PER_UINT);
+	UInt<3*man+2> x, low, high, d_low, d_high, q, r, divisor;
+	UInt<man+1> d;
+	Int<exp+1> estimated_exp;
+	sint e, k;
+	uint i, c = 0;
+	bool inclusive = (mantissa.table[0] & 1) == 0;
+	bool power_of_two = (mantissa.table[man-1] == TTMATH_UINT_HIGHEST_BIT);
 
-		if( x == temp )
+		if( exponent > max_exponent || exponent < -max_exponent )
 		{
-			// log(1) is 0
-			SetZero();
+			if( base == 2 || base == 4 || base == 8 || base == 16 )
+				return 1;
 
-		return 0;
+			return ToString_CreateNewMantissaShortestBig<string_type, char_type>(new_man, base, new_exp);
 		}
 
-		// there can be only a carry
-		// because the 'x' is in '1+2*exponent' form then 
-		// the long formula from LnSurrounding1() will not be calculated
-		// (LnSurrounding1() will return one immediately)
-		uint c = Ln(x);
+		for(i=0 ; i<man-1 ; ++i)
+			if( mantissa.table[i] != 0 )
+				power_of_two = false;
+
+		// this = x * 2^e and the midpoints are low * 2^e and high * 2^e
+		e = exponent.ToInt() - 2;
+		x = mantissa;
+		x.Rcl(2);
+		high = x;
+		high.AddInt(2);
+		low = x;
+		low.SubInt(power_of_two ? 1 : 2);
+
+		// base^k is smaller than the interval (high-low) * 2^e >= 2^exponent * 3/4
+		// so there is a multiple of base^k between low * 2^e and high * 2^e
+		ToString_EstimateExponent(base, estimated_exp);
+		k = estimated_exp.ToInt() - 2;
+
+		// d_low and d_high are the smallest and the greatest multiple of base^k (in units of base^k)
+		c += ToString_ShortestDivide(low, e, base, k, d_low, r, divisor);
 
-		if( base==10 && man<=TTMATH_BUILTIN_VARIABLES_SIZE )
+		if( !r.IsZero() || !inclusive )
+			d_low.AddOne();
+
+		c += ToString_ShortestDivide(high, e, base, k, d_high, r, divisor);
+
+		if( r.IsZero() && !inclusive )
+			d_high.SubOne();
+
+		// increasing k as long as there is a multiple of base^(k+1)
+		while( c == 0 )
 		{
-			// for the base equal 10 we're using SetLn10() instead of calculating it
-			// (only if we have the constant sufficient big)
-			temp.SetLn10();
+			uint rest;
+
+			q = d_low;
+			q.DivInt(base, rest);
+
+			if( rest != 0 )
+				q.AddOne();
+
+			r = d_high;
+			r.DivInt(base);
+
+			if( q > r )
+				break;
+
+			d_low  = q;
+			d_high = r;
+			++k;
 		}
+
+		// the multiple of base^k nearest to this value (the even one if there are two)
+		c += ToString_ShortestDivide(x, e, base, k, q, r, divisor);
+		r.Rcl(1);
+
+		if( r > divisor || (r == divisor && (q.table[0] & 1) != 0) )
+			q.AddOne();
+
+		if( q < d_low )
+			q = d_low;
 		else
-		{
-			c += ToString_LogBase(base, temp);
-		}
+		if( q > d_high )
+			q = d_high;
 
-		c += Div( temp );
+		if( c != 0 )
+			return 1;
 
-	return (c==0)? 0 : 1;
-	}
+		// q is smaller than base^3 * 2^(man*TTMATH_BITS_PER_UINT)
+		for(i=0 ; i<man+1 ; ++i)
+			d.table[i] = q.table[i];
 
+		ToString_MantissaDigits(d, new_man, base);
+		new_exp = k;
+
+	return 0;
+	}
 
-#ifndef TTMATH_MULTITHREADS
 
 	/*!
-		this method calculates the logarithm of 'base'
-		it's used in single thread environment
+		an auxiliary method for the shortest conversion
+
+		it calculates value * 2^e / base^k = quotient + remainder / divisor
+		(it returns a carry if base^|k| or value * base^-k is too big, the shifts
+		don't overflow with the values from ToString_CreateNewMantissaShortest())
 	*/
-	uint ToString_LogBase(uint base, Big<exp,man> & result)
+	template<uint value_size>
+	static uint ToString_ShortestDivide(const UInt<value_size> & value, sint e, uint base, sint k,
+										UInt<value_size> & quotient, UInt<value_size> & remainder,
+										UInt<value_size> & divisor)
 	{
-		TTMATH_ASSERT( base>=2 && base<=16 )
+	UInt<value_size> power;
+	uint c = 0;
 
-		// this guardians are initialized before the program runs (static POD types)
-		static int guardians[15] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-		static Big<exp,man> log_history[15];
-		uint index = base - 2;
-		uint c = 0;
-	
-		if( guardians[index] == 0 )
+		quotient = value;
+		divisor.SetOne();
+
+		if( k >= 0 )
 		{
-			Big<exp,man> base_(base);
-			c += log_history[index].Ln(base_);
-			guardians[index] = 1;
+			c += PowerOfBase(divisor, base, uint(k));
 		}
+		else
+		{
+			c += PowerOfBase(power, base, uint(-k));
+			c += quotient.Mul(power);
+		}
+
+		if( e >= 0 )
+			quotient.Rcl(uint(e));
+		else
+			divisor.Rcl(uint(-e));
 
-		result = log_history[index];
+		if( c == 0 )
+			quotient.Div(divisor, remainder);
 
 	return (c==0)? 0 : 1;
 	}
 
-#else
 
 	/*!
-		this method calculates the logarithm of 'base'
-		it's used in multi-thread environment
+		an auxiliary method for converting into the string (when conv.shortest is true)
+
+		the shortest string for a value with a big exponent (out of the range of
+		ToString_CreateNewMantissaShortest()), FromString() doesn't calculate exactly
+		there so each candidate is checked by reading it back (ToString_ShortestReadBack()):
+
+		y = 2 * this / base^k is calculated on Big<exp+1, man+exp+1> where k is three digits
+		below the last digit of the mantissa, then the integer part of y/2 is rounded
+		to n digits (half to even, the fraction of y is used too) and the smallest n
+		for which the digits are read back to this value is searched by bisection
+		(more digits are closer to this value so they are read back too)
+
+		it returns 1 if the value is not read back even with all digits of y
+		(all digits are printed by the other methods then)
 	*/
-	uint ToString_LogBase(uint base, Big<exp,man> & result)
+	template<class string_type, class char_type>
+	uint ToString_CreateNewMantissaShortestBig(string_type & new_man, uint base, Int<exp+1> & new_exp) const
 	{
-		TTMATH_ASSERT( base>=2 && base<=16 )
+	Big<exp+1, man+exp+1> y, power(base);
+	Int<exp+1> k, abs_k, candidate_exp, best_exp;
+	UInt<man+1> y_int, temp, candidate, best;
+	uint digits, bk, kk, low, high, mid, c = 0;
+	bool rest, found = false;
 
-		// this guardians are initialized before the program runs (static POD types)
-		volatile static sig_atomic_t guardians[15] = {0,0,0,0,0,0,0,0,0,0,0,0,0,0,0};
-		static Big<exp,man> * plog_history;
-		uint index = base - 2;
-		uint c = 0;
-	
-		// double-checked locking
-		if( guardians[index] == 0 )
+		ToString_EstimateExponent(base, k);
+		c += k.Sub(3);
+
+		abs_k = k;
+		abs_k.Abs();
+		c += power.Pow( UInt<exp+1>(abs_k) );
+
+		c += y.FromBig(*this);
+		y.Abs();
+
+		if( k.IsSign() )
+			c += y.Mul(power);
+		else
+			c += y.Div(power);
+
+		// y/2 is smaller than 2^(man*TTMATH_BITS_PER_UINT) * base^4 (k can be one too small)
+		c += y.exponent.AddOne();
+		rest = !y.IsInteger();
+		c += y.ToUInt(y_int);
+
+		if( c != 0 )
+			return 1;
+
+		// the number of digits of y/2
+		for(bk=base, kk=1 ; bk <= TTMATH_UINT_MAX_VALUE / base ; bk*=base, ++kk);
+
+		temp = y_int;
+		temp.Rcr(1);
+
+		for(digits=0 ; temp >= bk ; digits += kk)
+			temp.DivInt(bk);
+
+		for( ; !temp.IsZero() ; ++digits)
+			temp.DivInt(base);
+
+		low  = 1;
+		high = digits;
+
+		while( low <= high )
 		{
-			ThreadLock thread_lock;
+			mid = low + (high - low) / 2;
 
-			// locking
-			if( thread_lock.Lock() )
+			if( ToString_ShortestRound(y_int, rest, base, digits - mid, candidate) == 0 )
 			{
-				static Big<exp,man> log_history[15];
+				candidate_exp = k;
+				c = candidate_exp.Add(Int<exp+1>(sint(digits - mid)));
 
-				if( guardians[index] == 0 )
+				if( c == 0 && ToString_ShortestReadBack(candidate, candidate_exp, base) )
 				{
-					plog_history = log_history;
-				
-					Big<exp,man> base_(base);
-					c += log_history[index].Ln(base_);
-					guardians[index] = 1;
+					best     = candidate;
+					best_exp = candidate_exp;
+					found    = true;
+
+					if( mid == 1 )
+						break;
+
+					high = mid - 1;
+					continue;
 				}
 			}
-			else
-			{
-				// there was a problem with locking, we store the result directly in 'result' object
-				Big<exp,man> base_(base);
-				c += result.Ln(base_);
-				
-			return (c==0)? 0 : 1;
-			}
 
-			// automatically unlocking
+			low = mid + 1;
 		}
 
-		result = plog_history[index];
+		if( !found )
+			return 1;
+
+		ToString_MantissaDigits(best, new_man, base);
+		new_exp = best_exp;
 
-	return (c==0)? 0 : 1;
+	return 0;
 	}
 
-#endif
 
 	/*!
-		an auxiliary method for converting into the string (private)
+		an auxiliary method for ToString_CreateNewMantissaShortestBig()
 
-		this method moving all bits from mantissa into the right side
-		the exponent tell us how many times moving (the exponent is <=0)
+		result = (y/2) / base^skip rounded half to even where y is 2 * the value
+		and 'rest' is true if the value had a fraction which is not in y
 	*/
-	uint ToString_MoveMantissaIntoRight()
+	static uint ToString_ShortestRound(const UInt<man+1> & y, bool rest, uint base, uint skip,
+										UInt<man+1> & result)
 	{
-		if( exponent.IsZero() )
-			return 0;
-		
-		// exponent can't be greater than zero
-		// because we would cat the highest bits of the mantissa
-		if( !exponent.IsSign() )
+	UInt<man+1> divisor, remainder;
+	uint c = 0;
+
+		// divisor = 2 * base^skip, the remainder is compared with the half of it
+		c += PowerOfBase(divisor, base, skip);
+		c += divisor.Rcl(1);
+
+		if( c != 0 )
 			return 1;
 
+		result = y;
+		result.Div(divisor, remainder);
+		divisor.Rcr(1);
 
-		if( exponent <= -sint(man*TTMATH_BITS_PER_UINT) )
+		if( remainder > divisor || (remainder == divisor && (rest || (result.table[0] & 1) != 0)) )
+			c += result.AddOne();
+
+	return c;
+	}
+
+
+	/*!
+		an auxiliary method for ToString_CreateNewMantissaShortestBig()
+
+		it checks whether FromString() reads digits * base^k back to this value,
+		the value is calculated in the same way as FromString() does it for the string
+		from ToString(): d.ddd (digits) and the scientific exponent x = k + number_of_digits - 1,
+		FromString() puts the exponent into the scale if it's not too big, otherwise
+		it calls FromString_SetScaledScientific() which uses the whole k as the scale
+		(the scientific exponent is read only when the base is 10, a string in other bases
+		is read back only if its scale fits in sint)
+	*/
+	bool ToString_ShortestReadBack(const UInt<man+1> & digits, const Int<exp+1> & k, uint base) const
+	{
+	Big<exp, man> result, value(*this);
+	Int<exp+1> x;
+	UInt<man+1> rest(digits);
+	uint number_of_digits, c = 0;
+	sint scale;
+
+		for(number_of_digits=0 ; !rest.IsZero() ; ++number_of_digits)
+			rest.DivInt(base);
+
+		x = k;
+		c += x.Add(Int<exp+1>(sint(number_of_digits) - 1));
+		result.SetZero();
+
+		if( base != 10 )
 		{
-			// if 'exponent' is <= than '-sint(man*TTMATH_BITS_PER_UINT)'
-			// it means that we must cut the whole mantissa
-			// (there'll not be any of the valid bits)
-			return 1;
+			if( k.ToInt(scale) != 0 )
+				return false;
+
+			c += result.FromString_SetScaled(digits, scale, base, false);
+		}
+		else
+		if( x.ToInt(scale) == 0 && scale < sint(TTMATH_UINT_HIGHEST_BIT >> 2) && scale > -sint(TTMATH_UINT_HIGHEST_BIT >> 2) )
+		{
+			c += result.FromString_SetScaled(digits, scale - sint(number_of_digits - 1), base, false);
+		}
+		else
+		{
+			c += result.FromString_SetScaledScientific(digits, -sint(number_of_digits - 1), x, false);
 		}
 
-		// e will be from (-man*TTMATH_BITS_PER_UINT, 0>
-		sint e = -( exponent.ToInt() );
-		mantissa.Rcr(e,0);
+		if( c != 0 || result.IsNan() )
+			return false;
 
-	return 0;
+		// the sign is not taken into account
+		value.Abs();
+
+	return result == value;
+	}
+
+
+	/*!
+		an auxiliary method for converting into the string
+		it converts the new mantissa into digits
+	*/
+	template<uint value_size, class string_type>
+	static void ToString_MantissaDigits(const UInt<value_size> & new_man_value, string_type & new_man, uint base)
+	{
+		new_man_value.ToStringBase(new_man, base);
+	}
+
+
+	/*!
+		an auxiliary method for converting into the string
+		it converts the new mantissa into digits (without allocating memory)
+	*/
+	template<uint value_size, class char_type>
+	static void ToString_MantissaDigits(const UInt<value_size> & new_man_value, BufferString<char_type> & new_man, uint base)
+	{
+		new_man_value.ToStringBase(new_man, base, false, false);
 	}
 
 
@@ -4699,10 +6287,10 @@ private:
 			// we're adding zero characters before the mantissa
 
 			uint how_many = e - new_man_len;
-			string_type man_temp(how_many+1, '0');
 
-			man_temp.insert( man_temp.begin()+1, static_cast<char_type>(conv.comma));
-			new_man.insert(0, man_temp);
+			// "0," and 'how_many' zeroes
+			new_man.insert(0, how_many+2, '0');
+			new_man[1] = static_cast<char_type>(conv.comma);
 		}
 
 		ToString_CorrectDigitsAfterComma<string_type, char_type>(new_man, conv);
@@ -4742,10 +6330,11 @@ private:
 			Misc::AddString(new_man, "*10^");
 		}
 
-		string_type temp_exp;
-		scientific_exp.ToString( temp_exp, conv.base );
+		// the exponent is converted in a local buffer (the sign and the digits in base 2 at the most)
+		char temp_exp[(exp+1) * TTMATH_BITS_PER_UINT + 1];
+		ToCharsResult res = scientific_exp.ToChars( temp_exp, temp_exp + sizeof(temp_exp), conv.base );
 
-		new_man += temp_exp;
+		new_man.append( temp_exp, res.ptr );
 	}
 
 
@@ -5005,24 +6594,95 @@ public:
 	}
 
 
-	/*!
-		a method for converting a string into its value		
-	*/
-	uint FromString(const std::wstring & string, uint base = 10, const wchar_t ** after_source = 0, bool * value_read = 0)
-	{
-		return FromString(string.c_str(), base, after_source, value_read);
+	/*!
+		a method for converting a string into its value		
+	*/
+	uint FromString(const std::wstring & string, uint base = 10, const wchar_t ** after_source = 0, bool * value_read = 0)
+	{
+		return FromString(string.c_str(), base, after_source, value_read);
+	}
+
+
+	/*!
+		a method for converting a string into its value		
+	*/
+	uint FromString(const std::wstring & string, const Conv & conv, const wchar_t ** after_source = 0, bool * value_read = 0)
+	{
+		return FromString(string.c_str(), conv, after_source, value_read);
+	}
+
+#endif
+
+
+	/*!
+		a method for converting the characters first...last-1 into the value, similar to std::from_chars()
+		struct Conv is defined in ttmathtypes.h, look there for more information about parameters
+
+		the input doesn't have to be ended with a zero, only a minus sign can be given
+		before the digits (white characters and a plus sign are not accepted),
+		the value is not modified if an error is returned
+		(FromCharsResult is defined in ttmathtypes.h)
+	*/
+	FromCharsResult FromChars(const char * first, const char * last, const Conv & conv)
+	{
+	FromCharsResult res;
+	Big<exp, man> temp;
+	const char * source = first;
+	bool is_sign = false, value_read = false;
+	uint c = 0;
+
+		res.ptr = first;
+		res.ec  = err_nothing_has_read;
+
+		if( conv.base<2 || conv.base>16 )
+		{
+			res.ec = err_improper_argument;
+			return res;
+		}
+
+		if( source != last && *source == '-' )
+		{
+			is_sign = true;
+			++source;
+		}
+
+		temp.SetZero();
+
+		// (an empty input is not passed further -- 'last' could be null)
+		if( source != last )
+			c = temp.FromString_ReadValue(source, last, conv, value_read);
+
+		if( !value_read )
+			return res;
+
+		res.ptr = source;
+
+		if( c )
+		{
+			res.ec = err_overflow;
+			return res;
+		}
+
+		if( is_sign && !temp.IsZero() )
+			temp.ChangeSign();
+
+		*this  = temp;
+		res.ec = err_ok;
+
+	return res;
 	}
 
 
 	/*!
-		a method for converting a string into its value		
+		a method for converting the characters first...last-1 into the value, similar to std::from_chars()
 	*/
-	uint FromString(const std::wstring & string, const Conv & conv, const wchar_t ** after_source = 0, bool * value_read = 0)
+	FromCharsResult FromChars(const char * first, const char * last, uint base = 10)
 	{
-		return FromString(string.c_str(), conv, after_source, value_read);
-	}
+		Conv conv;
+		conv.base = base;
 
-#endif
+	return FromChars(first, last, conv);
+	}
 
 
 private:
@@ -5036,6 +6696,7 @@ private:
 	{
 	bool is_sign;
 	bool value_read_temp = false;
+	const char_type * end = 0; // the string is ended with a zero
 
 		if( conv.base<2 || conv.base>16 )
 		{
@@ -5051,15 +6712,9 @@ private:
 		}
 
 		SetZero();
-		FromString_TestSign( source, is_sign );
-
-		uint c = FromString_ReadPartBeforeComma( source, conv, value_read_temp );
-
-		if( FromString_TestCommaOperator(source, conv) )
-			c += FromString_ReadPartAfterComma( source, conv, value_read_temp );
+		FromString_TestSign( source, end, is_sign );
 
-		if( value_read_temp && conv.base == 10 )
-			c += FromString_ReadScientificIfExists( source );
+		uint c = FromString_ReadValue( source, end, conv, value_read_temp );
 
 		if( is_sign && !IsZero() )
 			ChangeSign();
@@ -5074,25 +6729,73 @@ private:
 	}
 
 
+	/*!
+		this method reads the value without the sign (this should be zero)
+
+		the methods which read the value have the 'end' parameter: the input is
+		source...end-1 or, if 'end' is null, the input is ended with a zero
+		(and white characters can be skipped then)
+	*/
+	template<class char_type>
+	uint FromString_ReadValue( const char_type * & source, const char_type * end, const Conv & conv, bool & value_read )
+	{
+	uint c;
+
+		if( (conv.base & (conv.base - 1)) == 0 )
+		{
+			// 2, 4, 8, 16
+			c = FromString_ReadBasePow2( source, end, conv, value_read );
+		}
+		else
+		{
+			// the scientific part (only in base 10) is read there too
+			c = FromString_ReadDigits( source, end, conv, value_read );
+		}
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		this method returns the character from 'source' or zero if 'source' is equal 'end'
+	*/
+	template<class char_type>
+	static char_type FromString_Char(const char_type * source, const char_type * end)
+	{
+		return (source != end) ? *source : 0;
+	}
+
+
+	/*!
+		this method skips white characters (only if the input is ended with a zero -- 'end' is null)
+	*/
+	template<class char_type>
+	static void FromString_SkipWhiteCharacters(const char_type * & source, const char_type * end)
+	{
+		if( !end )
+			Misc::SkipWhiteCharacters(source);
+	}
+
+
 	/*!
 		we're testing whether the value is with the sign
 
 		(this method is used from 'FromString_ReadPartScientific' too)
 	*/
 	template<class char_type>
-	void FromString_TestSign( const char_type * & source, bool & is_sign )
+	void FromString_TestSign( const char_type * & source, const char_type * end, bool & is_sign )
 	{
-		Misc::SkipWhiteCharacters(source);
+		FromString_SkipWhiteCharacters( source, end );
 
 		is_sign = false;
 
-		if( *source == '-' )
+		if( FromString_Char(source, end) == '-' )
 		{
 			is_sign = true;
 			++source;
 		}
 		else
-		if( *source == '+' )
+		if( FromString_Char(source, end) == '+' )
 		{
 			++source;
 		}
@@ -5103,8 +6806,11 @@ private:
 		we're testing whether there's a comma operator
 	*/
 	template<class char_type>
-	bool FromString_TestCommaOperator(const char_type * & source, const Conv & conv)
+	bool FromString_TestCommaOperator(const char_type * & source, const char_type * end, const Conv & conv)
 	{
+		if( source == end )
+			return false;
+
 		if( (*source == static_cast<char_type>(conv.comma)) || 
 			(*source == static_cast<char_type>(conv.comma2) && conv.comma2 != 0 ) )
 		{
@@ -5118,90 +6824,434 @@ private:
 
 
 	/*!
-		this method reads the first part of a string
-		(before the comma operator)
+		this method reads the value (both parts: before and after the comma operator)
+
+		the significant digits are collected in an integer (UInt<man+1>): the digits are
+		taken in chunks of at most k digits (base^k is the greatest power of the base
+		which fits in one word), a chunk is converted into one word (decimal digits from
+		a char string eight at once) and added by one UInt::MulInt() and one UInt::AddInt(),
+		the digits which do not fit in the integer are only counted,
+		at the end this = integer * base^scale is calculated by FromString_SetScaled()
+		(with only one rounding)
+
+		when the base is 10 the scientific part (e.g. "e-20") is read here as well
+		and its exponent is added to the scale so it is not rounded separately
+		(an exponent which doesn't fit in sint is added by FromString_SetScaledScientific())
 	*/
 	template<class char_type>
-	uint FromString_ReadPartBeforeComma( const char_type * & source, const Conv & conv, bool & value_read )
+	uint FromString_ReadDigits( const char_type * & source, const char_type * end, const Conv & conv, bool & value_read )
 	{
-		sint character;
-		Big<exp, man> temp;
-		Big<exp, man> base_( conv.base );
-		
-		Misc::SkipWhiteCharacters( source );
+	uint bk, k, len, power, chunk, digit, i, c = 0;
+	sint scale = 0, scientific_scale;
+	bool comma = false, full = false, rest = false, scientific_read = false;
+	UInt<man+1> integer, next;
+	Int<exp+1> scientific_exponent;
+
+		FromString_SkipWhiteCharacters( source, end );
+		integer.SetZero();
 
-		for( ; true ; ++source )
+		for(bk=conv.base, k=1 ; bk <= TTMATH_UINT_MAX_VALUE / conv.base ; bk*=conv.base, ++k);
+
+		while( true )
 		{
-			if( conv.group!=0 && *source==static_cast<char>(conv.group) )
+			if( conv.group!=0 && FromString_Char(source, end)==static_cast<char>(conv.group) )
+			{
+				++source;
 				continue;
+			}
 
-			character = Misc::CharToDigit(*source, conv.base);
+			for(len=0, power=1 ; len<k && Misc::CharToDigit(FromString_Char(source + len, end), conv.base) != -1 ; ++len)
+				power *= conv.base;
 
-			if( character == -1 )
-				break;
+			if( len == 0 )
+			{
+				if( comma || !FromString_TestCommaOperator(source, end, conv) )
+					break;
+
+				comma = true;
+				continue;
+			}
 
 			value_read = true;
-			temp = character;
 
-			if( Mul(base_) )
-				return 1;
+			if( !full )
+			{
+				if( conv.base == 10 )
+				{
+					chunk = Misc::DecimalDigitsToUInt(source, len);
+				}
+				else
+				{
+					for(chunk=0, i=0 ; i<len ; ++i)
+						chunk = chunk * conv.base + uint(Misc::CharToDigit(source[i], conv.base));
+				}
 
-			if( Add(temp) )
-				return 1;
+				next = integer;
+
+				if( next.MulInt(power) == 0 && next.AddInt(chunk) == 0 )
+				{
+					integer = next;
+					source += len;
+
+					if( comma )
+						scale -= sint(len);
+
+					continue;
+				}
+			}
+
+			// the chunk does not fit in the integer, the digits are taken one by one
+			for(i=0 ; i<len ; ++i, ++source)
+			{
+				digit = uint(Misc::CharToDigit(*source, conv.base));
+
+				if( !full )
+				{
+					next = integer;
+
+					if( next.MulInt(conv.base) == 0 && next.AddInt(digit) == 0 )
+					{
+						integer = next;
+
+						if( comma )
+							--scale;
+
+						continue;
+					}
+
+					full = true;
+				}
+
+				if( digit != 0 )
+					rest = true;
+
+				if( !comma )
+					++scale;
+			}
 		}
 
-	return 0;
+		if( value_read && conv.base == 10 )
+			c += FromString_ReadScientificIfExists( source, end, scientific_exponent, scientific_read );
+
+		if( scientific_read && scientific_exponent.ToInt(scientific_scale) == 0 &&
+			scientific_scale <  sint(TTMATH_UINT_HIGHEST_BIT >> 2) &&
+			scientific_scale > -sint(TTMATH_UINT_HIGHEST_BIT >> 2) )
+		{
+			// the scale is the number of the digits so there is no overflow
+			scale += scientific_scale;
+			scientific_read = false;
+		}
+
+		if( scientific_read )
+			c += FromString_SetScaledScientific(integer, scale, scientific_exponent, rest);
+		else
+			c += FromString_SetScaled(integer, scale, conv.base, rest);
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		this method calculates power = base^k exactly (on integers)
+		it is used when converting from and into a string
+
+		bk = base^kk is the greatest power of the base which fits in one word,
+		power = bk^(k/kk) * base^(k%kk)
+		it returns a carry if base^k is too big for UInt<value_size>
+	*/
+	template<uint value_size>
+	static uint PowerOfBase(UInt<value_size> & power, uint base, uint k)
+	{
+	uint bk, kk, c = 0;
+
+		for(bk=base, kk=1 ; bk <= TTMATH_UINT_MAX_VALUE / base ; bk*=base, ++kk);
+
+		power.SetOne();
+
+		if( k >= kk )
+		{
+			power = bk;
+			c += power.Pow(UInt<value_size>(k / kk));
+		}
+
+		for(bk=1, k %= kk ; k > 0 ; --k)
+			bk *= base;
+
+		if( bk > 1 )
+			c += power.MulInt(bk);
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		this method calculates this = integer * base^scale with one rounding at the end
+
+		when base^|scale| is not too big the calculation is exact (in UInt<3*man+3>):
+		integer * base^|scale| or (integer * 2^s) / base^|scale| where 's' is selected
+		in such a way that the quotient has at least man*TTMATH_BITS_PER_UINT+2 bits
+		(the remainder is used for rounding), otherwise it is calculated
+		on Big<exp, man+1> (one word more than the mantissa)
+
+		'rest' tells whether there were non-zero digits which were not taken into 'integer'
+		(this is zero already)
+	*/
+	uint FromString_SetScaled(const UInt<man+1> & integer, sint scale, uint base, bool rest)
+	{
+	UInt<3*man+3> value, power, remainder;
+	Int<exp> bin_exponent;
+	uint table_id, index, value_bits, power_bits, s, c = 0;
+
+		if( integer.IsZero() )
+			return 0;
+
+		value = integer;
+		bin_exponent.SetZero();
+
+		if( scale == 0 )
+			return FromString_SetRounded(value, bin_exponent, rest);
+
+		// power = base^|scale|
+		c = PowerOfBase(power, base, (scale > 0) ? uint(scale) : uint(-scale));
+
+		if( c == 0 )
+		{
+			if( scale > 0 )
+			{
+				c += value.Mul(power);
+			}
+			else
+			{
+				power.FindLeadingBit(table_id, index);
+				power_bits = table_id * TTMATH_BITS_PER_UINT + index + 1;
+
+				value.FindLeadingBit(table_id, index);
+				value_bits = table_id * TTMATH_BITS_PER_UINT + index + 1;
+
+				// the quotient will have at least man*TTMATH_BITS_PER_UINT+2 bits
+				s = power_bits + man * TTMATH_BITS_PER_UINT + 2;
+
+				if( s > (3*man+3) * TTMATH_BITS_PER_UINT )
+				{
+					c = 1;
+				}
+				else
+				{
+					s = (s > value_bits) ? s - value_bits : 0;
+					value.Rcl(s);
+					value.Div(power, remainder);
+
+					if( !remainder.IsZero() )
+						rest = true;
+
+					bin_exponent = -sint(s);
+				}
+			}
+		}
+
+		if( c == 0 )
+			return FromString_SetRounded(value, bin_exponent, rest);
+
+	// base^|scale| is too big for the exact calculation
+	return FromString_SetScaledBig(integer, Int<exp+1>(scale), base, rest);
+	}
+
+
+	/*!
+		this method calculates this = integer * 10^(scale + scientific_exponent)
+		it is used when the scientific exponent doesn't fit in sint
+
+		the exponent is read exactly by FromString_ReadPartScientific_ReadExponent(),
+		Int<exp+1> has one word more than the binary exponent so it can hold
+		every decimal exponent of a value which is neither too big nor too small
+	*/
+	uint FromString_SetScaledScientific(const UInt<man+1> & integer, sint scale, const Int<exp+1> & scientific_exponent, bool rest)
+	{
+	Int<exp+1> big_scale(scientific_exponent);
+
+		if( big_scale.Add(Int<exp+1>(scale)) )
+			return 1;
+
+	return FromString_SetScaledBig(integer, big_scale, 10, rest);
+	}
+
+
+	/*!
+		this method calculates this = integer * base^scale when base^|scale| is too big
+		for the exact calculation in FromString_SetScaled()
+
+		it is calculated on Big<exp+1, man+exp+1> (a greater exponent so base^|scale| doesn't
+		overflow before the multiplication or the division, and exp+1 more words in the mantissa
+		for the bits lost by the squarings in base^|scale|, similarly as in ToString_NewMantissaBig())
+		and rounded to the mantissa only once at the end, the error before the rounding
+		is much less than one ulp of this
+	*/
+	uint FromString_SetScaledBig(const UInt<man+1> & integer, const Int<exp+1> & scale, uint base, bool rest)
+	{
+	Big<exp+1, man+exp+1> big_value, big_power;
+	Int<exp+1> abs_scale(scale);
+	uint c = 0;
+
+		abs_scale.Abs();
+		c += big_value.FromUInt(integer);
+		big_power = base;
+		c += big_power.Pow( UInt<exp+1>(abs_scale) );
+
+		if( scale.IsSign() )
+			c += big_value.Div(big_power);
+		else
+			c += big_value.Mul(big_power);
+
+		if( c != 0 || big_value.IsZero() )
+			return 1;
+
+	return FromString_SetRounded(big_value.mantissa, big_value.exponent, rest);
+	}
+
+
+	/*!
+		this method sets this = value * 2^bin_exponent (value is positive) rounded
+		to the mantissa (half to even), value_size is greater than man
+
+		'rest' tells whether the real value is a little greater than 'value'
+		(bin_exponent can be wider than the exponent, e.g. from Big<exp+1, man+exp+1>)
+	*/
+	template<uint value_size, uint exp_size>
+	uint FromString_SetRounded(UInt<value_size> & value, const Int<exp_size> & bin_exponent, bool rest)
+	{
+	uint i, c = 0;
+
+		sint moved = sint(value.CompensationToLeft());
+		Int<exp_size> new_exponent( sint((value_size - man) * TTMATH_BITS_PER_UINT) - moved );
+
+		for(i=0 ; i<man ; ++i)
+			mantissa.table[i] = value.table[value_size - man + i];
+
+		c += new_exponent.Add(bin_exponent);
+		c += exponent.FromInt(new_exponent);
+		ClearInfoBit(TTMATH_BIG_ZERO);
+
+		if( (value.table[value_size - man - 1] & TTMATH_UINT_HIGHEST_BIT) != 0 )
+		{
+			bool is_half = !rest && CheckGreaterOrEqualHalf(value.table, value_size - man);
+			c += RoundHalfToEven(is_half);
+		}
+
+	return (c==0)? 0 : 1;
 	}
 
 
 	/*!
-		this method reads the second part of a string
-		(after the comma operator)
+		this method reads the value (both parts: before and after the comma operator)
+		when the base is a power of two
+
+		the digits are not multiplied: the bits of the significant digits are put
+		directly into the mantissa (beginning from the highest bit), the exponent
+		is calculated from the number of the bits read and the bits which do not fit
+		in the mantissa are used for rounding (half to even)
 	*/
 	template<class char_type>
-	uint FromString_ReadPartAfterComma( const char_type * & source, const Conv & conv, bool & value_read )
+	uint FromString_ReadBasePow2( const char_type * & source, const char_type * end, const Conv & conv, bool & value_read )
 	{
 	sint character;
-	uint c = 0, power = 0;
-	UInt<1> power_;
-	Big<exp, man> sum, base_(conv.base);
+	uint c = 0, bits = 0, width, lost, index, shift;
+	uint free_bits     = man * TTMATH_BITS_PER_UINT;	// how many bits of the mantissa are still free
+	uint read_bits     = 0;								// the bits of the significant digits
+	uint fraction_bits = 0;								// the bits of the digits after the comma
+	bool comma = false, lost_bits = false, half_bit = false, rest_bits = false;
 
-		// we don't remove any white characters here
-		sum.SetZero();
+		for(uint b = conv.base ; b > 1 ; b >>= 1)
+			++bits;
+
+		FromString_SkipWhiteCharacters( source, end );
 
-		for( ; sum.exponent.IsSign() || sum.exponent.IsZero() ; ++source )
+		while( true )
 		{
-			if( conv.group!=0 && *source==static_cast<char>(conv.group) )
+			if( conv.group!=0 && FromString_Char(source, end)==static_cast<char>(conv.group) )
+			{
+				++source;
 				continue;
-			
-			character = Misc::CharToDigit(*source, conv.base);
+			}
+
+			character = Misc::CharToDigit(FromString_Char(source, end), conv.base);
 
 			if( character == -1 )
-				break;
+			{
+				if( comma || !FromString_TestCommaOperator(source, end, conv) )
+					break;
+
+				comma = true;
+				continue;
+			}
 
+			++source;
 			value_read = true;
 
-			// there actually shouldn't be a carry here
-			c += sum.Mul(base_);
-			c += sum.Add(character);
-			power += 1;
+			if( comma )
+				fraction_bits += bits;
 
-			if( power == 0 )
-				c += 1;
-		}
+			width = bits;
 
-		// we could break the parsing somewhere in the middle of the string,
-		// but the result (value) still can be good
-		// we should set a correct value of 'source' now
-		while( Misc::CharToDigit(*source, conv.base) != -1 )
-		{
-			++source;
+			if( read_bits == 0 )
+			{
+				// leading zeros are skipped and only the significant bits of the first digit are taken
+				if( character == 0 )
+					continue;
+
+				width = uint(UInt<man>::FindLeadingBitInWord(uint(character))) + 1;
+			}
+
+			read_bits += width;
+
+			if( free_bits >= width )
+			{
+				free_bits -= width;
+				index      = free_bits / TTMATH_BITS_PER_UINT;
+				shift      = free_bits % TTMATH_BITS_PER_UINT;
+
+				mantissa.table[index] |= uint(character) << shift;
+
+				// the digit is split between two words, index+1 is always smaller than man
+				// (the digit was taken from free_bits) but the compiler can't see that when man is one
+				if( shift + width > TTMATH_BITS_PER_UINT && index + 1 < man )
+					mantissa.table[index+1] |= uint(character) >> (TTMATH_BITS_PER_UINT - shift);
+			}
+			else
+			{
+				// 'lost' lowest bits of the digit do not fit in the mantissa
+				lost = width - free_bits;
+
+				if( free_bits > 0 )
+					mantissa.table[0] |= uint(character) >> lost;
+
+				free_bits = 0;
+				character &= (sint(1) << lost) - 1;
+
+				if( !lost_bits )
+				{
+					lost_bits = true;
+					half_bit  = (character >> (lost - 1)) != 0;
+					character &= (sint(1) << (lost - 1)) - 1;
+				}
+
+				if( character != 0 )
+					rest_bits = true;
+			}
 		}
 
-		power_ = power;
-		c += base_.Pow(power_);
-		c += sum.Div(base_);
-		c += Add(sum);
+		if( read_bits == 0 )
+			return 0;
+
+		// this = mantissa * 2^(read_bits - man*TTMATH_BITS_PER_UINT - fraction_bits)
+		c += exponent.FromUInt(read_bits);
+		c += exponent.Sub( man * TTMATH_BITS_PER_UINT );
+		c += exponent.Sub( fraction_bits );
+
+		// the highest bit of the mantissa is set now
+		ClearInfoBit(TTMATH_BIG_ZERO);
+
+		if( half_bit )
+			c += RoundHalfToEven( !rest_bits );
 
 	return (c==0)? 0 : 1;
 	}
@@ -5213,15 +7263,15 @@ private:
 		it is called when the base is 10 and some digits were read before
 	*/
 	template<class char_type>
-	uint FromString_ReadScientificIfExists(const char_type * & source)
+	uint FromString_ReadScientificIfExists(	const char_type * & source, const char_type * end,
+											Int<exp+1> & new_exponent, bool & scientific_read )
 	{
 	uint c = 0;
 
-		bool scientific_read = false;
 		const char_type * before_scientific = source;
 
-		if( FromString_TestScientific(source) )
-			c += FromString_ReadPartScientific( source, scientific_read );
+		if( FromString_TestScientific(source, end) )
+			c += FromString_ReadPartScientific( source, end, new_exponent, scientific_read );
 
 		if( !scientific_read )
 			source = before_scientific;
@@ -5237,11 +7287,11 @@ private:
 		this character is only allowed when we're using the base equals 10
 	*/
 	template<class char_type>
-	bool FromString_TestScientific(const char_type * & source)
+	bool FromString_TestScientific(const char_type * & source, const char_type * end)
 	{
-		Misc::SkipWhiteCharacters(source);
+		FromString_SkipWhiteCharacters( source, end );
 
-		if( *source=='e' || *source=='E' )
+		if( FromString_Char(source, end)=='e' || FromString_Char(source, end)=='E' )
 		{
 			++source;
 
@@ -5257,24 +7307,17 @@ private:
 		format of value and only when we're using the base equals 10
 	*/
 	template<class char_type>
-	uint FromString_ReadPartScientific( const char_type * & source, bool & scientific_read )
+	uint FromString_ReadPartScientific(	const char_type * & source, const char_type * end,
+										Int<exp+1> & new_exponent, bool & scientific_read )
 	{
 	uint c = 0;
-	Big<exp, man> new_exponent, temp;
 	bool was_sign = false;
 
-		FromString_TestSign( source, was_sign );
-		c += FromString_ReadPartScientific_ReadExponent( source, new_exponent, scientific_read );
-
-		if( scientific_read )
-		{
-			if( was_sign )
-				new_exponent.ChangeSign();
+		FromString_TestSign( source, end, was_sign );
+		c += FromString_ReadPartScientific_ReadExponent( source, end, new_exponent, scientific_read );
 
-			temp = 10;
-			c += temp.Pow( new_exponent );
-			c += Mul(temp);
-		}
+		if( scientific_read && was_sign )
+			new_exponent.ChangeSign();
 
 	return (c==0)? 0 : 1;
 	}
@@ -5283,32 +7326,32 @@ private:
 	/*!
 		this method reads the value of the extra exponent when scientific format is used
 		(only when base == 10)
+
+		the exponent is read exactly, if it's too big all its digits are skipped
+		and the carry is returned
 	*/
 	template<class char_type>
-	uint FromString_ReadPartScientific_ReadExponent( const char_type * & source, Big<exp, man> & new_exponent, bool & scientific_read )
+	uint FromString_ReadPartScientific_ReadExponent( const char_type * & source, const char_type * end, Int<exp+1> & new_exponent, bool & scientific_read )
 	{
 	sint character;
-	Big<exp, man> base, temp;
+	uint c = 0;
 
-		Misc::SkipWhiteCharacters(source);
+		FromString_SkipWhiteCharacters( source, end );
 
 		new_exponent.SetZero();
-		base = 10;
 
-		for( ; (character=Misc::CharToDigit(*source, 10)) != -1 ; ++source )
+		for( ; (character=Misc::CharToDigit(FromString_Char(source, end), 10)) != -1 ; ++source )
 		{
 			scientific_read = true;
 
-			temp = character;
-
-			if( new_exponent.Mul(base) )
-				return 1;
-
-			if( new_exponent.Add(temp) )
-				return 1;
+			if( c == 0 )
+			{
+				c += new_exponent.MulInt(10);
+				c += new_exponent.Add(Int<exp+1>(character));
+			}
 		}
 
-	return 0;
+	return (c==0)? 0 : 1;
 	}
 
 
@@ -5980,6 +8023,31 @@ private:
 	}
 
 
+	/*!
+		an auxiliary method for outputing to standard streams (char version)
+
+		the value is converted by ToChars() in a buffer on the stack (without allocating
+		memory), very big values and a stream with the width set are output by OutputToStream()
+	*/
+	static std::ostream & OutputToStreamChars(std::ostream & s, const Big<exp,man> & l)
+	{
+		const uint size = man;
+		char buffer[(man < TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE ? man : 1) * TTMATH_BITS_PER_UINT + 64];
+
+		if( size >= TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE || s.width() != 0 )
+			return OutputToStream<std::ostream, std::string>(s, l);
+
+		ToCharsResult res = l.ToChars(buffer, buffer + sizeof(buffer));
+
+		if( res.ec != err_ok )
+			return OutputToStream<std::ostream, std::string>(s, l);
+
+		s.write(buffer, res.ptr - buffer);
+
+	return s;
+	}
+
+
 public:
 
 
@@ -5988,7 +8056,7 @@ public:
 	*/
 	friend std::ostream & operator<<(std::ostream & s,  const Big<exp,man> & l)
 	{
-		return OutputToStream<std::ostream, std::string>(s, l);
+		return OutputToStreamChars(s, l);
 	}
 
 
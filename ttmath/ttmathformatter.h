@@ -0,0 +1,325 @@
+/*
+ * This file is a part of TTMath Bignum Library
+ * and is distributed under the 3-Clause BSD Licence.
+ * Author: Tomasz Sowa <t.sowa@ttmath.org>
+ */
+
+/* 
+ * Copyright (c) 2006-2019, Tomasz Sowa
+ * All rights reserved.
+ * 
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ * 
+ *  * Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *    
+ *  * Redistributions in binary form must reproduce the above copyright
+ *    notice, this list of conditions and the following disclaimer in the
+ *    documentation and/or other materials provided with the distribution.
+ *    
+ *  * Neither the name Tomasz Sowa nor the names of contributors to this
+ *    project may be used to endorse or promote products derived
+ *    from this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ * ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR CONTRIBUTORS BE
+ * LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ * CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ * SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ * INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ * CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ * ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF
+ * THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#ifndef headerfilettmathformatter
+#define headerfilettmathformatter
+
+/*!
+	\file ttmathformatter.h
+    \brief Converting many Big<> values into strings with the same Conv settings
+*/
+
+#include "ttmathbig.h"
+
+#include <string>
+#include <vector>
+
+
+namespace ttmath
+{
+
+
+/*!
+	\brief BigFormatter converts Big<exp,man> values into strings with the same Conv settings
+
+	it gives the same strings as Big::ToString(result, conv) but it keeps a table
+	of powers of the base (base^0, base^1, base^2...) which Big::ToString() has to calculate
+	for each value (the table is filled lazily up to the biggest exponent needed
+	and it is used when the new mantissa is calculated exactly on integers)
+
+	an object of this class is not thread safe (it has its own buffer and the table),
+	use one object per thread
+
+	example:
+		ttmath::Conv conv;
+		conv.round = 10;
+
+		ttmath::BigFormatter<1,2> formatter(conv);
+		std::string result;
+
+		formatter.Format(values, result, ';'); // values is std::vector< ttmath::Big<1,2> >
+*/
+template <uint exp, uint man>
+class BigFormatter
+{
+public:
+
+
+	/*!
+		a formatter with the default Conv settings and the given base
+	*/
+	BigFormatter(uint base = 10)
+	{
+		Conv c;
+		c.base = base;
+
+		SetConv(c);
+	}
+
+
+	/*!
+		a formatter bound to the given Conv settings
+	*/
+	BigFormatter(const Conv & c)
+	{
+		SetConv(c);
+	}
+
+
+	/*!
+		setting new Conv settings
+		(the table of powers is cleared if the base is changed)
+	*/
+	void SetConv(const Conv & c)
+	{
+		bool base_changed = (powers.empty() || c.base != conv.base);
+		conv = c;
+
+		if( base_changed )
+			InitPowers();
+	}
+
+
+	/*!
+		returning the Conv settings
+	*/
+	const Conv & GetConv() const
+	{
+		return conv;
+	}
+
+
+	/*!
+		converting the value into the string
+		(the same as value.ToString(result, conv))
+
+		returning 0 if ok or 1 if there was a carry (result is "overflow" then)
+	*/
+	uint Format(const Big<exp,man> & value, std::string & result)
+	{
+		return FormatBase<std::string, char>(value, result);
+	}
+
+
+	/*!
+		converting all values into one string, the values are separated by 'separator'
+		(the result is not cleared before, new values are added at the end)
+
+		the string is reserved once so there is no reallocation when the values
+		have a similar length
+
+		returning 0 if ok or 1 if at least one value could not be converted
+		("overflow" is put in place of such a value)
+	*/
+	uint Format(const std::vector< Big<exp,man> > & values, std::string & result, char separator = '\n')
+	{
+		return FormatBase<std::string, char>(values, result, separator);
+	}
+
+
+#ifndef TTMATH_DONT_USE_WCHAR
+
+	/*!
+		converting the value into the string
+		(the same as value.ToString(result, conv))
+
+		returning 0 if ok or 1 if there was a carry (result is "overflow" then)
+	*/
+	uint Format(const Big<exp,man> & value, std::wstring & result)
+	{
+		return FormatBase<std::wstring, wchar_t>(value, result);
+	}
+
+
+	/*!
+		converting all values into one string, the values are separated by 'separator'
+		(the result is not cleared before, new values are added at the end)
+
+		returning 0 if ok or 1 if at least one value could not be converted
+	*/
+	uint Format(const std::vector< Big<exp,man> > & values, std::wstring & result, wchar_t separator = '\n')
+	{
+		return FormatBase<std::wstring, wchar_t>(values, result, separator);
+	}
+
+#endif
+
+
+
+private:
+
+	Conv conv;
+
+	/*!
+		powers of conv.base: base^0, base^1, base^2...
+		it's empty if the base is a power of two or is not from <2,16>
+		(such values are converted without the powers)
+	*/
+	std::vector< UInt<3*man+1> > powers;
+
+	/*!
+		true if the next power doesn't fit in the table
+		(the new mantissa is not calculated on integers for such exponents)
+	*/
+	bool powers_full;
+
+	std::string buffer;
+
+#ifndef TTMATH_DONT_USE_WCHAR
+	std::wstring wbuffer;
+#endif
+
+
+	/*!
+		returning the buffer used by the batch conversion
+	*/
+	std::string & Buffer(std::string *)
+	{
+		return buffer;
+	}
+
+
+#ifndef TTMATH_DONT_USE_WCHAR
+
+	/*!
+		returning the buffer used by the batch conversion
+	*/
+	std::wstring & Buffer(std::wstring *)
+	{
+		return wbuffer;
+	}
+
+#endif
+
+
+	/*!
+		clearing the table of powers and putting base^0 there
+	*/
+	void InitPowers()
+	{
+		powers.clear();
+		powers_full = false;
+
+		if( conv.base < 3 || conv.base > 15 || conv.base == 4 || conv.base == 8 )
+			return;
+
+		powers.resize(1);
+		powers[0].SetOne();
+	}
+
+
+	/*!
+		making sure that the table has powers of the base used for the value
+
+		the exponent is estimated in the same way as Big::ToString() does it,
+		and it can be one greater there so we need |new_exp|+1 powers
+	*/
+	void PreparePowers(const Big<exp,man> & value)
+	{
+		const sint max_exponent = sint(2 * man * TTMATH_BITS_PER_UINT);
+
+		if( powers.empty() || powers_full || value.IsNan() || value.IsZero() ||
+			value.exponent > max_exponent || value.exponent < -max_exponent )
+			return;
+
+		Int<exp+1> new_exp;
+		value.ToString_EstimateExponent(conv.base, new_exp);
+
+		sint k     = new_exp.ToInt();
+		uint abs_k = uint((k < 0) ? -k : k) + 1;
+
+		while( powers.size() <= abs_k )
+		{
+			UInt<3*man+1> next(powers.back());
+
+			// Big::ToString_NewMantissaExact() uses powers smaller than 2^(2*man*TTMATH_BITS_PER_UINT + 8)
+			// so a power which has the word 2*man+1 set is not needed
+			if( next.MulInt(conv.base) || next.table[2*man+1] != 0 )
+			{
+				powers_full = true;
+				break;
+			}
+
+			powers.push_back(next);
+		}
+	}
+
+
+	/*!
+		converting one value
+	*/
+	template<class string_type, class char_type>
+	uint FormatBase(const Big<exp,man> & value, string_type & result)
+	{
+		PreparePowers(value);
+
+	return value.template ToStringBase<string_type, char_type>(result, conv, powers.empty() ? 0 : &powers);
+	}
+
+
+	/*!
+		converting all values into one string
+	*/
+	template<class string_type, class char_type>
+	uint FormatBase(const std::vector< Big<exp,man> > & values, string_type & result, char_type separator)
+	{
+	uint c = 0;
+	string_type & buf = Buffer(static_cast<string_type*>(0));
+	typename std::vector< Big<exp,man> >::size_type i;
+
+		for(i=0 ; i<values.size() ; ++i)
+		{
+			if( i > 0 )
+				result += separator;
+
+			c += FormatBase<string_type, char_type>(values[i], buf);
+
+			if( i == 0 )
+				result.reserve(result.size() + values.size() * (buf.size() + 1));
+
+			result += buf;
+		}
+
+	return (c==0)? 0 : 1;
+	}
+
+};
+
+
+} // namespace
+
+#endif
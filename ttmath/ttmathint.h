@@ -632,6 +632,90 @@ public:
 
 
 
+	/*!
+		square root (rounded down)
+
+		return values:
+		-  0 - ok
+		-  2 - incorrect argument (this is negative, 'this' is not changed)
+	*/
+	uint Sqrt()
+	{
+		if( IsSign() )
+			return 2;
+
+		UInt<value_size>::Sqrt();
+
+	return 0;
+	}
+
+
+	/*!
+		the nth root (rounded towards zero)
+		e.g. Root(-30, 3) = -3
+
+		return values:
+		-  0 - ok
+		-  2 - incorrect argument (n is zero or this is negative and n is even,
+		       'this' is not changed)
+	*/
+	uint Root(uint n)
+	{
+		if( !IsSign() )
+			return UInt<value_size>::Root(n);
+
+		if( (n & 1) == 0 )
+			return 2;
+
+		// if ChangeSign() fails the value is the smallest one
+		// and it is correct when treated as UInt
+		ChangeSign();
+		UInt<value_size>::Root(n);
+		ChangeSign();
+
+	return 0;
+	}
+
+
+	/*!
+		this method returns true if the value is a square of an integer
+		(a negative value is not)
+	*/
+	bool IsPerfectSquare() const
+	{
+		if( IsSign() )
+			return false;
+
+	return UInt<value_size>::IsPerfectSquare();
+	}
+
+
+	/*!
+		this method returns true if the value is equal base^degree for some integers
+		base and degree>=2 (a negative value can only have an odd degree, e.g. -8 = (-2)^3)
+
+		'degree' will be the smallest prime number for which this = base^degree
+		(look at UInt::IsPerfectPower())
+	*/
+	bool IsPerfectPower(Int<value_size> * base = 0, uint * degree = 0) const
+	{
+		if( !IsSign() )
+			return UInt<value_size>::IsPerfectPower(base, degree);
+
+		Int<value_size> temp(*this);
+		temp.ChangeSign();
+
+		if( !temp.UInt<value_size>::IsPerfectPower(base, degree, true) )
+			return false;
+
+		if( base )
+			base->ChangeSign();
+
+	return true;
+	}
+
+
+
 	/*!
 	*
 	*	convertion methods
@@ -1372,6 +1456,28 @@ public:
 #endif
 
 
+	/*!
+		this method converts the value to a string with a base equal 'b'
+		and puts it into the buffer first...last-1 (without a terminating zero),
+		similar to std::to_chars()
+
+		no memory is allocated, if the buffer is too small then err_overflow is returned
+		(ToCharsResult is defined in ttmathtypes.h)
+	*/
+	ToCharsResult ToChars(char * first, char * last, uint b = 10) const
+	{
+		if( IsSign() )
+		{
+			Int<value_size> temp(*this);
+			temp.Abs();
+
+		return temp.UInt<value_size>::ToCharsBase(first, last, b, true);
+		}
+
+	return UInt<value_size>::ToCharsBase(first, last, b, false);
+	}
+
+
 
 private:
 
@@ -1475,6 +1581,49 @@ public:
 	}
 
 
+	/*!
+		this method converts the characters first...last-1 into the value, similar to std::from_chars()
+
+		the input doesn't have to be ended with a zero, only a minus sign can be given
+		before the digits (white characters and a plus sign are not accepted),
+		the value is not modified if an error is returned
+		(FromCharsResult is defined in ttmathtypes.h)
+	*/
+	FromCharsResult FromChars(const char * first, const char * last, uint b = 10)
+	{
+	UInt<value_size> temp;
+	Int<value_size> limit;
+	bool is_sign = (first != last && *first == '-');
+
+		FromCharsResult res = UInt<value_size>::FromCharsBase(is_sign ? first + 1 : first, last, b, temp);
+
+		if( res.ec == err_nothing_has_read || res.ec == err_improper_argument )
+			res.ptr = first;
+
+		if( res.ec != err_ok )
+			return res;
+
+		if( is_sign )
+			limit.SetMin();
+		else
+			limit.SetMax();
+
+		// (the absolute value can be equal to min -- ChangeSign() does nothing then)
+		if( temp > limit )
+		{
+			res.ec = err_overflow;
+			return res;
+		}
+
+		UInt<value_size>::operator=(temp);
+
+		if( is_sign )
+			ChangeSign();
+
+	return res;
+	}
+
+
 	/*!
 		this operator converts a string into its value (with base = 10)
 	*/
@@ -1827,6 +1976,31 @@ private:
 	}
 
 
+	/*!
+		an auxiliary method for outputing to standard streams (char version)
+
+		the value is converted by ToChars() in a buffer on the stack (without allocating
+		memory), very big values and a stream with the width set are output by OutputToStream()
+	*/
+	static std::ostream & OutputToStreamChars(std::ostream & s, const Int<value_size> & l)
+	{
+		const uint size = value_size;
+		char buffer[(value_size < TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE ? value_size : 1) * TTMATH_BITS_PER_UINT / 3 + 3];
+
+		if( size >= TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE || s.width() != 0 )
+			return OutputToStream<std::ostream, std::string>(s, l);
+
+		ToCharsResult res = l.ToChars(buffer, buffer + sizeof(buffer));
+
+		if( res.ec != err_ok )
+			return OutputToStream<std::ostream, std::string>(s, l);
+
+		s.write(buffer, res.ptr - buffer);
+
+	return s;
+	}
+
+
 
 public:
 
@@ -1836,7 +2010,7 @@ public:
 	*/
 	friend std::ostream & operator<<(std::ostream & s, const Int<value_size> & l)
 	{
-		return OutputToStream<std::ostream, std::string>(s, l);
+		return OutputToStreamChars(s, l);
 	}
 
 
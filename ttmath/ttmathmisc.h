@@ -46,11 +46,188 @@
 
 
 #include <string>
+#include <cstring>
+#include <cstddef>
 
 
 namespace ttmath
 {
 
+
+/*!
+	a string on a buffer given by the caller (it never allocates memory)
+
+	it has only those methods of std::basic_string which are used by the conversions
+	to a string (UInt::ToStringBase(), Big::ToStringBase()) so that the conversions
+	can write directly into the buffer (ToChars() methods)
+
+	characters which don't fit in the buffer are dropped and the overflow flag is set,
+	the content of the buffer is meaningless then
+*/
+template<class char_type>
+class BufferString
+{
+public:
+
+	typedef std::size_t size_type;
+	typedef char_type * iterator;
+
+	static const size_type npos = static_cast<size_type>(-1);
+
+
+	BufferString(char_type * buffer, size_type buffer_size)
+	{
+		buf      = buffer;
+		cap      = buffer_size;
+		len      = 0;
+		overflow = false;
+	}
+
+
+	/*!
+		returns true if some characters didn't fit in the buffer
+	*/
+	bool Overflow() const
+	{
+		return overflow;
+	}
+
+
+	size_type size() const		{ return len; }
+	size_type length() const	{ return len; }
+	size_type capacity() const	{ return cap; }
+	bool empty() const			{ return len == 0; }
+	iterator begin()			{ return buf; }
+	void reserve(size_type)		{ }
+	void clear()				{ len = 0; }
+	void erase()				{ len = 0; }
+
+
+	char_type & operator[](size_type i)
+	{
+		return buf[i];
+	}
+
+
+	const char_type & operator[](size_type i) const
+	{
+		return buf[i];
+	}
+
+
+	BufferString & operator=(char_type c)
+	{
+		len = 0;
+
+	return operator+=(c);
+	}
+
+
+	BufferString & operator+=(char_type c)
+	{
+		if( len < cap )
+			buf[len++] = c;
+		else
+			overflow = true;
+
+	return *this;
+	}
+
+
+	template<class iterator_type>
+	void append(iterator_type first, iterator_type last)
+	{
+		for( ; first != last && len < cap ; ++first )
+			buf[len++] = static_cast<char_type>(*first);
+
+		if( first != last )
+			overflow = true;
+	}
+
+
+	void insert(size_type pos, size_type n, char_type c)
+	{
+		if( pos > len )
+			pos = len;
+
+		size_type new_len = len + n;
+
+		if( n > cap - len )
+		{
+			// the last characters are dropped
+			overflow = true;
+			new_len = cap;
+		}
+
+		if( n > new_len - pos )
+			n = new_len - pos;
+
+		std::memmove(buf + pos + n, buf + pos, (new_len - pos - n) * sizeof(char_type));
+
+		for(size_type i=0 ; i<n ; ++i)
+			buf[pos + i] = c;
+
+		len = new_len;
+	}
+
+
+	void insert(iterator pos, char_type c)
+	{
+		insert(size_type(pos - buf), 1, c);
+	}
+
+
+	void erase(size_type pos, size_type n)
+	{
+		if( pos >= len )
+			return;
+
+		if( n > len - pos )
+			n = len - pos;
+
+		std::memmove(buf + pos, buf + pos + n, (len - pos - n) * sizeof(char_type));
+		len -= n;
+	}
+
+
+	size_type find(char_type c, size_type pos) const
+	{
+		for( ; pos < len ; ++pos )
+			if( buf[pos] == c )
+				return pos;
+
+	return npos;
+	}
+
+
+	size_type find_last_of(char_type c, size_type pos) const
+	{
+		if( len == 0 )
+			return npos;
+
+		if( pos >= len )
+			pos = len - 1;
+
+		for( ; ; --pos )
+		{
+			if( buf[pos] == c )
+				return pos;
+
+			if( pos == 0 )
+				return npos;
+		}
+	}
+
+
+private:
+
+	char_type * buf;
+	size_type len, cap;
+	bool overflow;
+};
+
+
+
 /*!
 	some helpful functions
 */
@@ -138,6 +315,28 @@ static void AddString(std::string & result, const char * str)
 }
 
 
+/*!
+	result = str
+*/
+template<class char_type>
+static void AssignString(BufferString<char_type> & result, const char * str)
+{
+	result.clear();
+	AddString(result, str);
+}
+
+
+/*!
+	result += str
+*/
+template<class char_type>
+static void AddString(BufferString<char_type> & result, const char * str)
+{
+	for( ; *str ; ++str )
+		result += static_cast<char_type>(*str);
+}
+
+
 #ifndef TTMATH_DONT_USE_WCHAR
 
 /*!
@@ -242,6 +441,75 @@ return digit - 10 + 'A';
 }
 
 
+/*!
+	this method converts 'len' decimal digits into a value
+
+	the digits have to be already checked and the value has to fit in uint
+	(len is not greater than 9 on a 32bit platform and 19 on a 64bit platform)
+*/
+template<class char_type>
+static uint DecimalDigitsToUInt(const char_type * s, uint len)
+{
+uint result = 0;
+
+	for( ; len > 0 ; --len, ++s )
+		result = result * 10 + uint(*s - '0');
+
+return result;
+}
+
+
+/*!
+	this method converts 'len' decimal digits into a value (char version)
+
+	on little endian platforms eight digits are converted at once in a 64 bit word
+	(SWAR - SIMD within a register), the rest of the digits one by one
+*/
+static uint DecimalDigitsToUInt(const char * s, uint len)
+{
+uint result = 0;
+
+#if (defined __BYTE_ORDER__ && __BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__) || defined _M_IX86 || defined _M_X64
+
+	for( ; len >= 8 ; len -= 8, s += 8 )
+		result = result * 100000000 + EightDecimalDigitsToUInt(s);
+
+#endif
+
+	for( ; len > 0 ; --len, ++s )
+		result = result * 10 + uint(*s - '0');
+
+return result;
+}
+
+
+/*!
+	this method converts eight decimal digits s[0]...s[7] into a value
+	(the digits have to be already checked, little endian only)
+
+	the first digit is in the lowest byte of the word, the pairs of digits,
+	then the groups of four and at the end all eight digits are combined
+	by three multiplications
+*/
+static uint EightDecimalDigitsToUInt(const char * s)
+{
+#ifdef TTMATH_PLATFORM32
+	ulint v;
+#else
+	uint v;
+#endif
+
+	std::memcpy(&v, s, 8);
+
+	v -= 0x3030303030303030ull;
+	v  = v * 10 + (v >> 8);
+	v  = ( ((v       & 0x000000ff000000ffull) * 0x000f424000000064ull) +
+		   (((v>>16) & 0x000000ff000000ffull) * 0x0000271000000001ull) ) >> 32;
+
+return uint(v);
+}
+
+
 }; // struct Misc
 
 }
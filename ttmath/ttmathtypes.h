@@ -168,6 +168,36 @@
 #endif
 
 
+/*!
+	on x86_64 platforms (GCC and CLANG) there are additional versions of the multiplication
+	kernels which use MULX, ADCX and ADOX instructions (BMI2 and ADX extensions),
+	they are selected at runtime (by using cpuid) only if the processor supports them
+
+	you can define TTMATH_NOADX macro if you don't want them
+	(for example your assembler doesn't know these instructions)
+*/
+#if !defined TTMATH_NOASM && !defined TTMATH_NOADX && defined __GNUC__
+	#if defined TTMATH_PLATFORM64 && defined __x86_64__
+		#define TTMATH_ADX
+	#endif
+#endif
+
+
+/*!
+	on x86_64 platforms (GCC and CLANG) there is the multiplication in radix 2^52
+	which uses AVX-512 IFMA instructions (UInt::Mul6()), it is used only if the processor
+	supports AVX-512 IFMA extension (checked at runtime by using cpuid)
+
+	you can define TTMATH_NOIFMA macro if you don't want it
+	(for example your compiler doesn't know AVX-512 IFMA intrinsics)
+*/
+#if !defined TTMATH_NOASM && !defined TTMATH_NOIFMA && defined __GNUC__
+	#if defined TTMATH_PLATFORM64 && defined __x86_64__ && (defined __clang__ || __GNUC__ >= 6)
+		#define TTMATH_IFMA
+	#endif
+#endif
+
+
 namespace ttmath
 {
 
@@ -315,16 +345,203 @@ namespace ttmath
 	this is a limit when calculating Karatsuba multiplication
 	if the size of a vector is smaller than TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE
 	the Karatsuba algorithm will use standard schoolbook multiplication
+
+	(the schoolbook multiplication is made by MulAddVector() which multiplies
+	a whole row at once so it is faster than Karatsuba for quite big values)
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor (it should not be smaller than 3)
 */
-#ifdef TTMATH_DEBUG_LOG
-	// if TTMATH_DEBUG_LOG is defined then we should use the same size regardless of the compiler
-	#define TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE 3
-#else
-	#ifdef __GNUC__
-		#define TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE 3
-	#else
-		#define TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE 5
-	#endif
+#ifndef TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE
+	#define TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE 24
+#endif
+
+
+/*!
+	this is a limit when calculating Toom-3 multiplication
+	if the size of a vector is smaller than TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE
+	the Toom-3 algorithm will use Karatsuba multiplication
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor (it should not be smaller than 5)
+*/
+#ifndef TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE
+	#define TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE 150
+#endif
+
+
+/*!
+	this is a limit when calculating Karatsuba squaring (UInt::Sqr() and UInt::SqrBig())
+	if the size of a vector is smaller than TTMATH_USE_KARATSUBA_SQUARING_FROM_SIZE
+	the schoolbook squaring is used, it is much bigger than the limit for the multiplication
+	because the schoolbook squaring calculates only half of the products
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_KARATSUBA_SQUARING_FROM_SIZE
+	#define TTMATH_USE_KARATSUBA_SQUARING_FROM_SIZE 32
+#endif
+
+
+/*!
+	this is a limit when selecting the NTT (Number Theoretic Transform) multiplication
+	in MulFastest() and MulFastestBig(), if the size of a vector is greater than or equal to
+	TTMATH_USE_NTT_MULTIPLICATION_FROM_SIZE the NTT multiplication is used
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_NTT_MULTIPLICATION_FROM_SIZE
+	#define TTMATH_USE_NTT_MULTIPLICATION_FROM_SIZE 4096
+#endif
+
+
+/*!
+	this is a limit when selecting the IFMA multiplication (UInt::Mul6()) in MulFastest()
+	and MulFastestBig(), if the size of a vector is greater than or equal to
+	TTMATH_USE_IFMA_MULTIPLICATION_FROM_SIZE (and not greater than TTMATH_IFMA_MAX_SIZE)
+	and the processor supports AVX-512 IFMA instructions the IFMA multiplication is used
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_IFMA_MULTIPLICATION_FROM_SIZE
+	#define TTMATH_USE_IFMA_MULTIPLICATION_FROM_SIZE 16
+#endif
+
+
+/*!
+	this is a limit for the IFMA multiplication (UInt::Mul6())
+	the values which have more words (without the highest words equal zero) are multiplied
+	by the MulFastestBig() algorithms
+
+	the sums of the 52-bit products in one column have to fit in a 64-bit word
+	so don't use bigger values than about 1600
+*/
+#ifndef TTMATH_IFMA_MAX_SIZE
+	#define TTMATH_IFMA_MAX_SIZE 1024
+#endif
+
+
+/*!
+	this is a limit when selecting the Burnikel-Ziegler division (UInt::Div4()) in UInt::Div(),
+	if the divisor and the quotient have at least TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE
+	words the Burnikel-Ziegler division is used
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE
+	#define TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE 150
+#endif
+
+
+/*!
+	this is a limit for the recursion in the Burnikel-Ziegler division (UInt::Div4())
+	and in the reciprocal in the Newton division (UInt::Div5()),
+	the blocks which have TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE words or less
+	are divided by the schoolbook algorithm (the same as in UInt::Div3())
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE
+	#define TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE 40
+#endif
+
+
+/*!
+	this is a limit when selecting the Newton division (UInt::Div5()) in Big::Div(),
+	if the mantissa has at least TTMATH_USE_NEWTON_DIVISION_FROM_SIZE words
+	the Newton division is used, otherwise UInt::Div() is used
+
+	the Newton division needs about five multiplications of the whole mantissas
+	so it is faster only when the multiplication is very fast (the Burnikel-Ziegler
+	division in UInt::Div() was faster for all sizes we have tested)
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_NEWTON_DIVISION_FROM_SIZE
+	#define TTMATH_USE_NEWTON_DIVISION_FROM_SIZE 65536
+#endif
+
+
+/*!
+	this is a limit when selecting the algorithm in UIntDivisor (a precomputed divisor),
+	if the divisor has at least TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE words
+	the Newton reciprocal of the whole divisor is calculated once and the values are divided
+	by multiplying by it, otherwise the schoolbook algorithm is used (the quotient words are
+	estimated by the reciprocal of the highest word of the divisor)
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE
+	#define TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE 48
+#endif
+
+
+/*!
+	this is a limit for the auxiliary buffers (in words) which are allocated on the stack
+	in the division by UIntDivisor and in Big::ToChars(), bigger buffers are allocated on the heap
+	(the size of these buffers depends on the size of the values - they would be
+	too big on the stack for huge types)
+*/
+#ifndef TTMATH_STACK_BUFFER_MAX_SIZE
+	#define TTMATH_STACK_BUFFER_MAX_SIZE 512
+#endif
+
+
+/*!
+	this is a limit when selecting the divide and conquer radix conversion
+	in UInt::ToString() and UInt::FromString() (Int uses them too),
+	if the value has at least TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE words
+	it is split by the powers of the base: (b^k)^(2^j), where b^k is the greatest
+	power of the base which fits in one word, and the parts which have less than
+	TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE words are converted word by word
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE
+	#define TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE 64
+#endif
+
+
+/*!
+	this is a limit when selecting the algorithm for the natural logarithm in Big::Ln(),
+	if the mantissa has at least TTMATH_USE_AGM_LOGARITHM_FROM_SIZE words the logarithm
+	is calculated from the arithmetic-geometric mean: ln(s) = pi / (2*AGM(1, 4/s))
+	(its cost grows with log(bits) multiplications and square roots), smaller values
+	are calculated by the series from Big::LnSurrounding1()
+
+	you can define this macro before including ttmath.h if you want to tune it
+	for your processor
+*/
+#ifndef TTMATH_USE_AGM_LOGARITHM_FROM_SIZE
+	#define TTMATH_USE_AGM_LOGARITHM_FROM_SIZE 6
+#endif
+
+
+/*!
+	if the mantissa has from TTMATH_USE_LN_EXP_TABLES_FROM_SIZE to TTMATH_LN_EXP_TABLES_MAX_SIZE
+	words the arguments of Big::Ln() and Big::Exp() are reduced by tables of ln(2^16/q1),
+	ln(2^24/q2), e^(j/2^8) and e^(j/2^16) (where q1/2^16 and q2/2^24 are close to 1/(1+i/2^8)
+	and 1/(1+j/2^16)) so the series have about 17 bits less to calculate,
+	the tables are calculated once for each Big<> type when used the first time
+	(about 1200 values with one more word in the mantissa)
+
+	you can define these macros before including ttmath.h if you want to tune them
+	for your processor
+*/
+#ifndef TTMATH_USE_LN_EXP_TABLES_FROM_SIZE
+	#define TTMATH_USE_LN_EXP_TABLES_FROM_SIZE 4
+#endif
+
+#ifndef TTMATH_LN_EXP_TABLES_MAX_SIZE
+	#define TTMATH_LN_EXP_TABLES_MAX_SIZE 16
 #endif
 
 
@@ -352,6 +569,8 @@ namespace ttmath
 		-  asm_gcc_64  - with asm for GCC (64 bit)
 		-  no_asm_32   - pure C++ version (32 bit) - without any asm code
 		-  no_asm_64   - pure C++ version (64 bit) - without any asm code
+		-  asm_gcc_64_adx - with asm for GCC (64 bit), the processor supports MULX, ADCX and ADOX
+		                    instructions and the multiplication kernels are using them
 	*/
 	enum LibTypeCode
 	{
@@ -360,7 +579,8 @@ namespace ttmath
 	  asm_vc_64,
 	  asm_gcc_64,
 	  no_asm_32,
-	  no_asm_64
+	  no_asm_64,
+	  asm_gcc_64_adx
 	};
 
 
@@ -461,6 +681,31 @@ namespace ttmath
 		sint round;
 
 
+		/*!
+			used only in Big::ToString()
+			if true the shortest string is printed which is read back by Big::FromString()
+			(with the same Conv) to exactly the same value, 'round' and 'base_round' are not used then
+			default: false
+
+			e.g.
+				Big<1, 1> a = "2.675";
+				with base_round=false and shortest=false the result is 2.674999999999999999
+				(on a 64 bit platform) and with shortest=true the result is 2.675
+				(base_round gives only an approximation of the shortest string and it
+				is not always read back to the same value)
+
+			when the binary exponent of the value is from <-2*man*TTMATH_BITS_PER_UINT,
+			2*man*TTMATH_BITS_PER_UINT> the digits are calculated exactly, otherwise
+			FromString() is not exact and each candidate string is read back to check it
+			(the check assumes the scientific mode for the base 10), when the base is
+			different from 10 the value should not be printed in the scientific mode
+			(FromString() doesn't read the "*10^" part), for a base which is a power
+			of two all digits are printed when the exponent is out of that range
+			(they are exact), all digits are printed too if no candidate is read back
+		*/
+		bool shortest;
+
+
 		/*!
 			if true that not mattered digits in the mantissa will be cut off
 			(zero characters at the end -- after the comma operator)
@@ -519,6 +764,7 @@ namespace ttmath
 			scient_from  = 15;
 			base_round   = true;
 			round        = -1;
+			shortest     = false;
 			trim_zeroes  = true;
 			comma        = '.';
 			comma2       = ',';
@@ -530,6 +776,43 @@ namespace ttmath
 
 
 
+	/*!
+		the result of ToChars() methods (similar to std::to_chars_result)
+
+		ptr - one past the last written character,
+		      or the end of the buffer if the buffer was too small
+		ec  - err_ok
+		      err_overflow          - the buffer was too small (or the value could not be converted),
+		                              the content of the buffer is unspecified then
+		      err_improper_argument - the base was not from <2,16>
+	*/
+	struct ToCharsResult
+	{
+		char * ptr;
+		ErrorCode ec;
+	};
+
+
+
+	/*!
+		the result of FromChars() methods (similar to std::from_chars_result)
+
+		ptr - one past the last character of the parsed value,
+		      or the beginning of the input if nothing could be read
+		ec  - err_ok
+		      err_nothing_has_read  - there were no digits, the value is not modified
+		      err_overflow          - the value was too big, the value is not modified
+		                              (ptr points past the whole number anyway)
+		      err_improper_argument - the base was not from <2,16>
+	*/
+	struct FromCharsResult
+	{
+		const char * ptr;
+		ErrorCode ec;
+	};
+
+
+
 	/*!
 		this simple class can be used in multithreading model
 		(you can write your own class derived from this one)
@@ -48,6 +48,7 @@
 
 #include <iostream>
 #include <iomanip>
+#include <cmath>
 
 
 #include "ttmathtypes.h"
@@ -61,6 +62,10 @@
 namespace ttmath
 {
 
+template<uint value_size> class UIntDivisor;
+template<uint value_size> class UIntMontgomery;
+
+
 /*! 
 	\brief UInt implements a big integer value without a sign
 
@@ -834,8 +839,7 @@ public:
 	*/
 	uint MulInt(uint ss2)
 	{
-	uint r1, r2, x1;
-	uint c = 0;
+	uint c;
 
 		UInt<value_size> u(*this);
 		SetZero();
@@ -846,16 +850,8 @@ public:
 			return 0;
 		}
 
-		for(x1=0 ; x1<value_size-1 ; ++x1)
-		{
-			MulTwoWords(u.table[x1], ss2, &r2, &r1);
-			c += AddTwoInts(r2,r1,x1);
-		}
-
-		// x1 = value_size-1  (last word)
-		MulTwoWords(u.table[x1], ss2, &r2, &r1);
-		c += (r2!=0) ? 1 : 0;
-		c += AddInt(r1, x1);
+		// c is the highest word of the product
+		c = MulAddVector(u.table, value_size, ss2, table);
 
 		TTMATH_LOGC("UInt::MulInt(uint)", c)
 
@@ -874,7 +870,6 @@ public:
 	{
 	TTMATH_ASSERT( result_size > value_size )
 
-	uint r2,r1;
 	uint x1size=value_size;
 	uint x1start=0;
 
@@ -902,11 +897,8 @@ public:
 			for(x1start=0 ; x1start<x1size && table[x1start]==0 ; ++x1start);
 		}
 
-		for(uint x1=x1start ; x1<x1size ; ++x1)
-		{
-			MulTwoWords(table[x1], ss2, &r2, &r1 );
-			result.AddTwoInts(r2,r1,x1);
-		}
+		// x1size is smaller than result_size
+		result.table[x1size] = MulAddVector(table+x1start, x1size-x1start, ss2, result.table+x1start);
 
 		TTMATH_VECTOR_LOG("UInt::MulInt(uint, UInt<>)", result.table, result_size)
 
@@ -933,6 +925,15 @@ public:
 		case 3:
 			return Mul3(ss2);
 
+		case 4:
+			return Mul4(ss2);
+
+		case 5:
+			return Mul5(ss2);
+
+		case 6:
+			return Mul6(ss2);
+
 		case 100:
 		default:
 			return MulFastest(ss2);
@@ -966,6 +967,18 @@ public:
 			Mul3Big(ss2, result);
 			break;
 
+		case 4:
+			Mul4Big(ss2, result);
+			break;
+
+		case 5:
+			Mul5Big(ss2, result);
+			break;
+
+		case 6:
+			Mul6Big(ss2, result);
+			break;
+
 		case 100:
 		default:
 			MulFastestBig(ss2, result);
@@ -1112,7 +1125,7 @@ public:
 	*/
 	void Mul2Big(const UInt<value_size> & ss2, UInt<value_size*2> & result)
 	{
-		Mul2Big2<value_size>(table, ss2.table, result);
+		Mul2Big2<value_size>(table, ss2.table, result.table);
 
 		TTMATH_LOG("UInt::Mul2Big")
 	}
@@ -1124,11 +1137,12 @@ private:
 		an auxiliary method for calculating the multiplication 
 
 		arguments we're taking as pointers (this is to improve the Mul3Big2()- avoiding
-		unnecessary copying objects), the result should be taken as a pointer too,
-		but at the moment there is no method AddTwoInts() which can operate on pointers
+		unnecessary copying objects)
+
+		result_size is equal ss_size*2
 	*/
 	template<uint ss_size>
-	void Mul2Big2(const uint * ss1, const uint * ss2, UInt<ss_size*2> & result)
+	static void Mul2Big2(const uint * ss1, const uint * ss2, uint * result)
 	{
 	uint x1size  = ss_size, x2size  = ss_size;
 	uint x1start = 0,       x2start = 0;
@@ -1152,26 +1166,33 @@ private:
 
 	/*!
 		an auxiliary method for calculating the multiplication 
+
+		each word from ss1 is multiplied by the whole ss2 and the row is added
+		to the result in one pass by MulAddVector(), the carry from the row
+		goes to the word which has not been used yet (it is zero)
+
+		result_size is equal ss_size*2
 	*/
 	template<uint ss_size>
-	void Mul2Big3(const uint * ss1, const uint * ss2, UInt<ss_size*2> & result, uint x1start, uint x1size, uint x2start, uint x2size)
+	static void Mul2Big3(const uint * ss1, const uint * ss2, uint * result, uint x1start, uint x1size, uint x2start, uint x2size)
 	{
-	uint r2, r1;
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wtautological-compare"
+#endif
 
-		result.SetZero();
+		for(uint i=0 ; i<ss_size*2 ; ++i)
+			result[i] = 0;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
 
 		if( x1size==0 || x2size==0 )
 			return;
 
 		for(uint x1=x1start ; x1<x1size ; ++x1)
-		{
-			for(uint x2=x2start ; x2<x2size ; ++x2)
-			{
-				MulTwoWords(ss1[x1], ss2[x2], &r2, &r1);
-				result.AddTwoInts(r2, r1, x2+x1);
-				// here will never be a carry
-			}
-		}
+			result[x1 + x2size] = MulAddVector(ss2 + x2start, x2size - x2start, ss1[x1], result + x1 + x2start);
 	}
 
 
@@ -1266,22 +1287,8 @@ private:
 
 		if( ss_size>1 && ss_size<TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
 		{
-			UInt<ss_size*2> res;
-			Mul2Big2<ss_size>(ss1, ss2, res);
-
-#ifdef __clang__
-#pragma clang diagnostic push
-#pragma clang diagnostic ignored "-Wtautological-compare"
-#endif
-
-			for(uint i=0 ; i<ss_size*2 ; ++i)
-				result[i] = res.table[i];
-
-#ifdef __clang__
-#pragma clang diagnostic pop
-#endif
-
-		return;
+			Mul2Big2<ss_size>(ss1, ss2, result);
+			return;
 		}
 		else
 		if( ss_size == 1 )
@@ -1475,15 +1482,41 @@ public:
 
 
 	/*!
-		multiplication this = this * ss2
+		multiplication: this = this * ss2
+
+		This is Toom-3 (Toom-Cook) multiplication algorithm, we're using it when value_size is greater than
+		or equal to TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE macro (defined in ttmathtypes.h).
+		If value_size is smaller then we're using Karatsuba multiplication instead.
+
+		Toom-3 multiplication:
+		Assume we have:
+
+			this = x = x2*B^(2m) + x1*B^m + x0
+			ss2  = y = y2*B^(2m) + y1*B^m + y0
+
+		we can treat them as polynomials p(t) = x2*t^2 + x1*t + x0 and q(t) = y2*t^2 + y1*t + y0
+		and the product r(t) = p(t)*q(t) = c4*t^4 + c3*t^3 + c2*t^2 + c1*t + c0 is fully determined
+		by its values in five points, we're using: 0, 1, -1, 2 and infinity
+
+			r(0)   = x0*y0
+			r(1)   = (x0 + x1 + x2)*(y0 + y1 + y2)
+			r(-1)  = (x0 - x1 + x2)*(y0 - y1 + y2)
+			r(2)   = (x0 + 2*x1 + 4*x2)*(y0 + 2*y1 + 4*y2)
+			r(inf) = x2*y2
+
+		so we need only five multiplications (of about one third of the size) instead of nine,
+		the coefficients c0..c4 we get from the values by some additions, subtractions, shifts
+		and one exact division by 3, and at the end x*y = r(B^m)
+
+		Toom-3 multiplication has O( n^(ln(5)/ln(3)) )
 	*/
-	uint MulFastest(const UInt<value_size> & ss2)
+	uint Mul4(const UInt<value_size> & ss2)
 	{
 	UInt<value_size*2> result;
 	uint i, c = 0;
 
-		MulFastestBig(ss2, result);
-	
+		Mul4Big(ss2, result);
+
 		// copying result
 		for(i=0 ; i<value_size ; ++i)
 			table[i] = result.table[i];
@@ -1496,684 +1529,856 @@ public:
 				break;
 			}
 
-		TTMATH_LOGC("UInt::MulFastest", c)
+		TTMATH_LOGC("UInt::Mul4", c)
 
 	return c;
 	}
 
 
+
 	/*!
-		multiplication result = this * ss2
+		multiplication: result = this * ss2
 
-		this method is trying to select the fastest algorithm
-		(in the future this method can be improved)
+		result is twice bigger than this and ss2,
+		this method never returns carry,
+		(Toom-3 multiplication)
 	*/
-	void MulFastestBig(const UInt<value_size> & ss2, UInt<value_size*2> & result)
+	void Mul4Big(const UInt<value_size> & ss2, UInt<value_size*2> & result)
 	{
-		if( value_size < TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
-		{
-			Mul2Big(ss2, result);
-			return;
-		}
+		Mul4Big2<value_size>(table, ss2.table, result.table);
 
-		uint x1size  = value_size, x2size  = value_size;
-		uint x1start = 0,          x2start = 0;
+		TTMATH_LOG("UInt::Mul4Big")
+	}
 
-		for(x1size=value_size ; x1size>0 && table[x1size-1]==0 ; --x1size);
-		for(x2size=value_size ; x2size>0 && ss2.table[x2size-1]==0 ; --x2size);
 
-		if( x1size==0 || x2size==0 )
-		{
-			// either 'this' or 'ss2' is equal zero - the result is zero too
-			result.SetZero();
-			return;
-		}
 
-		for(x1start=0 ; x1start<x1size && table[x1start]==0 ; ++x1start);
-		for(x2start=0 ; x2start<x2size && ss2.table[x2start]==0 ; ++x2start);
+private:
 
-		uint distancex1 = x1size - x1start;
-		uint distancex2 = x2size - x2start;
+	/*!
+		an auxiliary method for calculating the Toom-3 multiplication
 
-		if( distancex1 < 3 || distancex2 < 3 )
+		result_size is equal ss_size*2
+	*/
+	template<uint ss_size>
+	void Mul4Big2(const uint * ss1, const uint * ss2, uint * result)
+	{
+		if( ss_size < 5 || ss_size < TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE )
 		{
-			// either 'this' or 'ss2' have only 2 (or 1) items different from zero (side by side)
-			// (this condition in the future can be improved)
-			Mul2Big3<value_size>(table, ss2.table, result, x1start, x1size, x2start, x2size);
+			Mul3Big2<ss_size>(ss1, ss2, result);
 			return;
 		}
 
+		// the vectors are split into three parts: x0 and x1 (first_size each) and x2 (second_size)
+		// second_size is from 1 to first_size (for ss_size smaller than 5 the second_size
+		// would be zero or even negative but then this code is not executed)
+		const uint first_size  = (ss_size + 2) / 3;
+		const uint second_size = (ss_size > first_size*2) ? ss_size - first_size*2 : 1;
 
-		// Karatsuba multiplication
-		Mul3Big(ss2, result);
-
-		TTMATH_LOG("UInt::MulFastestBig")
+		Mul4Big3<first_size, second_size, ss_size*2>(ss1, ss2, result);
 	}
 
 
+
+#ifdef _MSC_VER
+#pragma warning (disable : 4717)
+//warning C4717: recursive on all control paths, function will cause runtime stack overflow
+//we have the stop point in Mul4Big2() method
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-but-set-variable"
+#endif
+
+
 	/*!
-	 *
-	 * Division
-	 *
-	 *
+		an auxiliary method for calculating the Toom-3 multiplication
+
+			x = x2*B^(2m) + x1*B^m + x0
+			y = y2*B^(2m) + y1*B^m + y0
+
+			first_size  - is the size of vectors: x0, x1, y0 and y1
+			second_size - is the size of vectors: x2 and y2 (from 1 to first_size)
+
+		the values in the points we're keeping in UInt<first_size+1> (x0 + 2*x1 + 4*x2 is smaller than 7*B^m)
+		and the products and coefficients in UInt<first_size*2+2>, all coefficients are non-negative
+		and if we're calculating them in the following order the temporary values are non-negative too
+		(only r(-1) can be negative, its sign we remember in a separate variable):
+
+			c0 = r(0)
+			c4 = r(inf)
+			c2 = (r(1) + r(-1))/2 - c0 - c4
+			c3 = ((r(2) - c0 - 4*c2 - 16*c4)/2 - (r(1) - r(-1))/2) / 3
+			c1 = (r(1) - r(-1))/2 - c3
 	*/
-	
-public:
+	template<uint first_size, uint second_size, uint result_size>
+	void Mul4Big3(const uint * ss1, const uint * ss2, uint * result)
+	{
+	const uint * x0 = ss1, * x1 = ss1 + first_size, * x2 = ss1 + first_size*2;
+	const uint * y0 = ss2, * y1 = ss2 + first_size, * y2 = ss2 + first_size*2;
+	UInt<first_size+1>   p, q, pm, qm;
+	UInt<first_size*2+2> r1, rm1, r2;
+	uint i;
+	bool rm1_negative;
+
+		// r(0) and r(inf) we store directly in the result
+		Mul4Big2<first_size>(x0, y0, result);
+		Mul4Big2<second_size>(x2, y2, result+first_size*4);
+
+		for(i=first_size*2 ; i<first_size*4 ; ++i)
+			result[i] = 0;
+
+		// r(1) and r(-1)
+		rm1_negative  = Mul4Big_EvaluateOneAndMinusOne<first_size, second_size>(x0, x1, x2, p, pm);
+		rm1_negative ^= Mul4Big_EvaluateOneAndMinusOne<first_size, second_size>(y0, y1, y2, q, qm);
+
+		Mul4Big_MulValues<first_size>(p, q, r1);
+		Mul4Big_MulValues<first_size>(pm, qm, rm1);
+
+		// r(2)
+		Mul4Big_EvaluateTwo<first_size, second_size>(x0, x1, x2, p);
+		Mul4Big_EvaluateTwo<first_size, second_size>(y0, y1, y2, q);
+		Mul4Big_MulValues<first_size>(p, q, r2);
+
+		Mul4Big_Interpolate<first_size, second_size, result_size>(r1, rm1, rm1_negative, r2, result);
+	}
 
 
 	/*!
-		division by one unsigned word
+		an auxiliary method for calculating the Toom-3 multiplication (and squaring)
 
-		returns 1 when divisor is zero
+		it calculates the coefficients c1, c2 and c3 from the values in points 1, -1 and 2
+		and adds them to the result (c0 and c4 are already in the result and the middle
+		of the result is zero), r1, rm1 and r2 are changed
 	*/
-	uint DivInt(uint divisor, uint * remainder = 0)
+	template<uint first_size, uint second_size, uint result_size>
+	static void Mul4Big_Interpolate(UInt<first_size*2+2> & r1, const UInt<first_size*2+2> & rm1, bool rm1_negative,
+	                                UInt<first_size*2+2> & r2, uint * result)
 	{
-		if( divisor == 0 )
-		{
-			if( remainder )
-				*remainder = 0; // this is for convenience, without it the compiler can report that 'remainder' is uninitialized
+	UInt<first_size*2+2> c13, temp;
+	uint i, c;
 
-			TTMATH_LOG("UInt::DivInt")
+		// c13 = (r(1) - r(-1))/2 = c1 + c3
+		// r1  = (r(1) + r(-1))/2 = c0 + c2 + c4
+		c13 = r1;
 
-		return 1;
+		if( rm1_negative )
+		{
+			c13.Add(rm1);
+			r1.Sub(rm1);
 		}
-
-		if( divisor == 1 )
+		else
 		{
-			if( remainder )
-				*remainder = 0;
-
-			TTMATH_LOG("UInt::DivInt")
-
-		return 0;
+			c13.Sub(rm1);
+			r1.Add(rm1);
 		}
 
-		UInt<value_size> dividend(*this);
-		SetZero();
-		
-		sint i;  // i must be with a sign
-		uint r = 0;
+		c13.Rcr(1);
+		r1.Rcr(1);
 
-		// we're looking for the last word in ss1
-		for(i=value_size-1 ; i>0 && dividend.table[i]==0 ; --i);
+		// r1 = r1 - c0 - c4 = c2
+		c = SubVector(r1.table, result, first_size*2+2, first_size*2, r1.table);
+		c += SubVector(r1.table, result+first_size*4, first_size*2+2, second_size*2, r1.table);
+		TTMATH_ASSERT( c==0 )
 
-		for( ; i>=0 ; --i)
-			DivTwoWords(r, dividend.table[i], divisor, &table[i], &r);
+		// r2 = (r(2) - c0 - 4*c2 - 16*c4)/2 - c13 = 3*c3
+		c = SubVector(r2.table, result, first_size*2+2, first_size*2, r2.table);
 
-		if( remainder )
-			*remainder = r;
+		temp = r1;
+		temp.Rcl(2);
+		c += r2.Sub(temp);
 
-		TTMATH_LOG("UInt::DivInt")
+		temp.SetZero();
+		for(i=0 ; i<second_size*2 ; ++i)
+			temp.table[i] = result[first_size*4 + i];
 
-	return 0;
-	}
+		temp.Rcl(4);
+		c += r2.Sub(temp);
+		r2.Rcr(1);
+		c += r2.Sub(c13);
+		TTMATH_ASSERT( c==0 )
 
-	uint DivInt(uint divisor, uint & remainder)
-	{
-		return DivInt(divisor, &remainder);
-	}
+		// r2 = c3, c13 = c1
+		Mul4Big_ExactDivBy3(r2.table, first_size*2+2);
+		c13.Sub(r2);
 
+		// x*y = c4*B^(4m) + c3*B^(3m) + c2*B^(2m) + c1*B^m + c0
+		// c0 and c4 are already in the result
+		Mul4Big_AddCoefficient<first_size*2+2, result_size>(result, first_size,   c13.table);
+		Mul4Big_AddCoefficient<first_size*2+2, result_size>(result, first_size*2, r1.table);
+		Mul4Big_AddCoefficient<first_size*2+2, result_size>(result, first_size*3, r2.table);
+	}
 
 
 	/*!
-		division this = this / ss2
-		
-		return values:
-		-  0 - ok
-		-  1 - division by zero
-		-  'this' will be the quotient
-		-  'remainder' - remainder
+		an auxiliary method for calculating the Toom-3 multiplication
+
+		it calculates the values in points 1 and -1:
+			one       = x0 + x1 + x2
+			minus_one = |x0 - x1 + x2|
+		and returns true if (x0 - x1 + x2) is negative
 	*/
-	uint Div(	const UInt<value_size> & divisor,
-				UInt<value_size> * remainder = 0,
-				uint algorithm = 3)
+	template<uint first_size, uint second_size>
+	static bool Mul4Big_EvaluateOneAndMinusOne(const uint * x0, const uint * x1, const uint * x2,
+	                                           UInt<first_size+1> & one, UInt<first_size+1> & minus_one)
 	{
-		switch( algorithm )
-		{
-		case 1:
-			return Div1(divisor, remainder);
+	UInt<first_size+1> temp;
+	uint i;
+	bool negative = false;
 
-		case 2:
-			return Div2(divisor, remainder);
+		// minus_one = x0 + x2
+		minus_one.table[first_size] = AddVector(x0, x2, first_size, second_size, minus_one.table);
 
-		case 3:
-		default:
-			return Div3(divisor, remainder);
+		for(i=0 ; i<first_size ; ++i)
+			temp.table[i] = x1[i];
+
+		temp.table[first_size] = 0;
+
+		// one = x0 + x1 + x2
+		one = minus_one;
+		one.Add(temp);
+
+		if( minus_one < temp )
+		{
+			temp.Sub(minus_one);
+			minus_one = temp;
+			negative = true;
+		}
+		else
+		{
+			minus_one.Sub(temp);
 		}
+
+	return negative;
 	}
 
-	uint Div(const UInt<value_size> & divisor, UInt<value_size> & remainder, uint algorithm = 3)
+
+	/*!
+		an auxiliary method for calculating the Toom-3 multiplication
+
+		it calculates the value in point 2:
+			two = x0 + 2*x1 + 4*x2 = (x2*2 + x1)*2 + x0
+	*/
+	template<uint first_size, uint second_size>
+	static void Mul4Big_EvaluateTwo(const uint * x0, const uint * x1, const uint * x2, UInt<first_size+1> & two)
 	{
-		return Div(divisor, &remainder, algorithm);
-	}
+	uint i;
 
+		two.SetZero();
 
+		for(i=0 ; i<second_size ; ++i)
+			two.table[i] = x2[i];
+
+		two.Rcl(1);
+		AddVector(two.table, x1, first_size+1, first_size, two.table);
+		two.Rcl(1);
+		AddVector(two.table, x0, first_size+1, first_size, two.table);
+	}
 
-private:
 
 	/*!
-		return values:
-		-  0 - none has to be done
-		-  1 - division by zero
-		-  2 - division should be made
+		an auxiliary method for calculating the Toom-3 multiplication
+
+		it multiplies the values from the points: result = p * q
+		the highest words of p and q are small (smaller than 7) so we're multiplying only
+		the lower first_size words (the sizes of the vectors are better for the recursion then)
+		and the highest words we're taking into account in the schoolbook way:
+
+		             p_hi   |    p_lo
+		             q_hi   |    q_lo
+		         -----------------------
+		                 (p_lo * q_lo)
+		             p_hi*q_lo |
+		             q_hi*p_lo |
+		     p_hi*q_hi |
 	*/
-	uint Div_StandardTest(	const UInt<value_size> & v,
-							uint & m, uint & n,
-							UInt<value_size> * remainder = 0)
+	template<uint first_size>
+	void Mul4Big_MulValues(const UInt<first_size+1> & p, const UInt<first_size+1> & q, UInt<first_size*2+2> & result)
 	{
-		switch( Div_CalculatingSize(v, m, n) )
-		{
-		case 4: // 'this' is equal v
-			if( remainder )
-				remainder->SetZero();
+	uint p_hi = p.table[first_size];
+	uint q_hi = q.table[first_size];
+	uint c = 0;
 
-			SetOne();
-			TTMATH_LOG("UInt::Div_StandardTest")
-			return 0;
+		Mul4Big2<first_size>(p.table, q.table, result.table);
 
-		case 3: // 'this' is smaller than v
-			if( remainder )
-				*remainder = *this;
+		// c is small (smaller than 14)
+		if( p_hi )
+			c += MulAddVector(q.table, first_size, p_hi, result.table + first_size);
 
-			SetZero();
-			TTMATH_LOG("UInt::Div_StandardTest")
-			return 0;
+		if( q_hi )
+			c += MulAddVector(p.table, first_size, q_hi, result.table + first_size);
 
-		case 2: // 'this' is zero
-			if( remainder )
-				remainder->SetZero();
+		result.table[first_size*2]   = c + p_hi * q_hi;
+		result.table[first_size*2+1] = 0;
+	}
 
-			SetZero();
-			TTMATH_LOG("UInt::Div_StandardTest")
-			return 0;
 
-		case 1: // v is zero
-			TTMATH_LOG("UInt::Div_StandardTest")
-			return 1;
-		}
+	/*!
+		an auxiliary method for calculating the Toom-3 multiplication
 
-		TTMATH_LOG("UInt::Div_StandardTest")
+		it adds the coefficient to the result at the given index (in words),
+		the coefficient is shorter than coefficient_size when it is near the end of the result
+		(the higher words are equal zero then)
+	*/
+	template<uint coefficient_size, uint result_size>
+	static void Mul4Big_AddCoefficient(uint * result, uint index, const uint * coefficient)
+	{
+	uint size = result_size - index;
+	uint c;
 
-	return 2;
+		if( size > coefficient_size )
+			size = coefficient_size;
+
+		c = AddVector(result+index, coefficient, result_size-index, size, result+index);
+		TTMATH_ASSERT( c==0 )
 	}
 
 
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
-	/*!
-		return values:
-		-  0 - ok
-			-  'm' - is the index (from 0) of last non-zero word in table ('this')
-			-  'n' - is the index (from 0) of last non-zero word in v.table
-		-  1 - v is zero
-		-  2 - 'this' is zero
-		-  3 - 'this' is smaller than v
-		-  4 - 'this' is equal v
-
-		if the return value is different than zero the 'm' and 'n' are undefined
-	*/
-	uint Div_CalculatingSize(const UInt<value_size> & v, uint & m, uint & n)
-	{
-		m = n = value_size-1;
-
-		for( ; n!=0 && v.table[n]==0 ; --n);
+#ifdef _MSC_VER
+#pragma warning (default : 4717)
+#endif
 
-		if( n==0 && v.table[n]==0 )
-			return 1;
 
-		for( ; m!=0 && table[m]==0 ; --m);
+	/*!
+		an auxiliary method for calculating the Toom-3 multiplication
 
-		if( m==0 && table[m]==0 )
-			return 2;
+		it divides the vector by 3 in place, the vector must be divisible by 3
+		(we're multiplying by the inverse of 3 modulo 2^TTMATH_BITS_PER_UINT so there are no divisions)
+	*/
+	static void Mul4Big_ExactDivBy3(uint * vector, uint size)
+	{
+	const uint inverse = TTMATH_UINT_MAX_VALUE / 3 * 2 + 1;
+	const uint one_third = TTMATH_UINT_MAX_VALUE / 3;
+	uint i, s, q, c = 0;
 
-		if( m < n )
-			return 3;
-		else
-		if( m == n )
+		for(i=0 ; i<size ; ++i)
 		{
-			uint i;
-			for(i = n ; i!=0 && table[i]==v.table[i] ; --i);
-			
-			if( table[i] < v.table[i] )
-				return 3;
-			else
-			if (table[i] == v.table[i] )
-				return 4;
+			s = vector[i] - c;
+			c = (s > vector[i]) ? 1 : 0;
+			q = s * inverse;
+			vector[i] = q;
+
+			// the high word of q*3
+			c += (q > one_third)   ? 1 : 0;
+			c += (q > one_third*2) ? 1 : 0;
 		}
 
-	return 0;
+		TTMATH_ASSERT( c==0 )
 	}
 
 
+
 public:
 
+
 	/*!
-		the first division algorithm
-		(radix 2)
+		multiplication: this = this * ss2
+
+		This is the multiplication by using the Number Theoretic Transform (NTT),
+		we're using it when value_size is greater than or equal to
+		TTMATH_USE_NTT_MULTIPLICATION_FROM_SIZE macro (defined in ttmathtypes.h).
+
+		The words of 'this' and 'ss2' are treated as coefficients of two polynomials,
+		the product of the polynomials (a convolution) is calculated by using a fast transform
+		in the ring of integers modulo a prime p (where there is a root of unity of order 2^k).
+		A coefficient of the convolution can be as big as n*(2^TTMATH_BITS_PER_UINT)^2
+		so we're calculating the convolution modulo three different primes and the real
+		values we're getting from the Chinese Remainder Theorem, at the end we're
+		propagating the carries.
+
+		The NTT multiplication has O( n*log(n) ) (for the size of the values which fit in the memory),
+		but there is a big constant so it is used only for very big values.
+		This algorithm uses a temporary memory (std::vector) - about 5*n words.
 	*/
-	uint Div1(const UInt<value_size> & divisor, UInt<value_size> * remainder = 0)
+	uint Mul5(const UInt<value_size> & ss2)
 	{
-	uint m,n, test;
+	UInt<value_size*2> result;
+	uint i, c = 0;
 
-		test = Div_StandardTest(divisor, m, n, remainder);
-		if( test < 2 )
-			return test;
+		Mul5Big(ss2, result);
 
-		if( !remainder )
-		{
-			UInt<value_size> rem;
-	
-		return Div1_Calculate(divisor, rem);
-		}
+		// copying result
+		for(i=0 ; i<value_size ; ++i)
+			table[i] = result.table[i];
 
-	return Div1_Calculate(divisor, *remainder);
+		// testing carry
+		for( ; i<value_size*2 ; ++i)
+			if( result.table[i] != 0 )
+			{
+				c = 1;
+				break;
+			}
+
+		TTMATH_LOGC("UInt::Mul5", c)
+
+	return c;
 	}
 
 
+
 	/*!
-		the first division algorithm
-		(radix 2)
+		multiplication: result = this * ss2
+
+		result is twice bigger than this and ss2,
+		this method never returns carry,
+		(multiplication by using the Number Theoretic Transform)
 	*/
-	uint Div1(const UInt<value_size> & divisor, UInt<value_size> & remainder)
+	void Mul5Big(const UInt<value_size> & ss2, UInt<value_size*2> & result)
 	{
-		return Div1(divisor, &remainder);
+		Mul5Big2<value_size>(table, ss2.table, result.table);
+
+		TTMATH_LOG("UInt::Mul5Big")
 	}
 
 
+
 private:
 
-	uint Div1_Calculate(const UInt<value_size> & divisor, UInt<value_size> & rest)
+
+	/*!
+		an auxiliary method for calculating the NTT multiplication
+
+		result_size is equal ss_size*2
+	*/
+	template<uint ss_size>
+	void Mul5Big2(const uint * ss1, const uint * ss2, uint * result)
 	{
-		if( this == &divisor )
-		{
-			UInt<value_size> divisor_copy(divisor);
-			return Div1_CalculateRef(divisor_copy, rest);
-		}
-		else
+	uint x1size, x2size, i;
+
+		for(x1size=ss_size ; x1size>0 && ss1[x1size-1]==0 ; --x1size);
+		for(x2size=ss_size ; x2size>0 && ss2[x2size-1]==0 ; --x2size);
+
+		for(i=0 ; i<ss_size*2 ; ++i)
+			result[i] = 0;
+
+		if( x1size==0 || x2size==0 )
+			return;
+
+		if( x1size < 2 || x2size < 2 )
 		{
-			return Div1_CalculateRef(divisor, rest);
+			Mul2Big3<ss_size>(ss1, ss2, result, 0, x1size, 0, x2size);
+			return;
 		}
-	}
 
+		Mul5Big3(ss1, x1size, ss2, x2size, result);
+	}
 
-	uint Div1_CalculateRef(const UInt<value_size> & divisor, UInt<value_size> & rest)
-	{
-	TTMATH_REFERENCE_ASSERT( divisor )
-	
-	sint loop;
-	sint c;
 
-		rest.SetZero();
-		loop = value_size * TTMATH_BITS_PER_UINT;
-		c = 0;
+	/*!
+		a prime used in the NTT multiplication
 
-		
-	div_a:
-		c = Rcl(1, c);
-		c = rest.Add(rest,c);
-		c = rest.Sub(divisor,c);
+		p is smaller than 2^(TTMATH_BITS_PER_UINT-1) and the numbers modulo p
+		are kept in the Montgomery form: a*R (mod p) where R = 2^TTMATH_BITS_PER_UINT
+	*/
+	struct Mul5Prime
+	{
+		uint p;
+		uint p_inv;   // -p^(-1) modulo R
+		uint one;     // R modulo p  (one in the Montgomery form)
+		uint r2;      // R^2 modulo p
+		uint root;    // a primitive root modulo p (normal form)
+	};
 
-		c = !c;
 
-		if(!c)
-			goto div_d;
+	/*!
+		an auxiliary method for calculating the NTT multiplication
 
+		it sets one of the three primes (index: 0, 1 or 2),
+		all of them have the form: k*2^m + 1 (m is at least 55 on 64bit platforms and 24 on 32bit ones)
+	*/
+	static void Mul5_SetPrime(uint index, Mul5Prime & prime)
+	{
+	uint i, high, low, q;
 
-	div_b:
-		--loop;
-		if(loop)
-			goto div_a;
+	#ifdef TTMATH_PLATFORM32
 
-		c = Rcl(1, c);
-		TTMATH_LOG("UInt::Div1_Calculate")
-		return 0;
+		static const uint primes[3] = { 2013265921u,  // 15*2^27 + 1
+		                                469762049u,   //  7*2^26 + 1
+		                                754974721u }; // 45*2^24 + 1
+		static const uint roots[3]  = { 31u, 3u, 11u };
 
+	#else
 
-	div_c:
-		c = Rcl(1, c);
-		c = rest.Add(rest,c);
-		c = rest.Add(divisor);
+		static const uint primes[3] = { 4179340454199820289ul,  // 29*2^57 + 1
+		                                2485986994308513793ul,  // 69*2^55 + 1
+		                                1945555039024054273ul };// 27*2^56 + 1
+		static const uint roots[3]  = { 3ul, 5ul, 5ul };
 
-		if(c)
-			goto div_b;
+	#endif
 
+		prime.p    = primes[index];
+		prime.root = roots[index];
 
-	div_d:
-		--loop;
-		if(loop)
-			goto div_c;
+		// Newton's iteration (each step doubles the number of correct bits, p*p is 1 modulo 8)
+		prime.p_inv = prime.p;
 
-		c = Rcl(1, c);
-		c = rest.Add(divisor);
+		for(i=0 ; i<5 ; ++i)
+			prime.p_inv *= 2 - prime.p * prime.p_inv;
 
-		TTMATH_LOG("UInt::Div1_Calculate")
+		prime.p_inv = 0 - prime.p_inv;
+		prime.one   = (TTMATH_UINT_MAX_VALUE % prime.p + 1) % prime.p;
 
-	return 0;
+		MulTwoWords(prime.one, prime.one, &high, &low);
+		DivTwoWords(high, low, prime.p, &q, &prime.r2);
 	}
-	
 
-public:
 
 	/*!
-		the second division algorithm
+		an auxiliary method for calculating the NTT multiplication
 
-		return values:
-		-  0 - ok
-		-  1 - division by zero
+		the Montgomery multiplication: a * b * R^(-1) (mod p)
+		a can be any word, b should be smaller than p, the result is smaller than p
 	*/
-	uint Div2(const UInt<value_size> & divisor, UInt<value_size> * remainder = 0)
+	static uint Mul5_MulMod(uint a, uint b, const Mul5Prime & prime)
 	{
-		if( this == &divisor )
-		{
-			UInt<value_size> divisor_copy(divisor);
-			return Div2Ref(divisor_copy, remainder);
-		}
-		else
-		{
-			return Div2Ref(divisor, remainder);
-		}
+	uint high, low, m_high, m_low, m, result;
+
+		MulTwoWords(a, b, &high, &low);
+		m = low * prime.p_inv;
+		MulTwoWords(m, prime.p, &m_high, &m_low);
+
+		// low + m_low is equal zero modulo R (there is a carry if low is different from zero)
+		result = high + m_high + ((low != 0) ? 1 : 0);
+
+		if( result >= prime.p )
+			result -= prime.p;
+
+	return result;
 	}
 
 
 	/*!
-		the second division algorithm
-
-		return values:
-		-  0 - ok
-		-  1 - division by zero
+		an auxiliary method for calculating the NTT multiplication
+		(a and b should be smaller than p)
 	*/
-	uint Div2(const UInt<value_size> & divisor, UInt<value_size> & remainder)
+	static uint Mul5_AddMod(uint a, uint b, const Mul5Prime & prime)
 	{
-		return Div2(divisor, &remainder);
+		uint result = a + b;
+
+		if( result >= prime.p )
+			result -= prime.p;
+
+	return result;
 	}
 
 
-private:
+	/*!
+		an auxiliary method for calculating the NTT multiplication
+		(a and b should be smaller than p)
+	*/
+	static uint Mul5_SubMod(uint a, uint b, const Mul5Prime & prime)
+	{
+		if( a >= b )
+			return a - b;
+
+	return a + (prime.p - b);
+	}
+
 
 	/*!
-		the second division algorithm
+		an auxiliary method for calculating the NTT multiplication
 
-		return values:
-		-  0 - ok
-		-  1 - division by zero
+		it returns a^pow in the Montgomery form (a should be in the Montgomery form too)
 	*/
-	uint Div2Ref(const UInt<value_size> & divisor, UInt<value_size> * remainder = 0)
+	static uint Mul5_PowMod(uint a, uint pow, const Mul5Prime & prime)
 	{
-		uint bits_diff;
-		uint status = Div2_Calculate(divisor, remainder, bits_diff);
-		if( status < 2 )
-			return status;
+	uint result = prime.one;
 
-		if( CmpBiggerEqual(divisor) )
-		{
-			Div2(divisor, remainder);
-			SetBit(bits_diff);
-		}
-		else
+		while( pow != 0 )
 		{
-			if( remainder )
-				*remainder = *this;
+			if( (pow & 1) != 0 )
+				result = Mul5_MulMod(result, a, prime);
 
-			SetZero();
-			SetBit(bits_diff);
+			a = Mul5_MulMod(a, a, prime);
+			pow >>= 1;
 		}
 
-		TTMATH_LOG("UInt::Div2")
-
-	return 0;
+	return result;
 	}
 
 
 	/*!
-		return values:
-		-  0 - we've calculated the division
-		-  1 - division by zero
-		-  2 - we have to still calculate
+		an auxiliary method for calculating the NTT multiplication
 
+		it sets roots[i] = w^i for i=0..n/2-1 (in the Montgomery form)
+		where w is a root of unity of order n (or its inverse if inverse is true)
 	*/
-	uint Div2_Calculate(const UInt<value_size> & divisor, UInt<value_size> * remainder,
-															uint & bits_diff)
+	static void Mul5_Roots(uint * roots, uint n, bool inverse, const Mul5Prime & prime)
 	{
-	uint table_id, index;
-	uint divisor_table_id, divisor_index;
+	uint w, i;
 
-		uint status = Div2_FindLeadingBitsAndCheck(	divisor, remainder,
-													table_id, index,
-													divisor_table_id, divisor_index);
-
-		if( status < 2 )
-		{
-			TTMATH_LOG("UInt::Div2_Calculate")
-			return status;
-		}
-		
-		// here we know that 'this' is greater than divisor
-		// then 'index' is greater or equal 'divisor_index'
-		bits_diff = index - divisor_index;
-
-		UInt<value_size> divisor_copy(divisor);
-		divisor_copy.Rcl(bits_diff, 0);
+		w = Mul5_MulMod(prime.root, prime.r2, prime);
+		w = Mul5_PowMod(w, (prime.p - 1) / n, prime);
 
-		if( CmpSmaller(divisor_copy, table_id) )
-		{
-			divisor_copy.Rcr(1);
-			--bits_diff;
-		}
-
-		Sub(divisor_copy, 0);
+		if( inverse )
+			w = Mul5_PowMod(w, n - 1, prime);
 
-		TTMATH_LOG("UInt::Div2_Calculate")
+		roots[0] = prime.one;
 
-	return 2;
+		for(i=1 ; i<n/2 ; ++i)
+			roots[i] = Mul5_MulMod(roots[i-1], w, prime);
 	}
 
 
 	/*!
-		return values:
-		-  0 - we've calculated the division
-		-  1 - division by zero
-		-  2 - we have to still calculate
+		an auxiliary method for calculating the NTT multiplication
+
+		the forward transform (decimation in frequency),
+		the input is in the natural order and the output is in the bit-reversed order
 	*/
-	uint Div2_FindLeadingBitsAndCheck(	const UInt<value_size> & divisor,
-										UInt<value_size> * remainder,
-										uint & table_id, uint & index,
-										uint & divisor_table_id, uint & divisor_index)
+	static void Mul5_Transform(uint * a, uint n, const uint * roots, const Mul5Prime & prime)
 	{
-		if( !divisor.FindLeadingBit(divisor_table_id, divisor_index) )
-		{
-			// division by zero
-			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
-			return 1;
-		}
+	uint half, step, start, j, u, v;
 
-		if(	!FindLeadingBit(table_id, index) )
+		for(half=n/2, step=1 ; half>=1 ; half/=2, step*=2)
 		{
-			// zero is divided by something
-			
-			SetZero();
-
-			if( remainder )
-				remainder->SetZero();
-
-			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+			for(start=0 ; start<n ; start += half*2)
+			{
+				for(j=0 ; j<half ; ++j)
+				{
+					u = a[start + j];
+					v = a[start + j + half];
 
-		return 0;
+					a[start + j]        = Mul5_AddMod(u, v, prime);
+					a[start + j + half] = Mul5_MulMod(Mul5_SubMod(u, v, prime), roots[j*step], prime);
+				}
+			}
 		}
-	
-		divisor_index += divisor_table_id * TTMATH_BITS_PER_UINT;
-		index         += table_id         * TTMATH_BITS_PER_UINT;
-
-		if( divisor_table_id == 0 )
-		{
-			// dividor has only one 32-bit word
-
-			uint r;
-			DivInt(divisor.table[0], &r);
+	}
 
-			if( remainder )
-			{
-				remainder->SetZero();
-				remainder->table[0] = r;
-			}
 
-			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+	/*!
+		an auxiliary method for calculating the NTT multiplication
 
-		return 0;
-		}
-	
+		the inverse transform (decimation in time) without dividing by n,
+		the input is in the bit-reversed order and the output is in the natural order
+	*/
+	static void Mul5_InverseTransform(uint * a, uint n, const uint * roots, const Mul5Prime & prime)
+	{
+	uint half, step, start, j, u, v;
 
-		if( Div2_DivisorGreaterOrEqual(	divisor, remainder,
-										table_id, index,
-										divisor_index) )
+		for(half=1, step=n/2 ; half<n ; half*=2, step/=2)
 		{
-			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
-			return 0;
-		}
-
-
-		TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+			for(start=0 ; start<n ; start += half*2)
+			{
+				for(j=0 ; j<half ; ++j)
+				{
+					u = a[start + j];
+					v = Mul5_MulMod(a[start + j + half], roots[j*step], prime);
 
-	return 2;
+					a[start + j]        = Mul5_AddMod(u, v, prime);
+					a[start + j + half] = Mul5_SubMod(u, v, prime);
+				}
+			}
+		}
 	}
 
 
 	/*!
-		return values:
-		-  true if divisor is equal or greater than 'this'
+		an auxiliary method for calculating the NTT multiplication
+
+		it calculates the convolution of ss1 and ss2 modulo the prime,
+		the coefficients (in the normal form, not Montgomery) are stored in 'conv' (n words),
+		'temp' is a buffer for n words, n is a power of two not smaller than ss1_size + ss2_size - 1
+
+		if ss1 and ss2 are the same vector (squaring) only one forward transform is calculated
 	*/
-	bool Div2_DivisorGreaterOrEqual(	const UInt<value_size> & divisor,
-										UInt<value_size> * remainder, 
-										uint table_id, uint index,
-										uint divisor_index  )
+	static void Mul5_Convolution(const uint * ss1, uint ss1_size, const uint * ss2, uint ss2_size,
+	                             uint n, const Mul5Prime & prime, uint * conv, uint * temp, uint * roots)
 	{
-		if( divisor_index > index )
-		{
-			// divisor is greater than this
+	uint i, n_inv;
 
-			if( remainder )
-				*remainder = *this;
+		// the values in the Montgomery form (a*R^2*R^(-1) = a*R)
+		for(i=0 ; i<ss1_size ; ++i)
+			conv[i] = Mul5_MulMod(ss1[i], prime.r2, prime);
 
-			SetZero();
+		for( ; i<n ; ++i)
+			conv[i] = 0;
 
-			TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+		Mul5_Roots(roots, n, false, prime);
+		Mul5_Transform(conv, n, roots, prime);
 
-		return true;
+		if( ss1 == ss2 && ss1_size == ss2_size )
+		{
+			for(i=0 ; i<n ; ++i)
+				conv[i] = Mul5_MulMod(conv[i], conv[i], prime);
 		}
-
-		if( divisor_index == index )
+		else
 		{
-			// table_id == divisor_table_id as well
-
-			uint i;
-			for(i = table_id ; i!=0 && table[i]==divisor.table[i] ; --i);
-			
-			if( table[i] < divisor.table[i] )
-			{
-				// divisor is greater than 'this'
+			for(i=0 ; i<ss2_size ; ++i)
+				temp[i] = Mul5_MulMod(ss2[i], prime.r2, prime);
 
-				if( remainder )
-					*remainder = *this;
+			for( ; i<n ; ++i)
+				temp[i] = 0;
 
-				SetZero();
+			Mul5_Transform(temp, n, roots, prime);
 
-				TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+			for(i=0 ; i<n ; ++i)
+				conv[i] = Mul5_MulMod(conv[i], temp[i], prime);
+		}
 
-			return true;
-			}
-			else
-			if( table[i] == divisor.table[i] )
-			{
-				// divisor is equal 'this'
+		Mul5_Roots(roots, n, true, prime);
+		Mul5_InverseTransform(conv, n, roots, prime);
 
-				if( remainder )
-					remainder->SetZero();
+		// n^(-1) in the normal form, multiplying by it we're also getting rid of the Montgomery form
+		n_inv = Mul5_MulMod(n % prime.p, prime.r2, prime);
+		n_inv = Mul5_PowMod(n_inv, prime.p - 2, prime);
+		n_inv = Mul5_MulMod(n_inv, 1, prime);
 
-				SetOne();
+		for(i=0 ; i<n ; ++i)
+			conv[i] = Mul5_MulMod(conv[i], n_inv, prime);
+	}
 
-				TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
 
-			return true;
-			}
-		}
+	/*!
+		an auxiliary method for calculating the NTT multiplication
 
-		TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+		result = ss1 * ss2
+		the result has ss1_size + ss2_size words
+	*/
+	static void Mul5Big3(const uint * ss1, uint ss1_size, const uint * ss2, uint ss2_size, uint * result)
+	{
+	Mul5Prime prime[3];
+	uint n, i, c0, c1, c2, c3, x0, x1, x2, r1, r2, r3, v2, v3, high, low, p12_high, p12_low;
+	uint inv_p1, p1_mod_p3, inv_p12;
 
-	return false;
-	}
+		uint conv_size = ss1_size + ss2_size - 1;
 
+		for(n=1 ; n < conv_size ; n <<= 1);
 
-public:
+		std::vector<uint> buffer(n * 5);
+		uint * conv  = &buffer[0];
+		uint * temp  = &buffer[n*3];
+		uint * roots = &buffer[n*4];
 
-	/*!
-		the third division algorithm
-	*/
-	uint Div3(const UInt<value_size> & ss2, UInt<value_size> * remainder = 0)
-	{
-		if( this == &ss2 )
+		for(i=0 ; i<3 ; ++i)
 		{
-			UInt<value_size> copy_ss2(ss2);
-			return Div3Ref(copy_ss2, remainder);
+			Mul5_SetPrime(i, prime[i]);
+			Mul5_Convolution(ss1, ss1_size, ss2, ss2_size, n, prime[i], conv + n*i, temp, roots);
 		}
-		else
+
+		// the constants for the Chinese Remainder Theorem (Garner's algorithm)
+		// inv_p1  = p1^(-1) mod p2         (Montgomery form)
+		// inv_p12 = (p1*p2)^(-1) mod p3    (Montgomery form)
+		// p1_mod_p3 = p1 mod p3            (Montgomery form)
+		inv_p1    = Mul5_MulMod(prime[0].p % prime[1].p, prime[1].r2, prime[1]);
+		inv_p1    = Mul5_PowMod(inv_p1, prime[1].p - 2, prime[1]);
+		p1_mod_p3 = Mul5_MulMod(prime[0].p % prime[2].p, prime[2].r2, prime[2]);
+		inv_p12   = Mul5_MulMod(p1_mod_p3, prime[1].p % prime[2].p, prime[2]);
+		inv_p12   = Mul5_MulMod(inv_p12, prime[2].r2, prime[2]);
+		inv_p12   = Mul5_PowMod(inv_p12, prime[2].p - 2, prime[2]);
+
+		MulTwoWords(prime[0].p, prime[1].p, &p12_high, &p12_low);
+
+		// c0..c3 is the carry (the sum of the higher words from previous coefficients)
+		c0 = c1 = c2 = c3 = 0;
+
+		for(i=0 ; i<conv_size ; ++i)
 		{
-			return Div3Ref(ss2, remainder);
+			r1 = conv[i];
+			r2 = conv[n + i];
+			r3 = conv[n*2 + i];
+
+			// x = r1 + p1*v2 + p1*p2*v3
+			v2 = Mul5_MulMod(Mul5_SubMod(r2, r1 % prime[1].p, prime[1]), inv_p1, prime[1]);
+			v3 = Mul5_SubMod(r3, r1 % prime[2].p, prime[2]);
+			v3 = Mul5_SubMod(v3, Mul5_MulMod(v2 % prime[2].p, p1_mod_p3, prime[2]), prime[2]);
+			v3 = Mul5_MulMod(v3, inv_p12, prime[2]);
+
+			MulTwoWords(prime[0].p, v2, &x1, &x0);
+			x0 += r1;
+			x1 += (x0 < r1) ? 1 : 0;
+
+			MulTwoWords(p12_low, v3, &high, &low);
+			x0 += low;
+			high += (x0 < low) ? 1 : 0;   // high is smaller than p3 so there is no overflow
+			x1 += high;
+			x2 = (x1 < high) ? 1 : 0;
+
+			MulTwoWords(p12_high, v3, &high, &low);
+			x1 += low;
+			x2 += high + ((x1 < low) ? 1 : 0);
+
+			// adding the carry
+			c0 += x0;
+			x1 += (c0 < x0) ? 1 : 0;
+			x2 += (x1 == 0 && c0 < x0) ? 1 : 0;
+			c1 += x1;
+			x2 += (c1 < x1) ? 1 : 0;
+			c2 += x2;
+			c3 += (c2 < x2) ? 1 : 0;
+
+			result[i] = c0;
+			c0 = c1;
+			c1 = c2;
+			c2 = c3;
+			c3 = 0;
 		}
+
+		result[conv_size] = c0;
+		TTMATH_ASSERT( c1 == 0 && c2 == 0 )
 	}
 
 
-	/*!
-		the third division algorithm
-	*/
-	uint Div3(const UInt<value_size> & ss2, UInt<value_size> & remainder)
-	{
-		return Div3(ss2, &remainder);
-	}
 
+public:
 
-private:
 
 	/*!
-		the third division algorithm
+		multiplication this = this * ss2
 
-		this algorithm is described in the following book:
-			"The art of computer programming 2" (4.3.1 page 272)
-			Donald E. Knuth 
-		!! give the description here (from the book)
+		This is the multiplication in radix 2^52 by using AVX-512 IFMA instructions
+		(vpmadd52luq and vpmadd52huq). The words of the values are converted to 52-bit limbs,
+		eight columns of the product are calculated at once in one AVX-512 register
+		and at the end the carries are propagated and the limbs are converted back to words.
+
+		It is available only on x86_64 (GCC and CLANG) and it is selected at runtime
+		if the processor supports AVX-512 IFMA extension (look at IsIfmaSupported()),
+		on other processors (or if the values are bigger than TTMATH_IFMA_MAX_SIZE words)
+		the multiplication is calculated by the MulFastestBig() algorithms.
 	*/
-	uint Div3Ref(const UInt<value_size> & v, UInt<value_size> * remainder = 0)
+	uint Mul6(const UInt<value_size> & ss2)
 	{
-	uint m,n, test;
+	UInt<value_size*2> result;
+	uint i, c = 0;
 
-		test = Div_StandardTest(v, m, n, remainder);
-		if( test < 2 )
-			return test;
+		Mul6Big(ss2, result);
 
-		if( n == 0 )
-		{
-			uint r;
-			DivInt( v.table[0], &r );
+		// copying result
+		for(i=0 ; i<value_size ; ++i)
+			table[i] = result.table[i];
 
-			if( remainder )
+		// testing carry
+		for( ; i<value_size*2 ; ++i)
+			if( result.table[i] != 0 )
 			{
-				remainder->SetZero();
-				remainder->table[0] = r;
+				c = 1;
+				break;
 			}
 
-			TTMATH_LOG("UInt::Div3")
+		TTMATH_LOGC("UInt::Mul6", c)
 
-		return 0;
-		}
+	return c;
+	}
 
 
-		// we can only use the third division algorithm when 
-		// the divisor is greater or equal 2^32 (has more than one 32-bit word)
-		++m;
-		++n;
-		m = m - n; 
-		Div3_Division(v, remainder, m, n);
 
-		TTMATH_LOG("UInt::Div3")
+	/*!
+		multiplication: result = this * ss2
 
-	return 0;
+		result is twice bigger than this and ss2,
+		this method never returns carry,
+		(multiplication in radix 2^52 by using AVX-512 IFMA instructions)
+	*/
+	void Mul6Big(const UInt<value_size> & ss2, UInt<value_size*2> & result)
+	{
+		Mul6Big2<value_size>(table, ss2.table, result.table);
+
+		TTMATH_LOG("UInt::Mul6Big")
 	}
 
 
@@ -2181,2002 +2386,5378 @@ private:
 private:
 
 
-	void Div3_Division(UInt<value_size> v, UInt<value_size> * remainder, uint m, uint n)
-	{
-	TTMATH_ASSERT( n>=2 && n<=value_size && m<=value_size && m+n<=value_size )
-
-	UInt<value_size+1> uu, vv;
-	UInt<value_size> q;
-	uint d, u_value_size, u0, u1, u2, v1, v0, j=m;	
-	
-		u_value_size = Div3_Normalize(v, n, d);
-
-		if( j+n == value_size )
-			u2 = u_value_size;
-		else
-			u2 = table[j+n];
+	/*!
+		an auxiliary method for calculating the IFMA multiplication
 
-		Div3_MakeBiggerV(v, vv);
+		result_size is equal ss_size*2
+	*/
+	template<uint ss_size>
+	void Mul6Big2(const uint * ss1, const uint * ss2, uint * result)
+	{
+	uint x1size, x2size, i;
 
-		for(uint i = j+1 ; i<value_size ; ++i)
-			q.table[i] = 0;
+		for(x1size=ss_size ; x1size>0 && ss1[x1size-1]==0 ; --x1size);
+		for(x2size=ss_size ; x2size>0 && ss2[x2size-1]==0 ; --x2size);
 
-		while( true )
+		if( x1size==0 || x2size==0 )
 		{
-			u1 = table[j+n-1];
-			u0 = table[j+n-2];
-			v1 = v.table[n-1];
-			v0 = v.table[n-2];
+			for(i=0 ; i<ss_size*2 ; ++i)
+				result[i] = 0;
 
-			uint qp = Div3_Calculate(u2,u1,u0, v1,v0);
+			return;
+		}
 
-			Div3_MakeNewU(uu, j, n, u2);
-			Div3_MultiplySubtract(uu, vv, qp);
-			Div3_CopyNewU(uu, j, n);
+	#ifdef TTMATH_IFMA
 
-			q.table[j] = qp;
+		if( x1size <= TTMATH_IFMA_MAX_SIZE && x2size <= TTMATH_IFMA_MAX_SIZE && IsIfmaSupported() )
+		{
+			// the buffer for the limbs (look at Mul6BufferSize()), for small values it is on the stack
+			const uint limbs = (ss_size <= TTMATH_IFMA_MAX_SIZE) ? (ss_size * TTMATH_BITS_PER_UINT + 51) / 52 : 1;
 
-			// the next loop
-			if( j-- == 0 )
-				break;
+			if( ss_size <= TTMATH_IFMA_MAX_SIZE )
+			{
+				uint buffer[limbs*4 + 32];
+				Mul6Big3(ss1, x1size, ss2, x2size, result, ss_size*2, buffer);
+			}
+			else
+			{
+				std::vector<uint> buffer( Mul6BufferSize(x1size, x2size) );
+				Mul6Big3(ss1, x1size, ss2, x2size, result, ss_size*2, &buffer[0]);
+			}
 
-			u2 = table[j+n];
+			return;
 		}
 
-		if( remainder )
-			Div3_Unnormalize(remainder, n, d);
-
-	*this = q;
+	#endif
 
-	TTMATH_LOG("UInt::Div3_Division")
+		MulFastestBig2<ss_size>(ss1, ss2, result, (x1size > x2size) ? x1size : x2size);
 	}
 
 
-	void Div3_MakeNewU(UInt<value_size+1> & uu, uint j, uint n, uint u_max)
-	{
-	uint i;
-
-		for(i=0 ; i<n ; ++i, ++j)
-			uu.table[i] = table[j];
+#ifdef TTMATH_IFMA
 
-		// 'n' is from <1..value_size> so and 'i' is from <0..value_size>
-		// then table[i] is always correct (look at the declaration of 'uu')
-		uu.table[i] = u_max;
+	/*!
+		an auxiliary method for calculating the IFMA multiplication
 
-		for( ++i ; i<value_size+1 ; ++i)
-			uu.table[i] = 0;
+		it returns how many words are needed for the buffer in Mul6Big3()
+	*/
+	static uint Mul6BufferSize(uint x1size, uint x2size)
+	{
+		uint limbs1 = (x1size * TTMATH_BITS_PER_UINT + 51) / 52;
+		uint limbs2 = (x2size * TTMATH_BITS_PER_UINT + 51) / 52;
 
-		TTMATH_LOG("UInt::Div3_MakeNewU")
+	return limbs1 + (limbs2 + 16) + (limbs1 + limbs2 + 16);
 	}
 
+#endif
 
-	void Div3_CopyNewU(const UInt<value_size+1> & uu, uint j, uint n)
-	{
-	uint i;
-
-		for(i=0 ; i<n ; ++i)
-			table[i+j] = uu.table[i];
 
-		if( i+j < value_size )
-			table[i+j] = uu.table[i];
 
-		TTMATH_LOG("UInt::Div3_CopyNewU")
-	}
+public:
 
 
 	/*!
-		we're making the new 'vv' 
-		the value is actually the same but the 'table' is bigger (value_size+1)
+		multiplication this = this * ss2
 	*/
-	void Div3_MakeBiggerV(const UInt<value_size> & v, UInt<value_size+1> & vv)
+	uint MulFastest(const UInt<value_size> & ss2)
 	{
-		for(uint i=0 ; i<value_size ; ++i)
-			vv.table[i] = v.table[i];
-
-		vv.table[value_size] = 0;
+	UInt<value_size*2> result;
+	uint i, c = 0;
 
-		TTMATH_LOG("UInt::Div3_MakeBiggerV")
-	}
+		MulFastestBig(ss2, result);
 	
+		// copying result
+		for(i=0 ; i<value_size ; ++i)
+			table[i] = result.table[i];
 
-	/*!
-		we're moving all bits from 'v' into the left side of the n-1 word
-		(the highest bit at v.table[n-1] will be equal one,
-		the bits from 'this' we're moving the same times as 'v')
-
-		return values:
-		-  d - how many times we've moved
-		-  return - the next-left value from 'this' (that after table[value_size-1])
-	*/
-	uint Div3_Normalize(UInt<value_size> & v, uint n, uint & d)
-	{
-		// v.table[n-1] is != 0
-
-		uint bit  = (uint)FindLeadingBitInWord(v.table[n-1]);
-		uint move = (TTMATH_BITS_PER_UINT - bit - 1);
-		uint res  = table[value_size-1];
-		d         = move;
-
-		if( move > 0 )
-		{
-			v.Rcl(move, 0);
-			Rcl(move, 0);
-			res = res >> (bit + 1);
-		}
-		else
-		{
-			res = 0;
-		}
-
-		TTMATH_LOG("UInt::Div3_Normalize")
-
-	return res;
-	}
-
-
-	void Div3_Unnormalize(UInt<value_size> * remainder, uint n, uint d)
-	{
-		for(uint i=n ; i<value_size ; ++i)
-			table[i] = 0;
-
-		Rcr(d,0);
+		// testing carry
+		for( ; i<value_size*2 ; ++i)
+			if( result.table[i] != 0 )
+			{
+				c = 1;
+				break;
+			}
 
-		*remainder = *this;
+		TTMATH_LOGC("UInt::MulFastest", c)
 
-		TTMATH_LOG("UInt::Div3_Unnormalize")
+	return c;
 	}
 
 
-	uint Div3_Calculate(uint u2, uint u1, uint u0, uint v1, uint v0)
-	{	
-	UInt<2> u_temp;
-	uint rp;
-	bool next_test;
-
-		TTMATH_ASSERT( v1 != 0 )
-
-		u_temp.table[1] = u2;
-		u_temp.table[0] = u1;
-		u_temp.DivInt(v1, &rp);
-
-		TTMATH_ASSERT( u_temp.table[1]==0 || u_temp.table[1]==1 )
+	/*!
+		multiplication result = this * ss2
 
-		do
+		this method is trying to select the fastest algorithm
+		(in the future this method can be improved)
+	*/
+	void MulFastestBig(const UInt<value_size> & ss2, UInt<value_size*2> & result)
+	{
+		if( value_size < TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
 		{
-			bool decrease = false;
-
-			if( u_temp.table[1] == 1 )
-				decrease = true;
-			else
-			{
-				UInt<2> temp1, temp2;
+			Mul2Big(ss2, result);
+			return;
+		}
 
-				UInt<2>::MulTwoWords(u_temp.table[0], v0, temp1.table+1, temp1.table);
-				temp2.table[1] = rp;
-				temp2.table[0] = u0;
+		uint x1size  = value_size, x2size  = value_size;
+		uint x1start = 0,          x2start = 0;
 
-				if( temp1 > temp2 )
-					decrease = true;
-			}
+		for(x1size=value_size ; x1size>0 && table[x1size-1]==0 ; --x1size);
+		for(x2size=value_size ; x2size>0 && ss2.table[x2size-1]==0 ; --x2size);
 
-			next_test = false;
+		if( x1size==0 || x2size==0 )
+		{
+			// either 'this' or 'ss2' is equal zero - the result is zero too
+			result.SetZero();
+			return;
+		}
 
-			if( decrease )
-			{
-				u_temp.SubOne();
+		for(x1start=0 ; x1start<x1size && table[x1start]==0 ; ++x1start);
+		for(x2start=0 ; x2start<x2size && ss2.table[x2start]==0 ; ++x2start);
 
-				rp += v1;
+		uint distancex1 = x1size - x1start;
+		uint distancex2 = x2size - x2start;
 
-				if( rp >= v1 ) // it means that there wasn't a carry (r<b from the book)
-					next_test = true;
-			}
+		if( distancex1 < 3 || distancex2 < 3 )
+		{
+			// either 'this' or 'ss2' have only 2 (or 1) items different from zero (side by side)
+			// (this condition in the future can be improved)
+			Mul2Big3<value_size>(table, ss2.table, result.table, x1start, x1size, x2start, x2size);
+			return;
 		}
-		while( next_test );
 
-		TTMATH_LOG("UInt::Div3_Calculate")
+		// Karatsuba or Toom-3 multiplication
+		// (selected by the real size of the values, not by value_size)
+		MulFastestBig2<value_size>(table, ss2.table, result.table, (x1size > x2size) ? x1size : x2size);
 
-	return u_temp.table[0];
+		TTMATH_LOG("UInt::MulFastestBig")
 	}
 
 
+private:
 
-	void Div3_MultiplySubtract(	UInt<value_size+1> & uu,
-								const UInt<value_size+1> & vv, uint & qp)
-	{
-		// D4 (in the book)
+	/*!
+		an auxiliary method for calculating the multiplication
 
-		UInt<value_size+1> vv_temp(vv);
-		vv_temp.MulInt(qp);
+		only the first 'size' words from ss1 and ss2 can be different from zero,
+		if they fit in the lower half of the vectors we're multiplying only the lower halves
+		(recursively), and then we're selecting the algorithm by the size of the vectors
 
-		if( uu.Sub(vv_temp) )  
+		result_size is equal ss_size*2
+	*/
+	template<uint ss_size>
+	void MulFastestBig2(const uint * ss1, const uint * ss2, uint * result, uint size)
+	{
+		if( size <= ss_size/2 && ss_size/2 >= TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
 		{
-			// there was a carry
-			
-			//
-			// !!! this part of code was not tested
-			//
+			MulFastestBig2<ss_size/2>(ss1, ss2, result, size);
 
-			--qp;
-			uu.Add(vv);
+			for(uint i=(ss_size/2)*2 ; i<ss_size*2 ; ++i)
+				result[i] = 0;
 
-			// can be a carry from this additions but it should be ignored 
-			// because it cancels with the borrow from uu.Sub(vv_temp)
+			return;
 		}
 
-		TTMATH_LOG("UInt::Div3_MultiplySubtract")
-	}
-
+	#ifdef TTMATH_IFMA
 
+		if( ss_size >= TTMATH_USE_IFMA_MULTIPLICATION_FROM_SIZE && size <= TTMATH_IFMA_MAX_SIZE && IsIfmaSupported() )
+		{
+			Mul6Big2<ss_size>(ss1, ss2, result);
+			return;
+		}
 
+	#endif
 
+		if( ss_size >= TTMATH_USE_NTT_MULTIPLICATION_FROM_SIZE )
+			Mul5Big2<ss_size>(ss1, ss2, result);
+		else
+		if( ss_size >= TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE )
+			Mul4Big2<ss_size>(ss1, ss2, result);
+		else
+			Mul3Big2<ss_size>(ss1, ss2, result);
+	}
 
 
 public:
 
 
 	/*!
-		power this = this ^ pow
-		binary algorithm (r-to-l)
+	 *
+	 * Squaring
+	 *
+	 *
+	*/
 
-		return values:
-		-  0 - ok
-		-  1 - carry
-		-  2 - incorrect argument (0^0)
+
+	/*!
+		squaring: this = this * this
+
+		it returns carry if it has been
+
+		it is faster than Mul(*this) because the products x[i]*x[j] and x[j]*x[i]
+		are equal and we're calculating them only once (at each level of the recursion
+		in Karatsuba, Toom-3 and NTT algorithms only squares are calculated too)
 	*/
-	uint Pow(UInt<value_size> pow)
+	uint Sqr()
 	{
-		if(pow.IsZero() && IsZero())
-			// we don't define zero^zero
-			return 2;
+	UInt<value_size*2> result;
+	uint i, c = 0;
 
-		UInt<value_size> start(*this);
-		UInt<value_size> result;
-		result.SetOne();
-		uint c = 0;
+		SqrBig(result);
 
-		while( !c )
-		{
-			if( pow.table[0] & 1 )
-				c += result.Mul(start);
+		// copying result
+		for(i=0 ; i<value_size ; ++i)
+			table[i] = result.table[i];
 
-			pow.Rcr2_one(0);
-			if( pow.IsZero() )
+		// testing carry
+		for( ; i<value_size*2 ; ++i)
+			if( result.table[i] != 0 )
+			{
+				c = 1;
 				break;
+			}
 
-			c += start.Mul(start);
-		}
-
-		*this = result;
-
-		TTMATH_LOGC("UInt::Pow(UInt<>)", c)
+		TTMATH_LOGC("UInt::Sqr", c)
 
-	return (c==0)? 0 : 1;
+	return c;
 	}
 
 
 	/*!
-		square root
-		e.g. Sqrt(9) = 3
-		('digit-by-digit' algorithm)
+		squaring: result = this * this
+
+		result is twice bigger than 'this',
+		this method never returns carry
+		(the algorithm is selected by the size of the value in the same way as in MulFastestBig())
 	*/
-	void Sqrt()
+	void SqrBig(UInt<value_size*2> & result)
 	{
-	UInt<value_size> bit, temp;
-
-		if( IsZero() )
-			return;
-
-		UInt<value_size> value(*this);
+	uint size;
 
-		SetZero();
-		bit.SetZero();
-		bit.table[value_size-1] = (TTMATH_UINT_HIGHEST_BIT >> 1);
-		
-		while( bit > value )
-			bit.Rcr(2);
+		for(size=value_size ; size>0 && table[size-1]==0 ; --size);
 
-		while( !bit.IsZero() )
+		if( size == 0 )
 		{
-			temp = *this;
-			temp.Add(bit);
-
-			if( value >= temp )
-			{
-				value.Sub(temp);
-				Rcr(1);
-				Add(bit);
-			}
-			else
-			{
-				Rcr(1);
-			}
+			result.SetZero();
+			TTMATH_LOG("UInt::SqrBig")
 
-			bit.Rcr(2);
+		return;
 		}
 
-		TTMATH_LOG("UInt::Sqrt")
+		SqrFastestBig2<value_size>(table, result.table, size);
+
+		TTMATH_LOG("UInt::SqrBig")
 	}
 
 
 
+private:
+
 
 	/*!
-		this method sets n first bits to value zero
+		an auxiliary method for calculating the squaring
 
-		For example:
-		let n=2 then if there's a value 111 (bin) there'll be '100' (bin)
+		only the first 'size' words from ss can be different from zero,
+		this is the same ladder as in MulFastestBig2()
+
+		result_size is equal ss_size*2
 	*/
-	void ClearFirstBits(uint n)
+	template<uint ss_size>
+	void SqrFastestBig2(const uint * ss, uint * result, uint size)
 	{
-		if( n >= value_size*TTMATH_BITS_PER_UINT )
+		if( size <= ss_size/2 && ss_size/2 >= TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
 		{
-			SetZero();
-			TTMATH_LOG("UInt::ClearFirstBits")
-			return;
-		}
+			SqrFastestBig2<ss_size/2>(ss, result, size);
 
-		uint * p = table;
+			for(uint i=(ss_size/2)*2 ; i<ss_size*2 ; ++i)
+				result[i] = 0;
 
-		// first we're clearing the whole words
-		while( n >= TTMATH_BITS_PER_UINT )
-		{
-			*p++ = 0;
-			n   -= TTMATH_BITS_PER_UINT;
+			return;
 		}
 
-		if( n == 0 )
+	#ifdef TTMATH_IFMA
+
+		// the IFMA multiplication calculates all the products so it is used
+		// for bigger values than in MulFastestBig2()
+		if( ss_size >= TTMATH_USE_IFMA_MULTIPLICATION_FROM_SIZE*2 && size <= TTMATH_IFMA_MAX_SIZE && IsIfmaSupported() )
 		{
-			TTMATH_LOG("UInt::ClearFirstBits")
+			Mul6Big2<ss_size>(ss, ss, result);
 			return;
 		}
 
-		// and then we're clearing one word which has left
-		// mask -- all bits are set to one
-		uint mask = TTMATH_UINT_MAX_VALUE;
+	#endif
 
-		mask = mask << n;
+		if( ss_size >= TTMATH_USE_NTT_MULTIPLICATION_FROM_SIZE )
+			Mul5Big2<ss_size>(ss, ss, result); // only one forward transform is calculated for the same vectors
+		else
+		if( ss_size >= TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE )
+			Sqr4Big2<ss_size>(ss, result);
+		else
+			Sqr3Big2<ss_size>(ss, result);
+	}
 
-		(*p) &= mask;
 
-		TTMATH_LOG("UInt::ClearFirstBits")
-	}
+#ifdef _MSC_VER
+#pragma warning (disable : 4717)
+//warning C4717: recursive on all control paths, function will cause runtime stack overflow
+//we have the stop point in Sqr3Big2() and Sqr4Big2() methods
+#endif
+
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-but-set-variable"
+#endif
 
 
 	/*!
-		this method returns true if the highest bit of the value is set
-	*/
-	bool IsTheHighestBitSet() const
-	{
-		return (table[value_size-1] & TTMATH_UINT_HIGHEST_BIT) != 0;
-	}
+		an auxiliary method for calculating the squaring (the schoolbook algorithm)
 
+		firstly we're calculating the sum of the products ss[i]*ss[j] where i<j
+		(each row is added in one pass by MulAddVector()) and then this sum
+		is doubled and the squares ss[i]*ss[i] are added in SqrAddDiagonal()
 
-	/*!
-		this method returns true if the lowest bit of the value is set
+		result_size is equal ss_size*2
 	*/
-	bool IsTheLowestBitSet() const
+	template<uint ss_size>
+	static void Sqr2Big2(const uint * ss, uint * result)
 	{
-		return (*table & 1) != 0;
-	}
+	uint size, i, c;
 
+		for(size=ss_size ; size>0 && ss[size-1]==0 ; --size);
 
-	/*!
-		returning true if only the highest bit is set
-	*/
-	bool IsOnlyTheHighestBitSet() const
-	{
 #ifdef __clang__
 #pragma clang diagnostic push
 #pragma clang diagnostic ignored "-Wtautological-compare"
 #endif
 
-		for(uint i=0 ; i<value_size-1 ; ++i)
-			if( table[i] != 0 )
-				return false;
+		for(i=0 ; i<ss_size*2 ; ++i)
+			result[i] = 0;
 
 #ifdef __clang__
 #pragma clang diagnostic pop
 #endif
-		if( table[value_size-1] != TTMATH_UINT_HIGHEST_BIT )
-			return false;
 
-	return true;
+		if( size == 0 )
+			return;
+
+		for(i=0 ; i+1<size ; ++i)
+			result[i+size] = MulAddVector(ss+i+1, size-i-1, ss[i], result+i*2+1);
+
+		c = SqrAddDiagonal(ss, size, result);
+		TTMATH_ASSERT( c==0 )
 	}
 
 
 	/*!
-		returning true if only the lowest bit is set
+		an auxiliary method for calculating the Karatsuba squaring
+
+		result_size is equal ss_size*2
 	*/
-	bool IsOnlyTheLowestBitSet() const
+	template<uint ss_size>
+	void Sqr3Big2(const uint * ss, uint * result)
 	{
-		if( table[0] != 1 )
-			return false;
-
-		for(uint i=1 ; i<value_size ; ++i)
-			if( table[i] != 0 )
-				return false;
+		if( ss_size < 2 || ss_size < TTMATH_USE_KARATSUBA_SQUARING_FROM_SIZE )
+		{
+			Sqr2Big2<ss_size>(ss, result);
+			return;
+		}
 
-	return true;
+		if( (ss_size & 1) == 1 )
+		{
+			// ss_size is odd, x1 is smaller about one from x0
+			Sqr3Big3<ss_size/2 + 1, ss_size/2, ss_size*2>(ss + ss_size/2 + 1, ss, result);
+		}
+		else
+		{
+			// ss_size is even
+			Sqr3Big3<ss_size/2, ss_size/2, ss_size*2>(ss + ss_size/2, ss, result);
+		}
 	}
 
 
+
 	/*!
-		this method returns true if the value is equal zero
-	*/
-	bool IsZero() const
-	{
-		for(uint i=0 ; i<value_size ; ++i)
-			if(table[i] != 0)
-				return false;
+		an auxiliary method for calculating the Karatsuba squaring
 
-	return true;
-	}
+			x = x1*B^m + x0
 
+			first_size  - is the size of x0
+			second_size - is the size of x1 (can be either equal first_size or smaller about one from first_size)
 
-	/*!
-		returning true if first 'bits' bits are equal zero
+			x*x = z2*B^(2m) + z1*B^m + z0
+		      where
+			   z0 = x0*x0
+			   z2 = x1*x1
+			   z1 = (x1 + x0)*(x1 + x0) - z2 - z0
+
+		the sum (x1 + x0) we keep in UInt<first_size> and the carry in xc, then
+			(xc*B^m + temp)^2 = temp^2 + 2*xc*temp*B^m + xc*B^(2m)
 	*/
-	bool AreFirstBitsZero(uint bits) const
+	template<uint first_size, uint second_size, uint result_size>
+	void Sqr3Big3(const uint * x1, const uint * x0, uint * result)
 	{
-		TTMATH_ASSERT( bits <= value_size * TTMATH_BITS_PER_UINT )
+	uint i, c, xc;
 
-		uint index = bits / TTMATH_BITS_PER_UINT;
-		uint rest  = bits % TTMATH_BITS_PER_UINT;
-		uint i;
+		UInt<first_size>   temp;
+		UInt<first_size*3> z1;
 
-		for(i=0 ; i<index ; ++i)
-			if(table[i] != 0 )
-				return false;
+		// z0 and z2 we store directly in the result
+		Sqr3Big2<first_size>(x0, result);                  // z0
+		Sqr3Big2<second_size>(x1, result+first_size*2);    // z2
 
-		if( rest == 0 )
-			return true;
+		xc = AddVector(x0, x1, first_size, second_size, temp.table);
+		Sqr3Big2<first_size>(temp.table, z1.table);
 
-		uint mask = TTMATH_UINT_MAX_VALUE >> (TTMATH_BITS_PER_UINT - rest);
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wtautological-compare"
+#endif
 
-	return (table[i] & mask) == 0;
-	}
+		// clearing the rest of z1
+		for(i=first_size*2 ; i<first_size*3 ; ++i)
+			z1.table[i] = 0;
 
+		if( xc )
+		{
+			c  = AddVector(z1.table+first_size, temp.table, first_size*2, first_size, z1.table+first_size);
+			c += AddVector(z1.table+first_size, temp.table, first_size*2, first_size, z1.table+first_size);
+			TTMATH_ASSERT( c==0 )
 
+			for( i=first_size*2 ; i<first_size*3 ; ++i )
+				if( ++z1.table[i] != 0 )
+					break;  // break if there was no carry
+		}
 
-	/*!
-	*
-	*	conversion methods
-	*
-	*/
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
 
+		// z1 = z1 - z2 - z0
+		c  = SubVector(z1.table, result+first_size*2, first_size*3, second_size*2, z1.table);
+		c += SubVector(z1.table, result, first_size*3, first_size*2, z1.table);
+		TTMATH_ASSERT( c==0 )
 
+		// the higher words of z1 are zero if first_size > second_size
+		// (z1 is smaller than 2*x0*x1)
+		c = AddVector(result+first_size, z1.table, result_size-first_size,
+		              (first_size*3 < result_size-first_size) ? first_size*3 : result_size-first_size, result+first_size);
+		TTMATH_ASSERT( c==0 )
+	}
 
-	/*!
-		this method converts an UInt<another_size> type to this class
 
-		this operation has mainly sense if the value from p is 
-		equal or smaller than that one which is returned from UInt<value_size>::SetMax()
+	/*!
+		an auxiliary method for calculating the Toom-3 squaring
 
-		it returns a carry if the value 'p' is too big
+		result_size is equal ss_size*2
 	*/
-	template<uint argument_size>
-	uint FromUInt(const UInt<argument_size> & p)
+	template<uint ss_size>
+	void Sqr4Big2(const uint * ss, uint * result)
 	{
-		uint min_size = (value_size < argument_size)? value_size : argument_size;
-		uint i;
-
-		for(i=0 ; i<min_size ; ++i)
-			table[i] = p.table[i];
-
-
-		if( value_size > argument_size )
-		{	
-			// 'this' is longer than 'p'
-
-			for( ; i<value_size ; ++i)
-				table[i] = 0;
-		}
-		else
+		if( ss_size < 5 || ss_size < TTMATH_USE_TOOM3_MULTIPLICATION_FROM_SIZE )
 		{
-			for( ; i<argument_size ; ++i)
-				if( p.table[i] != 0 )
-				{
-					TTMATH_LOGC("UInt::FromUInt(UInt<>)", 1)
-					return 1;
-				}
+			Sqr3Big2<ss_size>(ss, result);
+			return;
 		}
 
-		TTMATH_LOGC("UInt::FromUInt(UInt<>)", 0)
+		const uint first_size  = (ss_size + 2) / 3;
+		const uint second_size = (ss_size > first_size*2) ? ss_size - first_size*2 : 1;
 
-	return 0;
+		Sqr4Big3<first_size, second_size, ss_size*2>(ss, result);
 	}
 
 
 	/*!
-		this method converts an UInt<another_size> type to this class
+		an auxiliary method for calculating the Toom-3 squaring
 
-		this operation has mainly sense if the value from p is 
-		equal or smaller than that one which is returned from UInt<value_size>::SetMax()
+			x = x2*B^(2m) + x1*B^m + x0
 
-		it returns a carry if the value 'p' is too big
+		this is the same algorithm as in Mul4Big3() but the values in the points
+		are squared (and r(-1) is never negative)
 	*/
-	template<uint argument_size>
-	uint FromInt(const UInt<argument_size> & p)
+	template<uint first_size, uint second_size, uint result_size>
+	void Sqr4Big3(const uint * ss, uint * result)
 	{
-		return FromUInt(p);
-	}
+	const uint * x0 = ss, * x1 = ss + first_size, * x2 = ss + first_size*2;
+	UInt<first_size+1>   p, pm;
+	UInt<first_size*2+2> r1, rm1, r2;
+	uint i;
 
+		// r(0) and r(inf) we store directly in the result
+		Sqr4Big2<first_size>(x0, result);
+		Sqr4Big2<second_size>(x2, result+first_size*4);
 
-	/*!
-		this method converts the uint type to this class
-	*/
-	uint FromUInt(uint value)
-	{
-		for(uint i=1 ; i<value_size ; ++i)
-			table[i] = 0;
+		for(i=first_size*2 ; i<first_size*4 ; ++i)
+			result[i] = 0;
 
-		table[0] = value;
+		// r(1) and r(-1)
+		Mul4Big_EvaluateOneAndMinusOne<first_size, second_size>(x0, x1, x2, p, pm);
+		Sqr4Big_SqrValue<first_size>(p, r1);
+		Sqr4Big_SqrValue<first_size>(pm, rm1);
 
-		TTMATH_LOG("UInt::FromUInt(uint)")
+		// r(2)
+		Mul4Big_EvaluateTwo<first_size, second_size>(x0, x1, x2, p);
+		Sqr4Big_SqrValue<first_size>(p, r2);
 
-		// there'll never be a carry here
-	return 0;
+		Mul4Big_Interpolate<first_size, second_size, result_size>(r1, rm1, false, r2, result);
 	}
 
 
 	/*!
-		this method converts the uint type to this class
-	*/
-	uint FromInt(uint value)
-	{
-		return FromUInt(value);
-	}
-
+		an auxiliary method for calculating the Toom-3 squaring
 
-	/*!
-		this method converts the sint type to this class
+		it squares the value from a point: result = p * p
+		the highest word of p is small (smaller than 7) so we're squaring only
+		the lower first_size words and adding 2*p_hi*p_lo*B^m + p_hi*p_hi*B^(2m)
 	*/
-	uint FromInt(sint value)
+	template<uint first_size>
+	void Sqr4Big_SqrValue(const UInt<first_size+1> & p, UInt<first_size*2+2> & result)
 	{
-		uint c = FromUInt(uint(value));
-
-		if( c || value < 0 )
-			return 1;
-
-	return 0;
-	}
-
+	uint p_hi = p.table[first_size];
+	uint c = 0;
 
-	/*!
-		this operator converts an UInt<another_size> type to this class
+		Sqr4Big2<first_size>(p.table, result.table);
 
-		it doesn't return a carry
-	*/
-	template<uint argument_size>
-	UInt<value_size> & operator=(const UInt<argument_size> & p)
-	{
-		FromUInt(p);
+		// c is small (smaller than 14)
+		if( p_hi )
+			c = MulAddVector(p.table, first_size, p_hi * 2, result.table + first_size);
 
-	return *this;
+		result.table[first_size*2]   = c + p_hi * p_hi;
+		result.table[first_size*2+1] = 0;
 	}
 
 
-	/*!
-		the assignment operator
-	*/
-	UInt<value_size> & operator=(const UInt<value_size> & p)
-	{
-		for(uint i=0 ; i<value_size ; ++i)
-			table[i] = p.table[i];
-
-		TTMATH_LOG("UInt::operator=(UInt<>)")
+#if defined(__GNUC__) && !defined(__clang__)
+#pragma GCC diagnostic pop
+#endif
 
-		return *this;
-	}
+#ifdef _MSC_VER
+#pragma warning (default : 4717)
+#endif
 
 
-	/*!
-		this method converts the uint type to this class
-	*/
-	UInt<value_size> & operator=(uint i)
-	{
-		FromUInt(i);
 
-	return *this;
-	}
+public:
 
 
 	/*!
-		a constructor for converting the uint to this class
+	 *
+	 * Division
+	 *
+	 *
 	*/
-	UInt(uint i)
-	{
-		FromUInt(i);
-	}
+	
+public:
 
 
 	/*!
-		this method converts the sint type to this class
+		division by one unsigned word
+
+		returns 1 when divisor is zero
 	*/
-	UInt<value_size> & operator=(sint i)
+	uint DivInt(uint divisor, uint * remainder = 0)
 	{
-		FromInt(i);
-
-	return *this;
-	}
+		if( divisor == 0 )
+		{
+			if( remainder )
+				*remainder = 0; // this is for convenience, without it the compiler can report that 'remainder' is uninitialized
 
+			TTMATH_LOG("UInt::DivInt")
 
-	/*!
-		a constructor for converting the sint to this class
+		return 1;
+		}
 
-		look at the description of UInt::operator=(sint)
-	*/
-	UInt(sint i)
-	{
-		FromInt(i);
-	}
+		if( divisor == 1 )
+		{
+			if( remainder )
+				*remainder = 0;
 
+			TTMATH_LOG("UInt::DivInt")
 
-#ifdef TTMATH_PLATFORM32
+		return 0;
+		}
 
+		sint i;  // i must be with a sign
+		uint r = 0;
 
-	/*!
-		this method converts unsigned 64 bit int type to this class
-		***this method is created only on a 32bit platform***
-	*/
-	uint FromUInt(ulint n)
-	{
-		table[0] = (uint)n;
+		// we're looking for the last word in ss1
+		for(i=value_size-1 ; i>0 && table[i]==0 ; --i);
 
-		if( value_size == 1 )
+		if( i < 8 )
 		{
-			uint c = ((n >> TTMATH_BITS_PER_UINT) == 0) ? 0 : 1;
-
-			TTMATH_LOGC("UInt::FromUInt(ulint)", c)
-			return c;
+			// for short dividends calculating the reciprocal costs more than it saves
+			for( ; i>=0 ; --i)
+				DivTwoWords(r, table[i], divisor, &table[i], &r);
 		}
+		else
+		{
+			// the reciprocal is calculated once and then each word is divided
+			// only by multiplications (Div_TwoWordsByReciprocal())
+			uint bits = TTMATH_BITS_PER_UINT - 1 - (uint)FindLeadingBitInWord(divisor);
+			uint d    = divisor << bits;
 
-		table[1] = (uint)(n >> TTMATH_BITS_PER_UINT);
+			r = DivInt_Reciprocal(d, Div_WordReciprocal(d), bits);
+		}
 
-		for(uint i=2 ; i<value_size ; ++i)
-			table[i] = 0;
+		if( remainder )
+			*remainder = r;
 
-		TTMATH_LOG("UInt::FromUInt(ulint)")
+		TTMATH_LOG("UInt::DivInt")
 
 	return 0;
 	}
 
-
-	/*!
-		this method converts unsigned 64 bit int type to this class
-		***this method is created only on a 32bit platform***
-	*/
-	uint FromInt(ulint n)
+	uint DivInt(uint divisor, uint & remainder)
 	{
-		return FromUInt(n);
+		return DivInt(divisor, &remainder);
 	}
 
 
+private:
+
 	/*!
-		this method converts signed 64 bit int type to this class
+		division by one word: this = this / divisor, the method returns the remainder
+
+		d - the divisor shifted left by 'bits' (the highest bit is set)
+		v - the reciprocal of d (from Div_WordReciprocal())
+
+		the dividend is shifted on the fly so the same d and v can be used
+		for many divisions by the same word (e.g. in ToStringBase())
+
+		size - the words from table[size] are known to be zero (they are not checked)
+	*/
+	uint DivInt_Reciprocal(uint d, uint v, uint bits, uint size = value_size)
+	{
+	uint r = 0, u0, i;
+
+		for(i=size ; i>0 && table[i-1]==0 ; --i);
+
+		if( bits == 0 )
+		{
+			while( i-- > 0 )
+				table[i] = Div_TwoWordsByReciprocal(r, table[i], d, v, &r);
+		}
+		else
+		if( i > 0 )
+		{
+			// the bits shifted out from the highest word are smaller than d
+			r = table[i-1] >> (TTMATH_BITS_PER_UINT - bits);
+
+			while( --i > 0 )
+			{
+				u0       = (table[i] << bits) | (table[i-1] >> (TTMATH_BITS_PER_UINT - bits));
+				table[i] = Div_TwoWordsByReciprocal(r, u0, d, v, &r);
+			}
+
+			table[0] = Div_TwoWordsByReciprocal(r, table[0] << bits, d, v, &r);
+			r >>= bits;
+		}
+
+		TTMATH_LOG("UInt::DivInt_Reciprocal")
+
+	return r;
+	}
+
+
+public:
+
+
+
+	/*!
+		division this = this / ss2
+		
+		return values:
+		-  0 - ok
+		-  1 - division by zero
+		-  'this' will be the quotient
+		-  'remainder' - remainder
+
+		algorithm 100 - selecting the algorithm automatically: Div4() (Burnikel-Ziegler)
+		when the divisor and the quotient have at least TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE
+		words, Div3() otherwise
+	*/
+	uint Div(	const UInt<value_size> & divisor,
+				UInt<value_size> * remainder = 0,
+				uint algorithm = 100)
+	{
+		switch( algorithm )
+		{
+		case 1:
+			return Div1(divisor, remainder);
+
+		case 2:
+			return Div2(divisor, remainder);
+
+		case 3:
+			return Div3(divisor, remainder);
+
+		case 4:
+			return Div4(divisor, remainder);
+
+		case 5:
+			return Div5(divisor, remainder);
+
+		case 100:
+		default:
+			if( Div_UseBurnikelZiegler(divisor) )
+				return Div4(divisor, remainder);
+
+			return Div3(divisor, remainder);
+		}
+	}
+
+	uint Div(const UInt<value_size> & divisor, UInt<value_size> & remainder, uint algorithm = 100)
+	{
+		return Div(divisor, &remainder, algorithm);
+	}
+
+
+
+private:
+
+	/*!
+		return values:
+		-  0 - none has to be done
+		-  1 - division by zero
+		-  2 - division should be made
+	*/
+	uint Div_StandardTest(	const UInt<value_size> & v,
+							uint & m, uint & n,
+							UInt<value_size> * remainder = 0)
+	{
+		switch( Div_CalculatingSize(v, m, n) )
+		{
+		case 4: // 'this' is equal v
+			if( remainder )
+				remainder->SetZero();
+
+			SetOne();
+			TTMATH_LOG("UInt::Div_StandardTest")
+			return 0;
+
+		case 3: // 'this' is smaller than v
+			if( remainder )
+				*remainder = *this;
+
+			SetZero();
+			TTMATH_LOG("UInt::Div_StandardTest")
+			return 0;
+
+		case 2: // 'this' is zero
+			if( remainder )
+				remainder->SetZero();
+
+			SetZero();
+			TTMATH_LOG("UInt::Div_StandardTest")
+			return 0;
+
+		case 1: // v is zero
+			TTMATH_LOG("UInt::Div_StandardTest")
+			return 1;
+		}
+
+		TTMATH_LOG("UInt::Div_StandardTest")
+
+	return 2;
+	}
+
+
+
+	/*!
+		return values:
+		-  0 - ok
+			-  'm' - is the index (from 0) of last non-zero word in table ('this')
+			-  'n' - is the index (from 0) of last non-zero word in v.table
+		-  1 - v is zero
+		-  2 - 'this' is zero
+		-  3 - 'this' is smaller than v
+		-  4 - 'this' is equal v
+
+		if the return value is different than zero the 'm' and 'n' are undefined
+	*/
+	uint Div_CalculatingSize(const UInt<value_size> & v, uint & m, uint & n)
+	{
+		m = n = value_size-1;
+
+		for( ; n!=0 && v.table[n]==0 ; --n);
+
+		if( n==0 && v.table[n]==0 )
+			return 1;
+
+		for( ; m!=0 && table[m]==0 ; --m);
+
+		if( m==0 && table[m]==0 )
+			return 2;
+
+		if( m < n )
+			return 3;
+		else
+		if( m == n )
+		{
+			uint i;
+			for(i = n ; i!=0 && table[i]==v.table[i] ; --i);
+			
+			if( table[i] < v.table[i] )
+				return 3;
+			else
+			if (table[i] == v.table[i] )
+				return 4;
+		}
+
+	return 0;
+	}
+
+
+public:
+
+	/*!
+		the first division algorithm
+		(radix 2)
+	*/
+	uint Div1(const UInt<value_size> & divisor, UInt<value_size> * remainder = 0)
+	{
+	uint m,n, test;
+
+		test = Div_StandardTest(divisor, m, n, remainder);
+		if( test < 2 )
+			return test;
+
+		if( !remainder )
+		{
+			UInt<value_size> rem;
+	
+		return Div1_Calculate(divisor, rem);
+		}
+
+	return Div1_Calculate(divisor, *remainder);
+	}
+
+
+	/*!
+		the first division algorithm
+		(radix 2)
+	*/
+	uint Div1(const UInt<value_size> & divisor, UInt<value_size> & remainder)
+	{
+		return Div1(divisor, &remainder);
+	}
+
+
+private:
+
+	uint Div1_Calculate(const UInt<value_size> & divisor, UInt<value_size> & rest)
+	{
+		if( this == &divisor )
+		{
+			UInt<value_size> divisor_copy(divisor);
+			return Div1_CalculateRef(divisor_copy, rest);
+		}
+		else
+		{
+			return Div1_CalculateRef(divisor, rest);
+		}
+	}
+
+
+	uint Div1_CalculateRef(const UInt<value_size> & divisor, UInt<value_size> & rest)
+	{
+	TTMATH_REFERENCE_ASSERT( divisor )
+	
+	sint loop;
+	sint c;
+
+		rest.SetZero();
+		loop = value_size * TTMATH_BITS_PER_UINT;
+		c = 0;
+
+		
+	div_a:
+		c = Rcl(1, c);
+		c = rest.Add(rest,c);
+		c = rest.Sub(divisor,c);
+
+		c = !c;
+
+		if(!c)
+			goto div_d;
+
+
+	div_b:
+		--loop;
+		if(loop)
+			goto div_a;
+
+		c = Rcl(1, c);
+		TTMATH_LOG("UInt::Div1_Calculate")
+		return 0;
+
+
+	div_c:
+		c = Rcl(1, c);
+		c = rest.Add(rest,c);
+		c = rest.Add(divisor);
+
+		if(c)
+			goto div_b;
+
+
+	div_d:
+		--loop;
+		if(loop)
+			goto div_c;
+
+		c = Rcl(1, c);
+		c = rest.Add(divisor);
+
+		TTMATH_LOG("UInt::Div1_Calculate")
+
+	return 0;
+	}
+	
+
+public:
+
+	/*!
+		the second division algorithm
+
+		return values:
+		-  0 - ok
+		-  1 - division by zero
+	*/
+	uint Div2(const UInt<value_size> & divisor, UInt<value_size> * remainder = 0)
+	{
+		if( this == &divisor )
+		{
+			UInt<value_size> divisor_copy(divisor);
+			return Div2Ref(divisor_copy, remainder);
+		}
+		else
+		{
+			return Div2Ref(divisor, remainder);
+		}
+	}
+
+
+	/*!
+		the second division algorithm
+
+		return values:
+		-  0 - ok
+		-  1 - division by zero
+	*/
+	uint Div2(const UInt<value_size> & divisor, UInt<value_size> & remainder)
+	{
+		return Div2(divisor, &remainder);
+	}
+
+
+private:
+
+	/*!
+		the second division algorithm
+
+		return values:
+		-  0 - ok
+		-  1 - division by zero
+	*/
+	uint Div2Ref(const UInt<value_size> & divisor, UInt<value_size> * remainder = 0)
+	{
+		uint bits_diff;
+		uint status = Div2_Calculate(divisor, remainder, bits_diff);
+		if( status < 2 )
+			return status;
+
+		if( CmpBiggerEqual(divisor) )
+		{
+			Div2(divisor, remainder);
+			SetBit(bits_diff);
+		}
+		else
+		{
+			if( remainder )
+				*remainder = *this;
+
+			SetZero();
+			SetBit(bits_diff);
+		}
+
+		TTMATH_LOG("UInt::Div2")
+
+	return 0;
+	}
+
+
+	/*!
+		return values:
+		-  0 - we've calculated the division
+		-  1 - division by zero
+		-  2 - we have to still calculate
+
+	*/
+	uint Div2_Calculate(const UInt<value_size> & divisor, UInt<value_size> * remainder,
+															uint & bits_diff)
+	{
+	uint table_id, index;
+	uint divisor_table_id, divisor_index;
+
+		uint status = Div2_FindLeadingBitsAndCheck(	divisor, remainder,
+													table_id, index,
+													divisor_table_id, divisor_index);
+
+		if( status < 2 )
+		{
+			TTMATH_LOG("UInt::Div2_Calculate")
+			return status;
+		}
+		
+		// here we know that 'this' is greater than divisor
+		// then 'index' is greater or equal 'divisor_index'
+		bits_diff = index - divisor_index;
+
+		UInt<value_size> divisor_copy(divisor);
+		divisor_copy.Rcl(bits_diff, 0);
+
+		if( CmpSmaller(divisor_copy, table_id) )
+		{
+			divisor_copy.Rcr(1);
+			--bits_diff;
+		}
+
+		Sub(divisor_copy, 0);
+
+		TTMATH_LOG("UInt::Div2_Calculate")
+
+	return 2;
+	}
+
+
+	/*!
+		return values:
+		-  0 - we've calculated the division
+		-  1 - division by zero
+		-  2 - we have to still calculate
+	*/
+	uint Div2_FindLeadingBitsAndCheck(	const UInt<value_size> & divisor,
+										UInt<value_size> * remainder,
+										uint & table_id, uint & index,
+										uint & divisor_table_id, uint & divisor_index)
+	{
+		if( !divisor.FindLeadingBit(divisor_table_id, divisor_index) )
+		{
+			// division by zero
+			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+			return 1;
+		}
+
+		if(	!FindLeadingBit(table_id, index) )
+		{
+			// zero is divided by something
+			
+			SetZero();
+
+			if( remainder )
+				remainder->SetZero();
+
+			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+
+		return 0;
+		}
+	
+		divisor_index += divisor_table_id * TTMATH_BITS_PER_UINT;
+		index         += table_id         * TTMATH_BITS_PER_UINT;
+
+		if( divisor_table_id == 0 )
+		{
+			// dividor has only one 32-bit word
+
+			uint r;
+			DivInt(divisor.table[0], &r);
+
+			if( remainder )
+			{
+				remainder->SetZero();
+				remainder->table[0] = r;
+			}
+
+			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+
+		return 0;
+		}
+	
+
+		if( Div2_DivisorGreaterOrEqual(	divisor, remainder,
+										table_id, index,
+										divisor_index) )
+		{
+			TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+			return 0;
+		}
+
+
+		TTMATH_LOG("UInt::Div2_FindLeadingBitsAndCheck")
+
+	return 2;
+	}
+
+
+	/*!
+		return values:
+		-  true if divisor is equal or greater than 'this'
+	*/
+	bool Div2_DivisorGreaterOrEqual(	const UInt<value_size> & divisor,
+										UInt<value_size> * remainder, 
+										uint table_id, uint index,
+										uint divisor_index  )
+	{
+		if( divisor_index > index )
+		{
+			// divisor is greater than this
+
+			if( remainder )
+				*remainder = *this;
+
+			SetZero();
+
+			TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+
+		return true;
+		}
+
+		if( divisor_index == index )
+		{
+			// table_id == divisor_table_id as well
+
+			uint i;
+			for(i = table_id ; i!=0 && table[i]==divisor.table[i] ; --i);
+			
+			if( table[i] < divisor.table[i] )
+			{
+				// divisor is greater than 'this'
+
+				if( remainder )
+					*remainder = *this;
+
+				SetZero();
+
+				TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+
+			return true;
+			}
+			else
+			if( table[i] == divisor.table[i] )
+			{
+				// divisor is equal 'this'
+
+				if( remainder )
+					remainder->SetZero();
+
+				SetOne();
+
+				TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+
+			return true;
+			}
+		}
+
+		TTMATH_LOG("UInt::Div2_DivisorGreaterOrEqual")
+
+	return false;
+	}
+
+
+public:
+
+	/*!
+		the third division algorithm
+	*/
+	uint Div3(const UInt<value_size> & ss2, UInt<value_size> * remainder = 0)
+	{
+		if( this == &ss2 )
+		{
+			UInt<value_size> copy_ss2(ss2);
+			return Div3Ref(copy_ss2, remainder);
+		}
+		else
+		{
+			return Div3Ref(ss2, remainder);
+		}
+	}
+
+
+	/*!
+		the third division algorithm
+	*/
+	uint Div3(const UInt<value_size> & ss2, UInt<value_size> & remainder)
+	{
+		return Div3(ss2, &remainder);
+	}
+
+
+private:
+
+	/*!
+		the third division algorithm
+
+		this algorithm is described in the following book:
+			"The art of computer programming 2" (4.3.1 page 272)
+			Donald E. Knuth 
+		!! give the description here (from the book)
+	*/
+	uint Div3Ref(const UInt<value_size> & v, UInt<value_size> * remainder = 0)
+	{
+	uint m,n, test;
+
+		test = Div_StandardTest(v, m, n, remainder);
+		if( test < 2 )
+			return test;
+
+		if( n == 0 )
+		{
+			uint r;
+			DivInt( v.table[0], &r );
+
+			if( remainder )
+			{
+				remainder->SetZero();
+				remainder->table[0] = r;
+			}
+
+			TTMATH_LOG("UInt::Div3")
+
+		return 0;
+		}
+
+
+		// we can only use the third division algorithm when 
+		// the divisor is greater or equal 2^32 (has more than one 32-bit word)
+		++m;
+		++n;
+		m = m - n; 
+		Div3_Division(v, remainder, m, n);
+
+		TTMATH_LOG("UInt::Div3")
+
+	return 0;
+	}
+
+
+
+private:
+
+
+	void Div3_Division(UInt<value_size> v, UInt<value_size> * remainder, uint m, uint n)
+	{
+	TTMATH_ASSERT( n>=2 && n<=value_size && m<=value_size && m+n<=value_size )
+
+	UInt<value_size> q;
+	uint d, u_value_size, u0, u1, u2, v1, v0, reciprocal, j=m;	
+	
+		u_value_size = Div3_Normalize(v, n, d);
+
+		if( j+n == value_size )
+			u2 = u_value_size;
+		else
+			u2 = table[j+n];
+
+		for(uint i = j+1 ; i<value_size ; ++i)
+			q.table[i] = 0;
+
+		v1         = v.table[n-1];
+		v0         = v.table[n-2];
+		reciprocal = Div_WordReciprocal(v1);
+
+		while( true )
+		{
+			u1 = table[j+n-1];
+			u0 = table[j+n-2];
+
+			uint qp = Div3_Calculate(u2,u1,u0, v1,v0, reciprocal);
+
+			Div3_MultiplySubtract(v, j, n, u2, qp);
+
+			q.table[j] = qp;
+
+			// the next loop
+			if( j-- == 0 )
+				break;
+
+			u2 = table[j+n];
+		}
+
+		if( remainder )
+			Div3_Unnormalize(remainder, n, d);
+
+	*this = q;
+
+	TTMATH_LOG("UInt::Div3_Division")
+	}
+
+
+	/*!
+		we're moving all bits from 'v' into the left side of the n-1 word
+		(the highest bit at v.table[n-1] will be equal one,
+		the bits from 'this' we're moving the same times as 'v')
+
+		return values:
+		-  d - how many times we've moved
+		-  return - the next-left value from 'this' (that after table[value_size-1])
+	*/
+	uint Div3_Normalize(UInt<value_size> & v, uint n, uint & d)
+	{
+		// v.table[n-1] is != 0
+
+		uint bit  = (uint)FindLeadingBitInWord(v.table[n-1]);
+		uint move = (TTMATH_BITS_PER_UINT - bit - 1);
+		uint res  = table[value_size-1];
+		d         = move;
+
+		if( move > 0 )
+		{
+			v.Rcl(move, 0);
+			Rcl(move, 0);
+			res = res >> (bit + 1);
+		}
+		else
+		{
+			res = 0;
+		}
+
+		TTMATH_LOG("UInt::Div3_Normalize")
+
+	return res;
+	}
+
+
+	void Div3_Unnormalize(UInt<value_size> * remainder, uint n, uint d)
+	{
+		for(uint i=n ; i<value_size ; ++i)
+			table[i] = 0;
+
+		Rcr(d,0);
+
+		*remainder = *this;
+
+		TTMATH_LOG("UInt::Div3_Unnormalize")
+	}
+
+
+	/*!
+		D3 (in the book)
+
+		the estimation of the quotient word from the three highest words of the dividend
+		(u2 is not greater than v1) and two highest words of the divisor,
+		the first estimation (u2:u1 / v1) is calculated by Div_TwoWordsByReciprocal()
+		where v is the reciprocal of v1 (from Div_WordReciprocal()), it is calculated
+		once for the whole division because v1 doesn't change
+	*/
+	static uint Div3_Calculate(uint u2, uint u1, uint u0, uint v1, uint v0, uint v)
+	{
+	uint qp, rp, hi, lo;
+
+		TTMATH_ASSERT( u2 <= v1 )
+
+		if( u2 == v1 )
+		{
+			// the estimation would be beta, it is decreased to beta-1
+			qp = TTMATH_UINT_MAX_VALUE;
+			rp = u1 + v1;
+
+			if( rp < v1 )
+				return qp; // rp is greater than or equal to beta
+		}
+		else
+		{
+			qp = Div_TwoWordsByReciprocal(u2, u1, v1, v, &rp);
+		}
+
+		while( true )
+		{
+			MulTwoWords(qp, v0, &hi, &lo);
+
+			if( hi < rp || (hi == rp && lo <= u0) )
+				break;
+
+			--qp;
+			rp += v1;
+
+			if( rp < v1 )
+				break; // there was a carry (rp is greater than or equal to beta)
+		}
+
+	return qp;
+	}
+
+
+
+	/*!
+		D4 (in the book)
+
+		we're subtracting qp*v from the n+1 words of 'this' beginning from table[j]
+		(the highest of these words is u2, it is outside of the table when j+n is equal value_size),
+		the subtraction is done in place by MulSubVector()
+	*/
+	void Div3_MultiplySubtract(const UInt<value_size> & v, uint j, uint n, uint u2, uint & qp)
+	{
+	uint c;
+
+		c = MulSubVector(v.table, n, qp, table + j);
+
+		if( u2 < c )
+		{
+			// there was a carry (qp was one too big)
+			// we're adding v back, the carry from the addition cancels
+			// the one we've taken too much from u2
+
+			--qp;
+			c -= AddVector(table + j, v.table, n, n, table + j);
+		}
+
+		u2 -= c;
+		TTMATH_ASSERT( u2 == 0 )
+
+		if( j+n < value_size )
+			table[j+n] = u2;
+
+		TTMATH_LOG("UInt::Div3_MultiplySubtract")
+	}
+
+
+
+public:
+
+	/*!
+		the fourth division algorithm (Burnikel-Ziegler)
+
+		this is a recursive division: a 2n/n division is made by two 3n/2n divisions
+		and each of them by one n/(n/2) division and one (n/2)*(n/2) multiplication,
+		the multiplications are calculated by the MulFastestBig() algorithms (Karatsuba,
+		Toom-3, IFMA or NTT) so for big values it is much faster than Div3()
+	*/
+	uint Div4(const UInt<value_size> & ss2, UInt<value_size> * remainder = 0)
+	{
+		if( this == &ss2 )
+		{
+			UInt<value_size> copy_ss2(ss2);
+			return Div_BlockRef(copy_ss2, remainder, 4);
+		}
+		else
+		{
+			return Div_BlockRef(ss2, remainder, 4);
+		}
+	}
+
+
+	/*!
+		the fourth division algorithm (Burnikel-Ziegler)
+	*/
+	uint Div4(const UInt<value_size> & ss2, UInt<value_size> & remainder)
+	{
+		return Div4(ss2, &remainder);
+	}
+
+
+	/*!
+		the fifth division algorithm (Newton)
+
+		the reciprocal of the divisor is calculated by the Newton iteration
+		(the precision is doubled in each step) and then the quotient
+		is calculated by multiplying by the reciprocal, all multiplications are made by
+		the MulFastestBig() algorithms so it is faster than Div3() for very big values
+		(the result is exactly the same as from the other division algorithms)
+	*/
+	uint Div5(const UInt<value_size> & ss2, UInt<value_size> * remainder = 0)
+	{
+		if( this == &ss2 )
+		{
+			UInt<value_size> copy_ss2(ss2);
+			return Div_BlockRef(copy_ss2, remainder, 5);
+		}
+		else
+		{
+			return Div_BlockRef(ss2, remainder, 5);
+		}
+	}
+
+
+	/*!
+		the fifth division algorithm (Newton)
+	*/
+	uint Div5(const UInt<value_size> & ss2, UInt<value_size> & remainder)
+	{
+		return Div5(ss2, &remainder);
+	}
+
+
+private:
+
+	/*!
+		the fourth and the fifth division algorithm
+
+		the fourth algorithm is described in:
+			"Fast Recursive Division"
+			Christoph Burnikel, Joachim Ziegler
+			Max-Planck-Institut fuer Informatik, Research Report MPI-I-98-1-022 (1998)
+
+		the fifth algorithm (the reciprocal and the 2n/n division) is described in:
+			"Modern Computer Arithmetic" (3.4.1 page 102 and 2.4.1 page 55)
+			Richard P. Brent, Paul Zimmermann
+	*/
+	uint Div_BlockRef(const UInt<value_size> & v, UInt<value_size> * remainder, uint algorithm)
+	{
+	uint m,n, test;
+
+		test = Div_StandardTest(v, m, n, remainder);
+		if( test < 2 )
+			return test;
+
+		if( n == 0 )
+		{
+			uint r;
+			DivInt( v.table[0], &r );
+
+			if( remainder )
+			{
+				remainder->SetZero();
+				remainder->table[0] = r;
+			}
+
+			TTMATH_LOG("UInt::Div_BlockRef")
+
+		return 0;
+		}
+
+		Div_BlockDivision(v, remainder, m+1, n+1, algorithm);
+
+		TTMATH_LOG("UInt::Div_BlockRef")
+
+	return 0;
+	}
+
+
+	/*!
+		returns true if the divisor and the quotient are big enough
+		for the Burnikel-Ziegler division to be faster than Div3()
+	*/
+	bool Div_UseBurnikelZiegler(const UInt<value_size> & divisor) const
+	{
+	uint m, n;
+
+		if( value_size < 2 * TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE )
+			return false;
+
+		for(m=value_size ; m>0 && table[m-1]==0 ; --m);
+		for(n=value_size ; n>0 && divisor.table[n-1]==0 ; --n);
+
+	return n >= TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE &&
+	       m >= n + TTMATH_USE_BURNIKEL_ZIEGLER_DIVISION_FROM_SIZE;
+	}
+
+
+	/*!
+		m - how many words the dividend ('this') has
+		s - how many words the divisor has (s>=2)
+		algorithm - 4 (Burnikel-Ziegler) or 5 (Newton)
+
+		the divisor is shifted so that the highest bit is set and the dividend is shifted
+		by the same number of bits, for the fourth algorithm the divisor is also padded
+		(at the lowest words) to n words where n = j * 2^k and j is not greater than
+		TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE, for the fifth algorithm n = s
+		and the reciprocal of the divisor is calculated
+
+		the dividend is divided into t blocks of n words, if the highest block is greater
+		than or equal to the divisor we're subtracting the divisor from it (the highest
+		word of the quotient is one then), then we're dividing the two highest blocks
+		by the divisor, the remainder with the next block by the divisor again and so on
+	*/
+	void Div_BlockDivision(const UInt<value_size> & v, UInt<value_size> * remainder, uint m, uint s, uint algorithm)
+	{
+	TTMATH_ASSERT( s>=2 && s<=m && m<=value_size )
+
+	uint k = 0, n, t, move, bits, c, i;
+
+		if( algorithm == 4 )
+			for( ; ((s-1) >> k) + 1 > TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE ; ++k);
+
+		n    = (((s-1) >> k) + 1) << k;
+		move = n - s;
+		bits = TTMATH_BITS_PER_UINT - 1 - (uint)FindLeadingBitInWord(v.table[s-1]);
+		t    = (m + move) / n + 1;
+
+		// the dividend (t*n words), the divisor (n words), the quotient (t*n words),
+		// the reciprocal (n+1 words) and a buffer for Div4_Div3n2n() and Div5_Reciprocal()
+		// (3*n+8 words and 4*value_size words for Div_Multiply())
+		std::vector<uint> buffer(t*n + n + t*n + n+1 + 3*n+8 + 4*value_size);
+		uint * a = &buffer[0];
+		uint * b = a + t*n;
+		uint * q = b + n;
+		uint * x = q + t*n;
+		uint * p = x + n+1;
+
+		Div_ShiftLeft(v.table, s, bits, b + move);
+		c = Div_ShiftLeft(table, m, bits, a + move);
+
+		if( c != 0 )
+			a[m + move] = c;
+		else
+		if( (m + move) % n == 0 )
+			--t; // the highest block would be zero
+
+		if( !Div_Less(a + (t-1)*n, b, n) )
+		{
+			SubVector(a + (t-1)*n, b, n, n, a + (t-1)*n);
+			q[(t-1)*n] = 1;
+		}
+
+		if( algorithm == 5 )
+			Div5_Reciprocal(b, n, x, p);
+
+		for(i=t-1 ; i-- > 0 ; )
+			if( algorithm == 4 )
+				Div4_Div2n1n(a + i*n, b, n, q + i*n, p);
+			else
+				Div5_Div2n1n(a + i*n, b, x, n, q + i*n, p);
+
+		for(i=0 ; i<value_size ; ++i)
+			table[i] = (i < t*n) ? q[i] : 0;
+
+		if( remainder )
+		{
+			// the remainder is in the lowest n words (a[n] is zero)
+			remainder->SetZero();
+
+			for(i=0 ; i<s ; ++i)
+				if( bits > 0 )
+					remainder->table[i] = (a[move+i] >> bits) | (a[move+i+1] << (TTMATH_BITS_PER_UINT - bits));
+				else
+					remainder->table[i] = a[move+i];
+		}
+
+		TTMATH_LOG("UInt::Div_BlockDivision")
+	}
+
+
+	/*!
+		result = ss << bits (bits < TTMATH_BITS_PER_UINT)
+
+		the result has 'size' words, the method returns the bits shifted out from the last word
+	*/
+	static uint Div_ShiftLeft(const uint * ss, uint size, uint bits, uint * result)
+	{
+	uint i, c = 0;
+
+		for(i=0 ; i<size ; ++i)
+		{
+			if( bits > 0 )
+			{
+				result[i] = (ss[i] << bits) | c;
+				c         = ss[i] >> (TTMATH_BITS_PER_UINT - bits);
+			}
+			else
+			{
+				result[i] = ss[i];
+			}
+		}
+
+	return c;
+	}
+
+
+	/*!
+		the reciprocal of one word d (the highest bit is set):
+			v = floor( (beta^2 - 1) / d ) - beta      (beta = 2^TTMATH_BITS_PER_UINT)
+	*/
+	static uint Div_WordReciprocal(uint d)
+	{
+	TTMATH_ASSERT( (d & TTMATH_UINT_HIGHEST_BIT) != 0 )
+
+	#if defined(TTMATH_NOASM) && defined(TTMATH_PLATFORM64)
+
+		/*
+			DivTwoWords() is slow here (it divides by 32 bit halves)
+			so we use the algorithm 3 from the paper:
+			Niels Moller, Torbjorn Granlund, "Improved division by invariant integers"
+			(one small division and a few multiplications only)
+		*/
+		uint d0  = d & 1;
+		uint d9  = d >> 55;
+		uint d40 = (d >> 24) + 1;
+		uint d63 = (d >> 1) + d0;
+		uint v0  = ((uint(1) << 19) - 3 * (uint(1) << 8)) / d9;
+		uint v1  = (v0 << 11) - ((v0 * v0 * d40) >> 40) - 1;
+		uint v2  = (v1 << 13) + ((v1 * ((uint(1) << 60) - v1 * d40)) >> 47);
+		uint e   = ((v2 >> 1) & (0 - d0)) - v2 * d63;
+		uint high, low;
+
+		MulTwoWords(v2, e, &high, &low);
+		uint v3 = (v2 << 31) + (high >> 1);
+
+		// v = v3 - floor( (v3 + beta + 1) * d / beta )
+		MulTwoWords(v3, d, &high, &low);
+		low += d;
+		high += (low < d) ? 1 : 0;
+
+	return v3 - high - d;
+
+	#else
+
+	uint v, rest;
+
+		// beta^2 - 1 - d*beta has ~d in the higher word
+		DivTwoWords(~d, TTMATH_UINT_MAX_VALUE, d, &v, &rest);
+
+	return v;
+
+	#endif
+	}
+
+
+	/*!
+		the 2-by-1 division by using the reciprocal v of d (from Div_WordReciprocal())
+
+		returns (u1*beta + u0) / d and the remainder is stored in 'rest',
+		u1 must be smaller than d
+
+		the algorithm is described in:
+			"Improved division by invariant integers"
+			Niels Moller, Torbjorn Granlund
+			IEEE Transactions on Computers, vol. 60, no. 2 (2011)
+	*/
+	static uint Div_TwoWordsByReciprocal(uint u1, uint u0, uint d, uint v, uint * rest)
+	{
+	uint q1, q0, r, mask;
+
+		TTMATH_ASSERT( u1 < d )
+
+		MulTwoWords(v, u1, &q1, &q0);
+		q0 += u0;
+		q1 += u1 + ((q0 < u0) ? 1 : 0) + 1;
+		r   = u0 - q1 * d;
+
+		// this condition is unpredictable so it is calculated without a branch
+		mask = uint(0) - ((r > q0) ? 1 : 0);
+		q1  += mask;
+		r   += mask & d;
+
+		if( r >= d )
+		{
+			++q1;
+			r -= d;
+		}
+
+		*rest = r;
+
+	return q1;
+	}
+
+
+	/*!
+		returns true if ss1 < ss2 (both vectors have 'size' words)
+	*/
+	static bool Div_Less(const uint * ss1, const uint * ss2, uint size)
+	{
+		while( size-- > 0 )
+			if( ss1[size] != ss2[size] )
+				return ss1[size] < ss2[size];
+
+	return false;
+	}
+
+
+	/*!
+		the 2n/n division
+
+		a has 2n words and the higher n words are smaller than b (n words, normalized),
+		q (n words) = a / b and the remainder is stored in the lower n words of 'a'
+		(the higher words are cleared)
+	*/
+	void Div4_Div2n1n(uint * a, const uint * b, uint n, uint * q, uint * buffer)
+	{
+		if( (n & 1) == 1 || n <= TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE )
+		{
+			Div4_Basecase(a, b, n, q);
+			return;
+		}
+
+		uint h = n / 2;
+
+		Div4_Div3n2n(a + h, b, h, q + h, buffer);
+		Div4_Div3n2n(a,     b, h, q,     buffer);
+	}
+
+
+	/*!
+		the 3h/2h division
+
+		a has 3h words and the higher 2h words are smaller than b (2h words, normalized),
+		q (h words) = a / b and the remainder is stored in the lower 2h words of 'a'
+		(the higher words are cleared)
+
+		we're estimating the quotient by dividing the two higher parts of 'a' by the higher
+		part of b, this estimation is greater than the real quotient by at most 2
+	*/
+	void Div4_Div3n2n(uint * a, const uint * b, uint h, uint * q, uint * buffer)
+	{
+	uint * d = buffer;
+	uint i, c;
+
+		if( Div_Less(a + 2*h, b + h, h) )
+		{
+			// the remainder is stored in a[h..2h-1]
+			Div4_Div2n1n(a + h, b + h, h, q, buffer);
+			c = 0;
+		}
+		else
+		{
+			// the higher part of 'a' is equal to the higher part of b
+			// q = beta^h - 1 and the remainder is: a[h..3h-1] - b[h..2h-1]*beta^h + b[h..2h-1]
+			for(i=0 ; i<h ; ++i)
+			{
+				q[i]       = TTMATH_UINT_MAX_VALUE;
+				a[2*h + i] = 0;
+			}
+
+			c = AddVector(a + h, b + h, h, h, a + h);
+		}
+
+		// subtracting q * b[0..h-1], the remainder can be negative then (c is the highest word)
+		Div_Multiply<value_size>(q, h, b, h, d, buffer + 2*h);
+		c -= SubVector(a, d, 2*h, 2*h, a);
+
+		while( c != 0 )
+		{
+			for(i=0 ; i<h && q[i]-- == 0 ; ++i);
+			c += AddVector(a, b, 2*h, 2*h, a);
+		}
+	}
+
+
+	/*!
+		the 2n/n division made by the schoolbook algorithm (the same as in Div3_Division())
+	*/
+	void Div4_Basecase(uint * a, const uint * b, uint n, uint * q)
+	{
+	uint j = n;
+
+		if( n == 1 )
+		{
+			DivTwoWords(a[1], a[0], b[0], q, a);
+			a[1] = 0;
+			return;
+		}
+
+		uint reciprocal = Div_WordReciprocal(b[n-1]);
+
+		while( j-- > 0 )
+			q[j] = Div_SchoolbookStep(a + j, b, n, reciprocal);
+	}
+
+
+	/*!
+		one step of the schoolbook division (D3-D6 in Div3_Division())
+
+		a has n+1 words and the higher n words are smaller than b (n words, normalized, n>=2),
+		the method returns a / b and the remainder is stored in the lower n words of 'a'
+		(a[n] is cleared), v is the reciprocal of b[n-1] (from Div_WordReciprocal())
+	*/
+	static uint Div_SchoolbookStep(uint * a, const uint * b, uint n, uint v)
+	{
+	uint u2 = a[n], qp, c;
+
+		qp = Div3_Calculate(u2, a[n-1], a[n-2], b[n-1], b[n-2], v);
+		c  = MulSubVector(b, n, qp, a);
+
+		if( u2 < c )
+		{
+			--qp;
+			c -= AddVector(a, b, n, n, a);
+		}
+
+		TTMATH_ASSERT( u2 == c )
+
+		a[n] = 0;
+
+	return qp;
+	}
+
+
+	/*!
+		the reciprocal of b (n words, normalized)
+
+		x has n+1 words and:
+			b * x < beta^(2n) <= b * (x + 2)      (beta = 2^TTMATH_BITS_PER_UINT)
+
+		we're calculating the reciprocal xh of the higher h words of b (recursively)
+		and then one step of the Newton iteration is made:
+			t = beta^(n+h) - b * xh
+			x = xh * beta^l + floor( floor(t / beta^l) * xh / beta^(2h-l) )
+		so the precision is doubled in each step
+	*/
+	void Div5_Reciprocal(const uint * b, uint n, uint * x, uint * buffer)
+	{
+	uint l, h, i;
+
+		if( n <= TTMATH_BURNIKEL_ZIEGLER_DIVISION_BASECASE_SIZE )
+		{
+			// x = (beta^(2n) - 1) / b = beta^n + (beta^(2n) - 1 - b*beta^n) / b
+			// (the higher n words of the dividend: beta^n - 1 - b is equal to ~b)
+			uint * a = buffer;
+
+			for(i=0 ; i<n ; ++i)
+			{
+				a[i]     = TTMATH_UINT_MAX_VALUE;
+				a[n + i] = ~b[i];
+			}
+
+			Div4_Basecase(a, b, n, x);
+			x[n] = 1;
+
+			return;
+		}
+
+		l = (n - 1) / 2;
+		h = n - l;
+
+		// xh is stored in x[l..n]
+		Div5_Reciprocal(b + l, h, x + l, buffer);
+
+		uint * t = buffer;
+		uint * u = t + n + h + 1;
+		uint * p = u + 2*h + 2;
+
+		Div_Multiply<value_size>(b, n, x + l, h + 1, t, p);
+
+		while( t[n + h] != 0 )
+		{
+			// b * xh is too big
+			for(i=l ; x[i]-- == 0 ; ++i);
+			SubVector(t, b, n + h + 1, n, t);
+		}
+
+		// t = beta^(n+h) - t (it is smaller than 2*b)
+		for(i=0 ; i<n+h ; ++i)
+			t[i] = ~t[i];
+
+		for(i=0 ; i<n+h && ++t[i] == 0 ; ++i);
+
+		Div_Multiply<value_size>(t + l, h + 1, x + l, h + 1, u, p);
+
+		for(i=0 ; i<l ; ++i)
+			x[i] = 0;
+
+		// there is no carry (x is smaller than 2*beta^n)
+		AddVector(x, u + 2*h - l, n + 1, l + 2, x);
+	}
+
+
+	/*!
+		the 2n/n division by using the reciprocal x of b (from Div5_Reciprocal())
+
+		a has 2n words and the higher n words (ah) are smaller than b (n words, normalized),
+		q (n words) = a / b and the remainder is stored in the lower n words of 'a'
+		(the higher words are cleared)
+
+		the estimation of the quotient: ah + floor(ah * (x - beta^n) / beta^n)
+		is not greater than the real quotient and it is smaller only by a few
+	*/
+	void Div5_Div2n1n(uint * a, const uint * b, const uint * x, uint n, uint * q, uint * buffer)
+	{
+	uint * d = buffer;
+	uint i;
+
+		// there are no carries (the estimation is smaller than beta^n and not greater than a/b)
+		Div_Multiply<value_size>(a + n, n, x, n, d, buffer + 2*n);
+		AddVector(d + n, a + n, n, n, q);
+
+		Div_Multiply<value_size>(q, n, b, n, d, buffer + 2*n);
+		SubVector(a, d, 2*n, 2*n, a);
+
+		// the remainder has at most n+1 words now
+		while( a[n] != 0 || !Div_Less(a, b, n) )
+		{
+			a[n] -= SubVector(a, b, n, n, a);
+			for(i=0 ; i<n && ++q[i] == 0 ; ++i);
+		}
+	}
+
+
+	/*!
+		this = this / divisor where the divisor is given by UIntDivisor:
+		b (s words) - the divisor shifted left by 'bits' (the highest bit is set)
+		x (s+1 words) - the reciprocal of b (from Div5_Reciprocal()), it is used only when
+		                s is at least TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE
+		v - the reciprocal of the highest word of b (from Div_WordReciprocal())
+
+		a one word divisor is divided by DivInt_Reciprocal(), a small divisor
+		by the schoolbook algorithm (Div_SchoolbookStep()), and a big divisor by the same
+		blocks as in Div_BlockDivision() for the fifth algorithm,
+		the divisor is not normalized here, the buffers are on the stack if they are not
+		greater than TTMATH_STACK_BUFFER_MAX_SIZE words
+	*/
+	void Div5_Precomputed(const uint * b, const uint * x, uint v, uint s, uint bits, UInt<value_size> * remainder)
+	{
+	TTMATH_ASSERT( s>=1 && s<=value_size )
+
+	const uint stack_size = (10*value_size+1 < TTMATH_STACK_BUFFER_MAX_SIZE) ? 10*value_size+1 : TTMATH_STACK_BUFFER_MAX_SIZE;
+	uint stack_buffer[stack_size];
+	std::vector<uint> heap_buffer;
+	uint m, t, i;
+
+		if( s == 1 )
+		{
+			uint r = DivInt_Reciprocal(b[0], v, bits);
+
+			if( remainder )
+			{
+				remainder->SetZero();
+				remainder->table[0] = r;
+			}
+
+			return;
+		}
+
+		for(m=value_size ; m>0 && table[m-1]==0 ; --m);
+
+		// t*s is greater than m so there is room for the bits shifted out from the dividend,
+		// a[t*s] is used only when the remainder is shifted back
+		t = m / s + 1;
+
+		// a (t*s+1 words), q (t*s words) and a buffer for Div5_Div2n1n()
+		uint size = 2*t*s + 1;
+
+		if( s >= TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE )
+			size += 2*s + Div_MultiplyBufferSize(s);
+
+		uint * a = Div_Buffer(stack_buffer, stack_size, heap_buffer, size);
+		uint * q = a + t*s + 1;
+
+		for(i=m+1 ; i<=t*s ; ++i)
+			a[i] = 0;
+
+		a[m] = Div_ShiftLeft(table, m, bits, a);
+
+		for(i=0 ; i<t*s ; ++i)
+			q[i] = 0;
+
+		// the highest block is smaller than beta^s so it is smaller than 2*b
+		if( !Div_Less(a + (t-1)*s, b, s) )
+		{
+			SubVector(a + (t-1)*s, b, s, s, a + (t-1)*s);
+			q[(t-1)*s] = 1;
+		}
+
+		if( s < TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE )
+		{
+			// a[m] is smaller than the highest word of b so there are only m-s+1 quotient words
+			for(i=m ; i>=s ; --i)
+				q[i - s] = Div_SchoolbookStep(a + i - s, b, s, v);
+		}
+		else
+		{
+			uint * p = q + t*s;
+
+			for(i=t-1 ; i-- > 0 ; )
+				Div5_Div2n1n(a + i*s, b, x, s, q + i*s, p);
+		}
+
+		for(i=0 ; i<value_size ; ++i)
+			table[i] = (i < t*s) ? q[i] : 0;
+
+		if( remainder )
+		{
+			// the remainder is in the lowest s words (a[s] is zero)
+			remainder->SetZero();
+
+			for(i=0 ; i<s ; ++i)
+				if( bits > 0 )
+					remainder->table[i] = (a[i] >> bits) | (a[i+1] << (TTMATH_BITS_PER_UINT - bits));
+				else
+					remainder->table[i] = a[i];
+		}
+
+		TTMATH_LOG("UInt::Div5_Precomputed")
+	}
+
+
+	/*!
+		returning how many words Div_Multiply<value_size>() needs for its buffer
+		when the greater of the values has 'size' words
+	*/
+	static uint Div_MultiplyBufferSize(uint size)
+	{
+	uint ss_size = value_size;
+
+		if( size < TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
+			return 0;
+
+		while( size <= ss_size/2 )
+			ss_size /= 2;
+
+	return 4*ss_size;
+	}
+
+
+	/*!
+		returning a buffer for at least 'size' words
+
+		it is 'stack_buffer' (stack_size words) if the size is not greater than stack_size,
+		otherwise 'heap_buffer' is resized and its table is returned
+	*/
+	static uint * Div_Buffer(uint * stack_buffer, uint stack_size, std::vector<uint> & heap_buffer, uint size)
+	{
+		if( size <= stack_size )
+			return stack_buffer;
+
+		heap_buffer.resize(size);
+
+	return &heap_buffer[0];
+	}
+
+
+	/*!
+		result (size1+size2 words) = ss1 (size1 words) * ss2 (size2 words)
+
+		the values are copied to the buffer (4*ss_size words) where they are padded with zeroes
+		to ss_size words (the smallest value_size/2^i which is not less than size1 and size2)
+		and then multiplied by MulFastestBig2()
+	*/
+	template<uint ss_size>
+	void Div_Multiply(const uint * ss1, uint size1, const uint * ss2, uint size2, uint * result, uint * buffer)
+	{
+	uint i, size = (size1 > size2) ? size1 : size2;
+
+		if( size < TTMATH_USE_KARATSUBA_MULTIPLICATION_FROM_SIZE )
+		{
+			for(i=0 ; i<size1+size2 ; ++i)
+				result[i] = 0;
+
+			for(i=0 ; i<size2 ; ++i)
+				result[i + size1] = MulAddVector(ss1, size1, ss2[i], result + i);
+
+			return;
+		}
+
+		if( size <= ss_size/2 )
+		{
+			Div_Multiply<ss_size/2>(ss1, size1, ss2, size2, result, buffer);
+			return;
+		}
+
+		uint * x1 = buffer;
+		uint * x2 = buffer + ss_size;
+		uint * r  = buffer + ss_size*2;
+
+		for(i=0 ; i<ss_size ; ++i)
+		{
+			x1[i] = (i < size1) ? ss1[i] : 0;
+			x2[i] = (i < size2) ? ss2[i] : 0;
+		}
+
+		MulFastestBig2<ss_size>(x1, x2, r, size);
+
+		for(i=0 ; i<size1+size2 ; ++i)
+			result[i] = r[i];
+	}
+
+
+
+
+
+
+public:
+
+
+	/*!
+		power this = this ^ pow
+		binary algorithm (r-to-l)
+
+		return values:
+		-  0 - ok
+		-  1 - carry
+		-  2 - incorrect argument (0^0)
+	*/
+	uint Pow(UInt<value_size> pow)
+	{
+		if(pow.IsZero() && IsZero())
+			// we don't define zero^zero
+			return 2;
+
+		UInt<value_size> start(*this);
+		UInt<value_size> result;
+		result.SetOne();
+		uint c = 0;
+
+		while( !c )
+		{
+			if( pow.table[0] & 1 )
+				c += result.Mul(start);
+
+			pow.Rcr2_one(0);
+			if( pow.IsZero() )
+				break;
+
+			c += start.Sqr();
+		}
+
+		*this = result;
+
+		TTMATH_LOGC("UInt::Pow(UInt<>)", c)
+
+	return (c==0)? 0 : 1;
+	}
+
+
+	/*!
+		modular power this = (this ^ pow) mod modulus
+
+		return values:
+		-  0 - ok
+		-  1 - the modulus is zero
+		-  2 - incorrect argument (0^0)
+
+		for an odd modulus UIntMontgomery::PowMod() is used (there are no divisions),
+		for an even modulus the binary algorithm (the same as in Pow()) is used and
+		each product is reduced by UIntDivisor
+	*/
+	uint PowMod(const UInt<value_size> & pow, const UInt<value_size> & modulus)
+	{
+		if( modulus.IsZero() )
+			return 1;
+
+		if( (modulus.table[0] & 1) == 1 )
+		{
+			UIntMontgomery<value_size> mont(modulus);
+			return mont.PowMod(*this, pow);
+		}
+
+		if( pow.IsZero() && IsZero() )
+			// we don't define zero^zero
+			return 2;
+
+		UIntDivisor<value_size*2> divisor;
+		UInt<value_size*2> product;
+		UInt<value_size> start, result;
+		uint i, bits, index;
+
+		product = modulus;
+		divisor.Set(product);
+
+		product = *this;
+		divisor.Mod(product);
+		start = product;
+
+		// the modulus is even so it is greater than one
+		result.SetOne();
+
+		pow.FindLeadingBit(bits, index);
+		bits = bits * TTMATH_BITS_PER_UINT + index + 1;
+
+		for(i=0 ; i<bits ; ++i)
+		{
+			if( pow.GetBit(i) )
+			{
+				result.MulBig(start, product);
+				divisor.Mod(product);
+				result = product;
+			}
+
+			if( i + 1 < bits )
+			{
+				start.SqrBig(product);
+				divisor.Mod(product);
+				start = product;
+			}
+		}
+
+		*this = result;
+
+		TTMATH_LOG("UInt::PowMod")
+
+	return 0;
+	}
+
+
+	/*!
+		square root (rounded down)
+		e.g. Sqrt(9) = 3, Sqrt(10) = 3
+
+		the root of the highest bits (one word) is taken from the 'double' type and then
+		the number of bits of the root is doubled in each step by one Newton's iteration
+		r = (r + value/r) / 2 made on the highest bits of the value only (the first
+		divisions are short), at the end of each step the root is corrected by one
+	*/
+	void Sqrt()
+	{
+	uint table_id, index;
+	uint shift[TTMATH_BITS_PER_UINT];
+	uint depth = 0, total = 0;
+
+		if( !FindLeadingBit(table_id, index) )
+			return;
+
+		uint bits = table_id * TTMATH_BITS_PER_UINT + index + 1;
+
+		// the root of x is calculated from the root of x >> (2*shift)
+		// (which has about a half of the bits)
+		while( bits > TTMATH_BITS_PER_UINT )
+		{
+			shift[depth] = (bits - 1) / 4;
+			bits        -= 2 * shift[depth];
+			total       += shift[depth];
+			++depth;
+		}
+
+		UInt<value_size> value(*this), part, quotient, square;
+
+		part = value;
+		part.Rcr(2 * total);
+
+		SetZero();
+		table[0] = SqrtWord(part.table[0]);
+
+		while( depth-- > 0 )
+		{
+			total -= shift[depth];
+			part   = value;
+			part.Rcr(2 * total);
+
+			// this = (r+1) * 2^shift is not less than sqrt(part)
+			AddOne();
+			Rcl(shift[depth]);
+
+			quotient = part;
+			quotient.Div(*this);
+			Add(quotient);
+			Rcr(1);
+
+			// the error is at most one (shift is small enough)
+			square = *this;
+
+			if( square.Sqr() || square > part )
+				SubOne();
+		}
+
+		TTMATH_LOG("UInt::Sqrt")
+	}
+
+
+	/*!
+		square root (rounded down) and the remainder
+		this = Sqrt(this), remainder = this(old) - this(new)^2
+	*/
+	void Sqrt(UInt<value_size> & remainder)
+	{
+		remainder = *this;
+		Sqrt();
+
+		UInt<value_size> square(*this);
+		square.Sqr();
+		remainder.Sub(square);
+
+		TTMATH_LOG("UInt::Sqrt(remainder)")
+	}
+
+
+	/*!
+		the nth root (rounded down)
+		e.g. Root(27, 3) = 3, Root(30, 3) = 3
+
+		the root is estimated from the 'double' type (with about TTMATH_BITS_PER_UINT-16 bits)
+		and then Newton's iterations r = ((n-1)*r + value/r^(n-1)) / n are made
+		while r is decreasing
+
+		return values:
+		-  0 - ok
+		-  2 - incorrect argument (n is zero)
+	*/
+	uint Root(uint n)
+	{
+	uint table_id, index;
+
+		if( n == 0 )
+			return 2;
+
+		if( n == 1 || !FindLeadingBit(table_id, index) )
+			return 0;
+
+		if( n == 2 )
+		{
+			Sqrt();
+			return 0;
+		}
+
+		uint bits = table_id * TTMATH_BITS_PER_UINT + index + 1;
+
+		if( n >= bits )
+		{
+			// 1 <= this < 2^n
+			SetOne();
+			return 0;
+		}
+
+		UInt<value_size> value(*this), next, power, quotient;
+		UInt<value_size> degree(n-1);
+
+		RootEstimate(value, bits, n);
+
+		while( true )
+		{
+			power = *this;
+			quotient = value;
+
+			if( power.Pow(degree) )
+				quotient.SetZero();
+			else
+				quotient.Div(power);
+
+			next = *this;
+			next.MulInt(n-1);
+			next.Add(quotient);
+			next.DivInt(n);
+
+			if( next >= *this )
+				break;
+
+			*this = next;
+		}
+
+		// if the estimation was too small
+		degree.AddOne();
+
+		while( true )
+		{
+			power = *this;
+			power.AddOne();
+
+			if( power.Pow(degree) || power > value )
+				break;
+
+			AddOne();
+		}
+
+		TTMATH_LOG("UInt::Root")
+
+	return 0;
+	}
+
+
+	/*!
+		this method returns true if the value is a square of an integer
+		e.g. 0, 1, 4, 9, 16...
+	*/
+	bool IsPerfectSquare() const
+	{
+		// the last six bits of a square can be only: 0, 1, 4, 9, 16, 17, 25, 33, 36, 41, 49, 57
+		static const uint squares_mod_64[2] = { 0x02030213, 0x02020212 };
+		uint r = table[0] & 63;
+
+		if( ((squares_mod_64[r >> 5] >> (r & 31)) & 1) == 0 )
+			return false;
+
+		UInt<value_size> root(*this), remainder;
+		root.Sqrt(remainder);
+
+	return remainder.IsZero();
+	}
+
+
+	/*!
+		this method returns true if the value is equal base^degree for some integers
+		base and degree>=2 (0 and 1 are perfect powers too)
+
+		'degree' will be the smallest prime number for which this = base^degree
+		(if odd_degree is true only odd degrees are checked)
+
+		e.g. 64 = 8^2 (base=8, degree=2), with odd_degree: 64 = 4^3
+	*/
+	bool IsPerfectPower(UInt<value_size> * base = 0, uint * degree = 0, bool odd_degree = false) const
+	{
+	uint table_id, index, bits, zeros;
+
+		uint p = odd_degree ? 3 : 2;
+
+		if( !FindLeadingBit(table_id, index) || (table_id == 0 && table[0] == 1) )
+		{
+			if( base )
+				*base = *this;
+
+			if( degree )
+				*degree = p;
+
+		return true;
+		}
+
+		bits = table_id * TTMATH_BITS_PER_UINT + index + 1;
+		FindLowestBit(table_id, index);
+		zeros = table_id * TTMATH_BITS_PER_UINT + index;
+
+		UInt<value_size> root, power, exponent;
+
+		// the root is at least two so p is less than bits
+		for( ; p < bits ; p = (p == 2) ? 3 : p + 2 )
+		{
+			// the lowest bits of base^p are zero p*k times
+			if( (zeros > 0 && zeros % p != 0) || !IsPrimeWord(p) )
+				continue;
+
+			root = *this;
+			root.Root(p);
+
+			power = root;
+			exponent = p;
+			power.Pow(exponent);
+
+			if( power == *this )
+			{
+				if( base )
+					*base = root;
+
+				if( degree )
+					*degree = p;
+
+			return true;
+			}
+		}
+
+	return false;
+	}
+
+
+private:
+
+
+	/*!
+		square root of one word (rounded down)
+	*/
+	static uint SqrtWord(uint x)
+	{
+		const uint max_root = TTMATH_UINT_MAX_VALUE >> (TTMATH_BITS_PER_UINT / 2);
+		uint r = uint( std::sqrt(double(x)) );
+
+		// the 'double' can have fewer bits than 'uint'
+		if( r > max_root )
+			r = max_root;
+
+		while( r * r > x )
+			--r;
+
+		while( r < max_root && (r + 1) * (r + 1) <= x )
+			++r;
+
+	return r;
+	}
+
+
+	/*!
+		this method sets an estimation of the nth root of 'value' ('value' has 'bits' bits)
+		the estimation is a little greater than the root
+	*/
+	void RootEstimate(const UInt<value_size> & value, uint bits, uint n)
+	{
+		uint shift = (bits > TTMATH_BITS_PER_UINT) ? bits - TTMATH_BITS_PER_UINT : 0;
+
+		UInt<value_size> top(value);
+		top.Rcr(shift);
+
+		// the root is 2^lg
+		double lg = ( std::log(double(top.table[0])) / std::log(2.0) + double(shift) ) / double(n);
+		uint root_shift = 0;
+
+		if( lg > double(TTMATH_BITS_PER_UINT - 16) )
+			root_shift = uint(lg) - (TTMATH_BITS_PER_UINT - 16);
+
+		double root = std::pow(2.0, lg - double(root_shift)) * (1.0 + 1e-6) + 1.0;
+
+		SetZero();
+		table[0] = uint(root);
+		Rcl(root_shift);
+	}
+
+
+	/*!
+		returns true if a small value p is a prime number
+	*/
+	static bool IsPrimeWord(uint p)
+	{
+		if( p < 4 )
+			return p >= 2;
+
+		if( (p & 1) == 0 )
+			return false;
+
+		for(uint d = 3 ; d * d <= p ; d += 2)
+			if( p % d == 0 )
+				return false;
+
+	return true;
+	}
+
+
+public:
+
+
+	/*!
+		this method sets n first bits to value zero
+
+		For example:
+		let n=2 then if there's a value 111 (bin) there'll be '100' (bin)
+	*/
+	void ClearFirstBits(uint n)
+	{
+		if( n >= value_size*TTMATH_BITS_PER_UINT )
+		{
+			SetZero();
+			TTMATH_LOG("UInt::ClearFirstBits")
+			return;
+		}
+
+		uint * p = table;
+
+		// first we're clearing the whole words
+		while( n >= TTMATH_BITS_PER_UINT )
+		{
+			*p++ = 0;
+			n   -= TTMATH_BITS_PER_UINT;
+		}
+
+		if( n == 0 )
+		{
+			TTMATH_LOG("UInt::ClearFirstBits")
+			return;
+		}
+
+		// and then we're clearing one word which has left
+		// mask -- all bits are set to one
+		uint mask = TTMATH_UINT_MAX_VALUE;
+
+		mask = mask << n;
+
+		(*p) &= mask;
+
+		TTMATH_LOG("UInt::ClearFirstBits")
+	}
+
+
+	/*!
+		this method returns true if the highest bit of the value is set
+	*/
+	bool IsTheHighestBitSet() const
+	{
+		return (table[value_size-1] & TTMATH_UINT_HIGHEST_BIT) != 0;
+	}
+
+
+	/*!
+		this method returns true if the lowest bit of the value is set
+	*/
+	bool IsTheLowestBitSet() const
+	{
+		return (*table & 1) != 0;
+	}
+
+
+	/*!
+		returning true if only the highest bit is set
+	*/
+	bool IsOnlyTheHighestBitSet() const
+	{
+#ifdef __clang__
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wtautological-compare"
+#endif
+
+		for(uint i=0 ; i<value_size-1 ; ++i)
+			if( table[i] != 0 )
+				return false;
+
+#ifdef __clang__
+#pragma clang diagnostic pop
+#endif
+		if( table[value_size-1] != TTMATH_UINT_HIGHEST_BIT )
+			return false;
+
+	return true;
+	}
+
+
+	/*!
+		returning true if only the lowest bit is set
+	*/
+	bool IsOnlyTheLowestBitSet() const
+	{
+		if( table[0] != 1 )
+			return false;
+
+		for(uint i=1 ; i<value_size ; ++i)
+			if( table[i] != 0 )
+				return false;
+
+	return true;
+	}
+
+
+	/*!
+		this method returns true if the value is equal zero
+	*/
+	bool IsZero() const
+	{
+		for(uint i=0 ; i<value_size ; ++i)
+			if(table[i] != 0)
+				return false;
+
+	return true;
+	}
+
+
+	/*!
+		returning true if first 'bits' bits are equal zero
+	*/
+	bool AreFirstBitsZero(uint bits) const
+	{
+		TTMATH_ASSERT( bits <= value_size * TTMATH_BITS_PER_UINT )
+
+		uint index = bits / TTMATH_BITS_PER_UINT;
+		uint rest  = bits % TTMATH_BITS_PER_UINT;
+		uint i;
+
+		for(i=0 ; i<index ; ++i)
+			if(table[i] != 0 )
+				return false;
+
+		if( rest == 0 )
+			return true;
+
+		uint mask = TTMATH_UINT_MAX_VALUE >> (TTMATH_BITS_PER_UINT - rest);
+
+	return (table[i] & mask) == 0;
+	}
+
+
+
+	/*!
+	*
+	*	conversion methods
+	*
+	*/
+
+
+
+	/*!
+		this method converts an UInt<another_size> type to this class
+
+		this operation has mainly sense if the value from p is 
+		equal or smaller than that one which is returned from UInt<value_size>::SetMax()
+
+		it returns a carry if the value 'p' is too big
+	*/
+	template<uint argument_size>
+	uint FromUInt(const UInt<argument_size> & p)
+	{
+		uint min_size = (value_size < argument_size)? value_size : argument_size;
+		uint i;
+
+		for(i=0 ; i<min_size ; ++i)
+			table[i] = p.table[i];
+
+
+		if( value_size > argument_size )
+		{	
+			// 'this' is longer than 'p'
+
+			for( ; i<value_size ; ++i)
+				table[i] = 0;
+		}
+		else
+		{
+			for( ; i<argument_size ; ++i)
+				if( p.table[i] != 0 )
+				{
+					TTMATH_LOGC("UInt::FromUInt(UInt<>)", 1)
+					return 1;
+				}
+		}
+
+		TTMATH_LOGC("UInt::FromUInt(UInt<>)", 0)
+
+	return 0;
+	}
+
+
+	/*!
+		this method converts an UInt<another_size> type to this class
+
+		this operation has mainly sense if the value from p is 
+		equal or smaller than that one which is returned from UInt<value_size>::SetMax()
+
+		it returns a carry if the value 'p' is too big
+	*/
+	template<uint argument_size>
+	uint FromInt(const UInt<argument_size> & p)
+	{
+		return FromUInt(p);
+	}
+
+
+	/*!
+		this method converts the uint type to this class
+	*/
+	uint FromUInt(uint value)
+	{
+		for(uint i=1 ; i<value_size ; ++i)
+			table[i] = 0;
+
+		table[0] = value;
+
+		TTMATH_LOG("UInt::FromUInt(uint)")
+
+		// there'll never be a carry here
+	return 0;
+	}
+
+
+	/*!
+		this method converts the uint type to this class
+	*/
+	uint FromInt(uint value)
+	{
+		return FromUInt(value);
+	}
+
+
+	/*!
+		this method converts the sint type to this class
+	*/
+	uint FromInt(sint value)
+	{
+		uint c = FromUInt(uint(value));
+
+		if( c || value < 0 )
+			return 1;
+
+	return 0;
+	}
+
+
+	/*!
+		this operator converts an UInt<another_size> type to this class
+
+		it doesn't return a carry
+	*/
+	template<uint argument_size>
+	UInt<value_size> & operator=(const UInt<argument_size> & p)
+	{
+		FromUInt(p);
+
+	return *this;
+	}
+
+
+	/*!
+		the assignment operator
+	*/
+	UInt<value_size> & operator=(const UInt<value_size> & p)
+	{
+		for(uint i=0 ; i<value_size ; ++i)
+			table[i] = p.table[i];
+
+		TTMATH_LOG("UInt::operator=(UInt<>)")
+
+		return *this;
+	}
+
+
+	/*!
+		this method converts the uint type to this class
+	*/
+	UInt<value_size> & operator=(uint i)
+	{
+		FromUInt(i);
+
+	return *this;
+	}
+
+
+	/*!
+		a constructor for converting the uint to this class
+	*/
+	UInt(uint i)
+	{
+		FromUInt(i);
+	}
+
+
+	/*!
+		this method converts the sint type to this class
+	*/
+	UInt<value_size> & operator=(sint i)
+	{
+		FromInt(i);
+
+	return *this;
+	}
+
+
+	/*!
+		a constructor for converting the sint to this class
+
+		look at the description of UInt::operator=(sint)
+	*/
+	UInt(sint i)
+	{
+		FromInt(i);
+	}
+
+
+#ifdef TTMATH_PLATFORM32
+
+
+	/*!
+		this method converts unsigned 64 bit int type to this class
+		***this method is created only on a 32bit platform***
+	*/
+	uint FromUInt(ulint n)
+	{
+		table[0] = (uint)n;
+
+		if( value_size == 1 )
+		{
+			uint c = ((n >> TTMATH_BITS_PER_UINT) == 0) ? 0 : 1;
+
+			TTMATH_LOGC("UInt::FromUInt(ulint)", c)
+			return c;
+		}
+
+		table[1] = (uint)(n >> TTMATH_BITS_PER_UINT);
+
+		for(uint i=2 ; i<value_size ; ++i)
+			table[i] = 0;
+
+		TTMATH_LOG("UInt::FromUInt(ulint)")
+
+	return 0;
+	}
+
+
+	/*!
+		this method converts unsigned 64 bit int type to this class
+		***this method is created only on a 32bit platform***
+	*/
+	uint FromInt(ulint n)
+	{
+		return FromUInt(n);
+	}
+
+
+	/*!
+		this method converts signed 64 bit int type to this class
 		***this method is created only on a 32bit platform***
 	*/
-	uint FromInt(slint n)
+	uint FromInt(slint n)
+	{
+		uint c = FromUInt(ulint(n));
+
+		if( c || n < 0 )
+			return 1;
+
+	return 0;
+	}
+
+
+	/*!
+		this operator converts unsigned 64 bit int type to this class
+		***this operator is created only on a 32bit platform***
+	*/
+	UInt<value_size> & operator=(ulint n)
+	{
+		FromUInt(n);
+
+	return *this;
+	}
+
+
+	/*!
+		a constructor for converting unsigned 64 bit int to this class
+		***this constructor is created only on a 32bit platform***
+	*/
+	UInt(ulint n)
+	{
+		FromUInt(n);
+	}
+
+
+	/*!
+		this operator converts signed 64 bit int type to this class
+		***this operator is created only on a 32bit platform***
+	*/
+	UInt<value_size> & operator=(slint n)
+	{
+		FromInt(n);
+
+	return *this;
+	}
+
+
+	/*!
+		a constructor for converting signed 64 bit int to this class
+		***this constructor is created only on a 32bit platform***
+	*/
+	UInt(slint n)
+	{
+		FromInt(n);
+	}
+
+#endif
+
+
+
+#ifdef TTMATH_PLATFORM64
+
+
+	/*!
+		this method converts 32 bit unsigned int type to this class
+		***this operator is created only on a 64bit platform***
+	*/
+	uint FromUInt(unsigned int i)
+	{
+		return FromUInt(uint(i));
+	}
+
+	/*!
+		this method converts 32 bit unsigned int type to this class
+		***this operator is created only on a 64bit platform***
+	*/
+	uint FromInt(unsigned int i)
+	{
+		return FromUInt(uint(i));
+	}
+
+
+	/*!
+		this method converts 32 bit signed int type to this class
+		***this operator is created only on a 64bit platform***
+	*/
+	uint FromInt(signed int i)
+	{
+		return FromInt(sint(i));
+	}
+
+
+	/*!
+		this operator converts 32 bit unsigned int type to this class
+		***this operator is created only on a 64bit platform***
+	*/
+	UInt<value_size> & operator=(unsigned int i)
+	{
+		FromUInt(i);
+
+	return *this;
+	}
+
+
+	/*!
+		a constructor for converting 32 bit unsigned int to this class
+		***this constructor is created only on a 64bit platform***
+	*/
+	UInt(unsigned int i)
+	{
+		FromUInt(i);
+	}
+
+
+	/*!
+		an operator for converting 32 bit signed int to this class
+		***this constructor is created only on a 64bit platform***
+	*/
+	UInt<value_size> & operator=(signed int i)
+	{
+		FromInt(i);
+
+	return *this;
+	}
+
+
+	/*!
+		a constructor for converting 32 bit signed int to this class
+		***this constructor is created only on a 64bit platform***
+	*/
+	UInt(signed int i)
+	{
+		FromInt(i);
+	}
+
+
+#endif
+
+
+
+
+
+	/*!
+		a constructor for converting a string to this class (with the base=10)
+	*/
+	UInt(const char * s)
+	{
+		FromString(s);
+	}
+
+
+	/*!
+		a constructor for converting a string to this class (with the base=10)
+	*/
+	UInt(const std::string & s)
+	{
+		FromString( s.c_str() );
+	}
+
+
+#ifndef TTMATH_DONT_USE_WCHAR
+
+	/*!
+		a constructor for converting a string to this class (with the base=10)
+	*/
+	UInt(const wchar_t * s)
+	{
+		FromString(s);
+	}
+
+
+	/*!
+		a constructor for converting a string to this class (with the base=10)
+	*/
+	UInt(const std::wstring & s)
+	{
+		FromString( s.c_str() );
+	}
+
+#endif
+
+
+
+
+	/*!
+		a default constructor
+
+		we don't clear the table
+	*/
+	UInt()
+	{
+	// when macro TTMATH_DEBUG_LOG is defined
+	// we set special values to the table
+	// in order to be everywhere the same value of the UInt object
+	// without this it would be difficult to analyse the log file
+	#ifdef TTMATH_DEBUG_LOG
+		#ifdef TTMATH_PLATFORM32
+				for(uint i=0 ; i<value_size ; ++i)
+					table[i] = 0xc1c1c1c1;
+		#else
+				for(uint i=0 ; i<value_size ; ++i)
+					table[i] = 0xc1c1c1c1c1c1c1c1;
+		#endif
+	#endif
+	}
+
+
+	/*!
+		a copy constructor
+	*/
+	UInt(const UInt<value_size> & u)
+	{
+		for(uint i=0 ; i<value_size ; ++i)
+			table[i] = u.table[i];
+
+		TTMATH_LOG("UInt::UInt(UInt<>)")
+	}
+
+
+
+	/*!
+		a template for producting constructors for copying from another types
+	*/
+	template<uint argument_size>
+	UInt(const UInt<argument_size> & u)
+	{
+		// look that 'size' we still set as 'value_size' and not as u.value_size
+		FromUInt(u);
+	}
+
+
+
+
+	/*!
+		a destructor
+	*/
+	~UInt()
+	{
+	}
+
+
+	/*!
+		this method returns the lowest value from table
+
+		we must be sure when we using this method whether the value
+		will hold in an uint type or not (the rest value from the table must be zero)
+	*/
+	uint ToUInt() const
+	{
+		return table[0];
+	}
+
+
+	/*!
+		this method converts the value to uint type
+		can return a carry if the value is too long to store it in uint type
+	*/
+	uint ToUInt(uint & result) const
+	{
+		result = table[0];
+
+		for(uint i=1 ; i<value_size ; ++i)
+			if( table[i] != 0 )
+				return 1;
+
+	return 0;
+	}
+
+
+	/*!
+		this method converts the value to uint type
+		can return a carry if the value is too long to store it in uint type
+	*/
+	uint ToInt(uint & result) const
+	{
+		return ToUInt(result);
+	}
+
+
+	/*!
+		this method converts the value to sint type (signed integer)
+		can return a carry if the value is too long to store it in sint type
+	*/
+	uint ToInt(sint & result) const
+	{
+		result = sint(table[0]);
+
+		if( (result & TTMATH_UINT_HIGHEST_BIT) != 0 )
+			return 1;
+
+		for(uint i=1 ; i<value_size ; ++i)
+			if( table[i] != 0 )
+				return 1;
+
+	return 0;
+	}
+
+
+#ifdef TTMATH_PLATFORM32
+
+	/*!
+		this method converts the value to ulint type (64 bit unsigned integer)
+		can return a carry if the value is too long to store it in ulint type
+		*** this method is created only on a 32 bit platform ***
+	*/
+	uint ToUInt(ulint & result) const
 	{
-		uint c = FromUInt(ulint(n));
+		if( value_size == 1 )
+		{
+			result = table[0];
+		}
+		else
+		{
+			uint low  = table[0];
+			uint high = table[1];
+
+			result = low;
+			result |= (ulint(high) << TTMATH_BITS_PER_UINT);
+
+			for(uint i=2 ; i<value_size ; ++i)
+				if( table[i] != 0 )
+					return 1;
+		}
+
+	return 0;
+	}
+
+
+	/*!
+		this method converts the value to ulint type (64 bit unsigned integer)
+		can return a carry if the value is too long to store it in ulint type
+		*** this method is created only on a 32 bit platform ***
+	*/
+	uint ToInt(ulint & result) const
+	{
+		return ToUInt(result);
+	}
+
+
+	/*!
+		this method converts the value to slint type (64 bit signed integer)
+		can return a carry if the value is too long to store it in slint type
+		*** this method is created only on a 32 bit platform ***
+	*/
+	uint ToInt(slint & result) const
+	{
+	ulint temp;
+
+		uint c = ToUInt(temp);
+		result = slint(temp);
+
+		if( c || result < 0 )
+			return 1;
+
+	return 0;
+	}
+
+#endif
+
+
+
+#ifdef TTMATH_PLATFORM64
+
+	/*!
+		this method converts the value to a 32 unsigned integer
+		can return a carry if the value is too long to store it in this type
+		*** this method is created only on a 64 bit platform ***
+	*/
+	uint ToUInt(unsigned int & result) const
+	{
+		result = (unsigned int)table[0];
+
+		if( (table[0] >> 32) != 0 )
+			return 1;
+
+		for(uint i=1 ; i<value_size ; ++i)
+			if( table[i] != 0 )
+				return 1;
+
+	return 0;
+	}
+
+
+	/*!
+		this method converts the value to a 32 unsigned integer
+		can return a carry if the value is too long to store it in this type
+		*** this method is created only on a 64 bit platform ***
+	*/
+	uint ToInt(unsigned int & result) const
+	{
+		return ToUInt(result);
+	}
+
+
+	/*!
+		this method converts the value to a 32 signed integer
+		can return a carry if the value is too long to store it in this type
+		*** this method is created only on a 64 bit platform ***
+	*/
+	uint ToInt(int & result) const
+	{
+	unsigned int temp;
+
+		uint c = ToUInt(temp);
+		result = int(temp);
+
+		if( c || result < 0 )
+			return 1;
+
+	return 0;
+	}
+
+
+#endif
+
+
+
+
+protected:
+
+	/*!
+		an auxiliary method for converting into the string
+		it returns the log (with the base 2) from x
+		where x is in <2;16>
+	*/
+	double ToStringLog2(uint x) const
+	{
+		static double log_tab[] = {
+			1.000000000000000000,
+			0.630929753571457437,
+			0.500000000000000000,
+			0.430676558073393050,
+			0.386852807234541586,
+			0.356207187108022176,
+			0.333333333333333333,
+			0.315464876785728718,
+			0.301029995663981195,
+			0.289064826317887859,
+			0.278942945651129843,
+			0.270238154427319741,
+			0.262649535037193547,
+			0.255958024809815489,
+			0.250000000000000000
+		};
+
+		if( x<2 || x>16 )
+			return 0;
+
+	return log_tab[x-2];
+	}
+
+
+public:
+
+
+	/*!	
+		an auxiliary method for converting to a string
+		it's used from Int::ToString() too (negative is set true then)
+
+		if 'allocate' is false the divide and conquer algorithm is not used
+		(it needs some memory for the powers of the base)
+	*/
+	template<class string_type>
+	void ToStringBase(string_type & result, uint b = 10, bool negative = false, bool allocate = true) const
+	{
+	UInt<value_size> temp(*this);
+	uint table_id, index, digits, bk, k, bits, d, v;
+	double digits_d;
+
+		result.clear();
+
+		if( b<2 || b>16 )
+			return;
+
+		if( !FindLeadingBit(table_id, index) )
+		{
+			result = '0';
+			return;
+		}
+
+		if( negative )
+			result = '-';
+
+		digits_d  = static_cast<double>(table_id); // for not making an overflow in uint type
+		digits_d *= TTMATH_BITS_PER_UINT;
+		digits_d += index + 1;
+		digits_d *= ToStringLog2(b);
+		digits = static_cast<uint>(digits_d) + 3; // plus some epsilon
+
+		if( result.capacity() < digits )
+			result.reserve(digits);
+
+		// bk = b^k is the greatest power of b which fits in one word,
+		// we're dividing by bk (by its reciprocal calculated only once)
+		// and then the k digits are taken from the remainder
+		for(bk=b, k=1 ; bk <= TTMATH_UINT_MAX_VALUE / b ; bk*=b, ++k);
+
+		bits = TTMATH_BITS_PER_UINT - 1 - (uint)FindLeadingBitInWord(bk);
+		d    = bk << bits;
+		v    = Div_WordReciprocal(d);
+
+		// the digits are appended from the lowest one
+		if( allocate && table_id + 1 >= TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE )
+			temp.ToStringBase_DivideAndConquer(result, b, bk, k, d, v, bits);
+		else
+			temp.ToStringBase_Basecase(result, b, k, d, v, bits, 0);
+
+		size_t i1 = negative ? 1 : 0; // the first is a hyphen (when negative is true)
+		size_t i2 = result.size() - 1;
+
+		for( ; i1 < i2 ; ++i1, --i2 )
+		{
+			char tempc = static_cast<char>(result[i1]);
+			result[i1] = result[i2];
+			result[i2] = tempc;
+		}
+	}
+
+
+
+private:
+
+	/*!
+		an auxiliary method for converting to a string
+		it appends the digits of this value to 'result' (the lowest digit first),
+		at least 'min_digits' digits are appended (the rest is filled with zeroes)
+
+		bk = b^k is the greatest power of b which fits in one word,
+		d = bk << bits is normalized and v is its reciprocal (Div_WordReciprocal()),
+		this is zero after the conversion
+	*/
+	template<class string_type>
+	void ToStringBase_Basecase(string_type & result, uint b, uint k, uint d, uint v, uint bits, uint min_digits)
+	{
+	uint rest, size, min_chunk, n, digits = 0;
+	char chunk[TTMATH_BITS_PER_UINT];
+
+		for(size=value_size ; size>0 && table[size-1]==0 ; --size);
+
+		do
+		{
+			rest = DivInt_Reciprocal(d, v, bits, size);
+
+			for( ; size>0 && table[size-1]==0 ; --size);
+
+			// the highest part has no leading zeroes (if min_digits is not reached)
+			min_chunk = (size > 0) ? k : ((min_digits > digits) ? min_digits - digits : 0);
+
+			if( b == 10 )
+				n = ToStringBase_ChunkDigits<10>(rest, b, min_chunk, k, chunk);
+			else
+			if( b == 16 )
+				n = ToStringBase_ChunkDigits<16>(rest, b, min_chunk, k, chunk);
+			else
+				n = ToStringBase_ChunkDigits<0>(rest, b, min_chunk, k, chunk);
+
+			result.append(chunk, chunk + n);
+			digits += n;
+		}
+		while( size > 0 || digits < min_digits );
+	}
+
+
+	/*!
+		an auxiliary method for converting to a string
+		it puts the digits of 'rest' to 'chunk' (the lowest digit first) and returns how many,
+		at least min_digits and at most max_digits digits are put
+
+		when 'base' is given (not zero) the compiler can make the division by a constant
+		(a multiplication) instead of the div instruction
+	*/
+	template<uint base>
+	static uint ToStringBase_ChunkDigits(uint rest, uint b, uint min_digits, uint max_digits, char * chunk)
+	{
+	const uint bb = (base != 0) ? base : b;
+	uint i, q;
+
+		for(i=0 ; i<max_digits && (rest != 0 || i < min_digits) ; ++i)
+		{
+			q        = rest / bb;
+			chunk[i] = static_cast<char>(Misc::DigitToChar(rest - q * bb));
+			rest     = q;
+		}
+
+	return i;
+	}
+
+
+	/*!
+		an auxiliary method for converting to a string (the divide and conquer algorithm)
+
+		the powers power[i] = bk^(2^i) are calculated once (while they are not greater than
+		this value), then the value is split: this = q * power[j] + r  (r has exactly k*2^j digits)
+		and both parts are converted recursively by ToStringBase_Split(),
+		all the values are divided by the same powers so they are precomputed by UIntDivisor
+		(a big power is divided by multiplying by its reciprocal and the conversion is subquadratic)
+
+		this is zero after the conversion
+	*/
+	template<class string_type>
+	void ToStringBase_DivideAndConquer(string_type & result, uint b, uint bk, uint k, uint d, uint v, uint bits)
+	{
+	std::vector<UInt<value_size> > power;
+	UInt<value_size> next;
+	uint i;
+
+		next = bk;
+
+		do
+		{
+			power.push_back(next);
+			next = power.back();
+		}
+		while( next.Sqr() == 0 && next <= *this );
+
+		std::vector<UIntDivisor<value_size> > divisor(power.size());
 
-		if( c || n < 0 )
-			return 1;
+		for(i=0 ; i<power.size() ; ++i)
+			divisor[i].Set(power[i]);
 
-	return 0;
+		ToStringBase_Split(result, &divisor[0], uint(divisor.size()), b, k, d, v, bits, 0);
 	}
 
 
 	/*!
-		this operator converts unsigned 64 bit int type to this class
-		***this operator is created only on a 32bit platform***
+		an auxiliary method for converting to a string (the recursion step
+		in ToStringBase_DivideAndConquer())
+
+		this < power[j]^2 (or power[j] is the last power which could be calculated),
+		the powers power[0]...power[j-1] are used here
 	*/
-	UInt<value_size> & operator=(ulint n)
+	template<class string_type>
+	void ToStringBase_Split(string_type & result, const UIntDivisor<value_size> * power, uint j,
+							uint b, uint k, uint d, uint v, uint bits, uint min_digits)
 	{
-		FromUInt(n);
+	UInt<value_size> rest;
+	uint size, rest_digits;
 
-	return *this;
+		for(size=value_size ; size>0 && table[size-1]==0 ; --size);
+
+		// a value smaller than power[j-1] is not split at this level
+		// (if it would not have to be padded by more than k*2^(j-1) zeroes)
+		while( j > 0 && min_digits <= (k << (j-1)) && *this < power[j-1].GetDivisor() )
+			--j;
+
+		if( j == 0 || size < TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE )
+		{
+			ToStringBase_Basecase(result, b, k, d, v, bits, min_digits);
+			return;
+		}
+
+		--j;
+		rest_digits = k << j; // the remainder has k*2^j digits (with leading zeroes)
+		power[j].Div(*this, rest);
+
+		rest.ToStringBase_Split(result, power, j, b, k, d, v, bits, rest_digits);
+		ToStringBase_Split(result, power, j, b, k, d, v, bits, (min_digits > rest_digits) ? min_digits - rest_digits : 0);
 	}
 
 
-	/*!
-		a constructor for converting unsigned 64 bit int to this class
-		***this constructor is created only on a 32bit platform***
+public:
+
+
+	/*!	
+		this method converts the value to a string with a base equal 'b'
 	*/
-	UInt(ulint n)
+	void ToString(std::string & result, uint b = 10) const
 	{
-		FromUInt(n);
+		return ToStringBase(result, b);
+	}
+
+
+	std::string ToString(uint b = 10) const
+	{
+		std::string result;
+		ToStringBase(result, b);
+	
+	return result;
+	}
+
+
+#ifndef TTMATH_DONT_USE_WCHAR
+
+	void ToString(std::wstring & result, uint b = 10) const
+	{
+		return ToStringBase(result, b);
+	}
+
+	std::wstring ToWString(uint b = 10) const
+	{
+		std::wstring result;
+		ToStringBase(result, b);
+	
+	return result;
 	}
 
+#endif
+
 
 	/*!
-		this operator converts signed 64 bit int type to this class
-		***this operator is created only on a 32bit platform***
+		an auxiliary method for converting to a char buffer
+		it's used from Int::ToChars() too (negative is set true then)
+
+		no memory is allocated here, the divide and conquer algorithm is not used
+		so ToString() is faster for very big values
 	*/
-	UInt<value_size> & operator=(slint n)
+	ToCharsResult ToCharsBase(char * first, char * last, uint b, bool negative) const
 	{
-		FromInt(n);
+	ToCharsResult res;
 
-	return *this;
+		if( b<2 || b>16 )
+		{
+			res.ptr = first;
+			res.ec  = err_improper_argument;
+			return res;
+		}
+
+		res.ptr = last;
+		res.ec  = err_overflow;
+
+		if( first >= last )
+			return res;
+
+		BufferString<char> result(first, size_t(last - first));
+		ToStringBase(result, b, negative, false);
+
+		if( !result.Overflow() )
+		{
+			res.ptr = first + result.size();
+			res.ec  = err_ok;
+		}
+
+	return res;
 	}
 
 
 	/*!
-		a constructor for converting signed 64 bit int to this class
-		***this constructor is created only on a 32bit platform***
+		this method converts the value to a string with a base equal 'b'
+		and puts it into the buffer first...last-1 (without a terminating zero),
+		similar to std::to_chars()
+
+		no memory is allocated, if the buffer is too small then err_overflow is returned
+		(ToCharsResult is defined in ttmathtypes.h)
 	*/
-	UInt(slint n)
+	ToCharsResult ToChars(char * first, char * last, uint b = 10) const
 	{
-		FromInt(n);
+		return ToCharsBase(first, last, b, false);
 	}
 
-#endif
 
 
+private:
 
-#ifdef TTMATH_PLATFORM64
+	/*!
+		an auxiliary method for converting from a string
+		this = this * x + y  (only the lowest 'size' words are used, 'size' is updated)
+		it returns a carry
+	*/
+	uint FromStringBase_MulAdd(uint & size, uint x, uint y)
+	{
+	uint i, high, low;
+
+		for(i=0 ; i<size ; ++i)
+		{
+			MulTwoWords(table[i], x, &high, &low);
+			low      += y;
+			y         = high + ((low < y) ? 1 : 0);
+			table[i]  = low;
+		}
+
+		if( y != 0 )
+		{
+			if( size == value_size )
+				return 1;
+
+			table[size++] = y;
+		}
+
+	return 0;
+	}
 
 
 	/*!
-		this method converts 32 bit unsigned int type to this class
-		***this operator is created only on a 64bit platform***
+		an auxiliary method for converting from a string
+		it returns the value of 'len' digits from s (len * log2(b) is not greater than one word)
+		(decimal digits from a char string are converted eight at once)
 	*/
-	uint FromUInt(unsigned int i)
+	template<class char_type>
+	static uint FromStringBase_Chunk(const char_type * s, uint len, uint b)
 	{
-		return FromUInt(uint(i));
+	uint result = 0;
+
+		if( b == 10 )
+			return Misc::DecimalDigitsToUInt(s, len);
+
+		for( ; len > 0 ; --len, ++s)
+			result = result * b + uint(Misc::CharToDigit(*s, b));
+
+	return result;
 	}
 
+
 	/*!
-		this method converts 32 bit unsigned int type to this class
-		***this operator is created only on a 64bit platform***
+		an auxiliary method for converting from a string (the divide and conquer algorithm)
+
+		w[0]...w[m-1] are the chunks of the string in base bk (w[0] is the lowest one),
+		the lower half of the chunks (2^j chunks, 2^j < m) and the higher half are converted
+		recursively and then this = high * power[j] + low,  power[j] = bk^(2^j)
+
+		it returns a carry
 	*/
-	uint FromInt(unsigned int i)
+	uint FromStringBase_Split(const uint * w, uint m, const UInt<value_size> * power, uint bk)
 	{
-		return FromUInt(uint(i));
+	UInt<value_size> low;
+	uint j, half, size, c = 0;
+
+		SetZero();
+
+		if( m < TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE )
+		{
+			for(size=0 ; m > 0 && c == 0 ; --m)
+				c = FromStringBase_MulAdd(size, bk, w[m-1]);
+
+		return c;
+		}
+
+		for(j=0, half=1 ; half*2 < m ; half*=2, ++j);
+
+		c += low.FromStringBase_Split(w, half, power, bk);
+		c += FromStringBase_Split(w + half, m - half, power, bk);
+		c += Mul(power[j]);
+		c += Add(low);
+
+	return (c==0)? 0 : 1;
 	}
 
 
 	/*!
-		this method converts 32 bit signed int type to this class
-		***this operator is created only on a 64bit platform***
+		an auxiliary method for converting from a string when the base is a power of two
+
+		first...first+n-1 are the digits (without leading zeros), each digit has 'bits' bits,
+		the bits are put directly into the table beginning from the last digit (no multiplication)
+
+		it returns a carry if the value is too big
 	*/
-	uint FromInt(signed int i)
+	template<class char_type>
+	uint FromStringBase_BasePow2(const char_type * first, uint n, uint bits)
 	{
-		return FromInt(sint(i));
+	const char_type * s = first + n;
+	uint word = 0, shift = 0, index = 0, digit;
+
+		// the first digit is not zero
+		if( n - 1 > value_size * TTMATH_BITS_PER_UINT ||
+			(n - 1) * bits + uint(FindLeadingBitInWord(Misc::CharToDigit(*first))) >= value_size * TTMATH_BITS_PER_UINT )
+			return 1;
+
+		if( TTMATH_BITS_PER_UINT % bits == 0 )
+		{
+			// 2, 4, 16 - the whole words are made without checking the shift after each digit
+			for( ; uint(s - first) >= TTMATH_BITS_PER_UINT / bits ; ++index )
+			{
+				for(word=0, shift=0 ; shift < TTMATH_BITS_PER_UINT ; shift += bits)
+					word |= Misc::CharToDigit(*--s) << shift;
+
+				table[index] = word;
+			}
+
+			word  = 0;
+			shift = 0;
+		}
+
+		while( s != first )
+		{
+			// the digits have already been checked
+			digit  = Misc::CharToDigit(*--s);
+			word  |= digit << shift;
+			shift += bits;
+
+			if( shift >= TTMATH_BITS_PER_UINT )
+			{
+				table[index++] = word;
+				shift         -= TTMATH_BITS_PER_UINT;
+
+				// the bits of the digit which have not been put into the previous word
+				word = (shift > 0) ? digit >> (bits - shift) : 0;
+			}
+		}
+
+		// if index is equal value_size then 'word' has only the zero bits of the first digit
+		if( shift > 0 && index < value_size )
+			table[index] = word;
+
+	return 0;
 	}
 
 
 	/*!
-		this operator converts 32 bit unsigned int type to this class
-		***this operator is created only on a 64bit platform***
+		an auxiliary method for converting from a string
+
+		the digits are taken in chunks of k digits (bk = b^k is the greatest power of b
+		which fits in one word), when there are at least TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE
+		chunks the divide and conquer algorithm is used: the powers bk^(2^j) are calculated
+		once and the chunks are combined by FromStringBase_Split()
+
+		for the bases 2, 4, 8 and 16 the bits of the digits are copied
+		directly by FromStringBase_BasePow2()
 	*/
-	UInt<value_size> & operator=(unsigned int i)
+	template<class char_type>
+	uint FromStringBase(const char_type * s, uint b = 10, const char_type ** after_source = 0, bool * value_read = 0)
 	{
-		FromUInt(i);
+	const char_type * first;
+	uint n, c;
 
-	return *this;
+		SetZero();
+		Misc::SkipWhiteCharacters(s);
+
+		if( after_source )
+			*after_source = s;
+
+		if( value_read )
+			*value_read = false;
+
+		if( b<2 || b>16 )
+			return 1;
+
+		// leading zeroes are skipped
+		for( ; Misc::CharToDigit(*s, b) == 0 ; ++s)
+			if( value_read )
+				*value_read = true;
+
+		for(first = s ; Misc::CharToDigit(*s, b) != -1 ; ++s)
+			if( value_read )
+				*value_read = true;
+
+		if( after_source )
+			*after_source = s;
+
+		n = uint(s - first);
+
+		if( n == 0 )
+			return 0;
+
+		c = FromStringBase_Digits(first, n, b);
+		TTMATH_LOGC("UInt::FromString", c)
+
+	return c;
 	}
 
 
 	/*!
-		a constructor for converting 32 bit unsigned int to this class
-		***this constructor is created only on a 64bit platform***
+		an auxiliary method for converting from a string
+
+		first...first+n-1 are the digits (already checked, without leading zeroes, n > 0),
+		this should be zero, it returns a carry if the value is too big
 	*/
-	UInt(unsigned int i)
+	template<class char_type>
+	uint FromStringBase_Digits(const char_type * first, uint n, uint b)
 	{
-		FromUInt(i);
+	uint bk, k, m, len, size, i, c = 0;
+
+		if( (b & (b - 1)) == 0 )
+			return FromStringBase_BasePow2(first, n, uint(FindLeadingBitInWord(b)));
+
+		for(bk=b, k=1 ; bk <= TTMATH_UINT_MAX_VALUE / b ; bk*=b, ++k);
+
+		// the number of chunks, the first (the highest) chunk has 'len' digits
+		m   = (n + k - 1) / k;
+		len = n - (m - 1) * k;
+
+		// the highest chunk is not zero so the value is at least bk^(m-1) >= 2^((m-1)*(bk bits - 1))
+		if( m - 1 >= value_size * TTMATH_BITS_PER_UINT / (uint)FindLeadingBitInWord(bk) + 1 )
+			c = 1;
+		else
+		if( m < TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE )
+		{
+			table[0] = FromStringBase_Chunk(first, len, b);
+
+			for(size=1, first += len ; --m > 0 && c == 0 ; first += k)
+				c = FromStringBase_MulAdd(size, bk, FromStringBase_Chunk(first, k, b));
+		}
+		else
+		{
+			std::vector<uint> w(m);
+			std::vector<UInt<value_size> > power;
+			UInt<value_size> next;
+
+			// w[0] is the lowest chunk
+			w[m-1] = FromStringBase_Chunk(first, len, b);
+
+			for(i=m-1, first += len ; i > 0 ; --i, first += k)
+				w[i-1] = FromStringBase_Chunk(first, k, b);
+
+			// the powers bk^i for i=2^j < m, they are not greater than the value
+			// so a carry here means that the value is too big
+			next = bk;
+
+			for(i=1 ; c == 0 ; i*=2)
+			{
+				power.push_back(next);
+
+				if( i*2 >= m )
+					break;
+
+				c = next.Sqr();
+			}
+
+			if( c == 0 )
+				c = FromStringBase_Split(&w[0], m, &power[0], bk);
+		}
+
+	return (c==0)? 0 : 1;
 	}
 
 
+public:
+
+
 	/*!
-		an operator for converting 32 bit signed int to this class
-		***this constructor is created only on a 64bit platform***
+		this method converts a string into its value
+		it returns carry=1 if the value will be too big or an incorrect base 'b' is given
+
+		string is ended with a non-digit value, for example:
+			"12" will be translated to 12
+			as well as:
+			"12foo" will be translated to 12 too
+
+		existing first white characters will be ommited
+
+		if the value from s is too large the rest digits will be skipped
+
+		after_source (if exists) is pointing at the end of the parsed string
+
+		value_read (if exists) tells whether something has actually been read (at least one digit)
 	*/
-	UInt<value_size> & operator=(signed int i)
+	uint FromString(const char * s, uint b = 10, const char ** after_source = 0, bool * value_read = 0)
 	{
-		FromInt(i);
+		return FromStringBase(s, b, after_source, value_read);
+	}
 
-	return *this;
+
+	/*!
+		this method converts a string into its value
+
+		(it returns carry=1 if the value will be too big or an incorrect base 'b' is given)
+	*/
+	uint FromString(const std::string & s, uint b = 10)
+	{
+		return FromString( s.c_str(), b );
 	}
 
 
 	/*!
-		a constructor for converting 32 bit signed int to this class
-		***this constructor is created only on a 64bit platform***
+		an auxiliary method for converting from a char buffer
+		it's used from Int::FromChars() too
+
+		it reads the digits from first...last-1, on success the value is set
+		to 'result' and err_ok is returned
 	*/
-	UInt(signed int i)
+	static FromCharsResult FromCharsBase(const char * first, const char * last, uint b, UInt<value_size> & result)
 	{
-		FromInt(i);
-	}
+	FromCharsResult res;
+	const char * s = first, * digits;
 
+		res.ptr = first;
 
-#endif
+		if( b<2 || b>16 )
+		{
+			res.ec = err_improper_argument;
+			return res;
+		}
 
+		// leading zeroes are skipped
+		for( ; s != last && Misc::CharToDigit(*s, b) == 0 ; ++s);
+		for(digits = s ; s != last && Misc::CharToDigit(*s, b) != -1 ; ++s);
 
+		if( s == first )
+		{
+			res.ec = err_nothing_has_read;
+			return res;
+		}
 
+		res.ptr = s;
+		res.ec  = err_ok;
+		result.SetZero();
 
+		if( s != digits && result.FromStringBase_Digits(digits, uint(s - digits), b) )
+			res.ec = err_overflow;
 
-	/*!
-		a constructor for converting a string to this class (with the base=10)
-	*/
-	UInt(const char * s)
-	{
-		FromString(s);
+	return res;
 	}
 
 
 	/*!
-		a constructor for converting a string to this class (with the base=10)
+		this method converts the digits first...last-1 into the value, similar to std::from_chars()
+
+		the input doesn't have to be ended with a zero, white characters and
+		a plus sign are not accepted, the value is not modified if an error is returned
+		(FromCharsResult is defined in ttmathtypes.h)
 	*/
-	UInt(const std::string & s)
+	FromCharsResult FromChars(const char * first, const char * last, uint b = 10)
 	{
-		FromString( s.c_str() );
-	}
+	UInt<value_size> temp;
 
+		FromCharsResult res = FromCharsBase(first, last, b, temp);
+
+		if( res.ec == err_ok )
+			*this = temp;
+
+	return res;
+	}
 
-#ifndef TTMATH_DONT_USE_WCHAR
 
 	/*!
-		a constructor for converting a string to this class (with the base=10)
+		this operator converts a string into its value (with base = 10)
 	*/
-	UInt(const wchar_t * s)
+	UInt<value_size> & operator=(const char * s)
 	{
 		FromString(s);
+
+	return *this;
 	}
 
 
 	/*!
-		a constructor for converting a string to this class (with the base=10)
+		this operator converts a string into its value (with base = 10)
 	*/
-	UInt(const std::wstring & s)
+	UInt<value_size> & operator=(const std::string & s)
 	{
 		FromString( s.c_str() );
+
+	return *this;
 	}
 
-#endif
 
 
+#ifndef TTMATH_DONT_USE_WCHAR
+
+	/*!
+		this method converts a string into its value
+	*/
+	uint FromString(const wchar_t * s, uint b = 10, const wchar_t ** after_source = 0, bool * value_read = 0)
+	{
+		return FromStringBase(s, b, after_source, value_read);
+	}
 
 
 	/*!
-		a default constructor
+		this method converts a string into its value
 
-		we don't clear the table
+		(it returns carry=1 if the value will be too big or an incorrect base 'b' is given)
 	*/
-	UInt()
+	uint FromString(const std::wstring & s, uint b = 10)
 	{
-	// when macro TTMATH_DEBUG_LOG is defined
-	// we set special values to the table
-	// in order to be everywhere the same value of the UInt object
-	// without this it would be difficult to analyse the log file
-	#ifdef TTMATH_DEBUG_LOG
-		#ifdef TTMATH_PLATFORM32
-				for(uint i=0 ; i<value_size ; ++i)
-					table[i] = 0xc1c1c1c1;
-		#else
-				for(uint i=0 ; i<value_size ; ++i)
-					table[i] = 0xc1c1c1c1c1c1c1c1;
-		#endif
-	#endif
+		return FromString( s.c_str(), b );
 	}
 
 
 	/*!
-		a copy constructor
+		this operator converts a string into its value (with base = 10)
 	*/
-	UInt(const UInt<value_size> & u)
+	UInt<value_size> & operator=(const wchar_t * s)
 	{
-		for(uint i=0 ; i<value_size ; ++i)
-			table[i] = u.table[i];
+		FromString(s);
 
-		TTMATH_LOG("UInt::UInt(UInt<>)")
+	return *this;
 	}
 
 
-
 	/*!
-		a template for producting constructors for copying from another types
+		this operator converts a string into its value (with base = 10)
 	*/
-	template<uint argument_size>
-	UInt(const UInt<argument_size> & u)
+	UInt<value_size> & operator=(const std::wstring & s)
 	{
-		// look that 'size' we still set as 'value_size' and not as u.value_size
-		FromUInt(u);
-	}
+		FromString( s.c_str() );
 
+	return *this;
+	}
 
+#endif
 
 
 	/*!
-		a destructor
+	*
+	*	methods for comparing
+	*
 	*/
-	~UInt()
-	{
-	}
 
 
 	/*!
-		this method returns the lowest value from table
+		this method returns true if 'this' is smaller than 'l'
 
-		we must be sure when we using this method whether the value
-		will hold in an uint type or not (the rest value from the table must be zero)
+		'index' is an index of the first word from will be the comparison performed
+		(note: we start the comparison from back - from the last word, when index is -1 /default/
+		it is automatically set into the last word)
+		I introduced it for some kind of optimization made in the second division algorithm (Div2)
 	*/
-	uint ToUInt() const
+	bool CmpSmaller(const UInt<value_size> & l, sint index = -1) const
 	{
-		return table[0];
-	}
+	sint i;
 
+		if( index==-1 || index>=sint(value_size) )
+			i = value_size - 1;
+		else
+			i = index;
 
-	/*!
-		this method converts the value to uint type
-		can return a carry if the value is too long to store it in uint type
-	*/
-	uint ToUInt(uint & result) const
-	{
-		result = table[0];
 
-		for(uint i=1 ; i<value_size ; ++i)
-			if( table[i] != 0 )
-				return 1;
+		for( ; i>=0 ; --i)
+		{
+			if( table[i] != l.table[i] )
+				return table[i] < l.table[i];
+		}
 
-	return 0;
+	// they're equal
+	return false;
 	}
 
 
+
 	/*!
-		this method converts the value to uint type
-		can return a carry if the value is too long to store it in uint type
+		this method returns true if 'this' is bigger than 'l'
+
+		'index' is an index of the first word from will be the comparison performed
+		(note: we start the comparison from back - from the last word, when index is -1 /default/
+		it is automatically set into the last word)
+
+		I introduced it for some kind of optimization made in the second division algorithm (Div2)
 	*/
-	uint ToInt(uint & result) const
+	bool CmpBigger(const UInt<value_size> & l, sint index = -1) const
 	{
-		return ToUInt(result);
+	sint i;
+
+		if( index==-1 || index>=sint(value_size) )
+			i = value_size - 1;
+		else
+			i = index;
+
+
+		for( ; i>=0 ; --i)
+		{
+			if( table[i] != l.table[i] )
+				return table[i] > l.table[i];
+		}
+
+	// they're equal
+	return false;
 	}
 
 
 	/*!
-		this method converts the value to sint type (signed integer)
-		can return a carry if the value is too long to store it in sint type
+		this method returns true if 'this' is equal 'l'
+
+		'index' is an index of the first word from will be the comparison performed
+		(note: we start the comparison from back - from the last word, when index is -1 /default/
+		it is automatically set into the last word)
 	*/
-	uint ToInt(sint & result) const
+	bool CmpEqual(const UInt<value_size> & l, sint index = -1) const
 	{
-		result = sint(table[0]);
+	sint i;
 
-		if( (result & TTMATH_UINT_HIGHEST_BIT) != 0 )
-			return 1;
+		if( index==-1 || index>=sint(value_size) )
+			i = value_size - 1;
+		else
+			i = index;
 
-		for(uint i=1 ; i<value_size ; ++i)
-			if( table[i] != 0 )
-				return 1;
 
-	return 0;
+		for( ; i>=0 ; --i)
+			if( table[i] != l.table[i] )
+				return false;
+
+	return true;
 	}
 
 
-#ifdef TTMATH_PLATFORM32
 
 	/*!
-		this method converts the value to ulint type (64 bit unsigned integer)
-		can return a carry if the value is too long to store it in ulint type
-		*** this method is created only on a 32 bit platform ***
+		this method returns true if 'this' is smaller than or equal 'l'
+
+		'index' is an index of the first word from will be the comparison performed
+		(note: we start the comparison from back - from the last word, when index is -1 /default/
+		it is automatically set into the last word)
 	*/
-	uint ToUInt(ulint & result) const
+	bool CmpSmallerEqual(const UInt<value_size> & l, sint index=-1) const
 	{
-		if( value_size == 1 )
-		{
-			result = table[0];
-		}
+	sint i;
+
+		if( index==-1 || index>=sint(value_size) )
+			i = value_size - 1;
 		else
-		{
-			uint low  = table[0];
-			uint high = table[1];
+			i = index;
 
-			result = low;
-			result |= (ulint(high) << TTMATH_BITS_PER_UINT);
 
-			for(uint i=2 ; i<value_size ; ++i)
-				if( table[i] != 0 )
-					return 1;
+		for( ; i>=0 ; --i)
+		{
+			if( table[i] != l.table[i] )
+				return table[i] < l.table[i];
 		}
 
-	return 0;
+	// they're equal
+	return true;
 	}
 
 
-	/*!
-		this method converts the value to ulint type (64 bit unsigned integer)
-		can return a carry if the value is too long to store it in ulint type
-		*** this method is created only on a 32 bit platform ***
-	*/
-	uint ToInt(ulint & result) const
-	{
-		return ToUInt(result);
-	}
-
 
 	/*!
-		this method converts the value to slint type (64 bit signed integer)
-		can return a carry if the value is too long to store it in slint type
-		*** this method is created only on a 32 bit platform ***
+		this method returns true if 'this' is bigger than or equal 'l'
+
+		'index' is an index of the first word from will be the comparison performed
+		(note: we start the comparison from back - from the last word, when index is -1 /default/
+		it is automatically set into the last word)
 	*/
-	uint ToInt(slint & result) const
+	bool CmpBiggerEqual(const UInt<value_size> & l, sint index=-1) const
 	{
-	ulint temp;
-
-		uint c = ToUInt(temp);
-		result = slint(temp);
-
-		if( c || result < 0 )
-			return 1;
+	sint i;
 
-	return 0;
-	}
+		if( index==-1 || index>=sint(value_size) )
+			i = value_size - 1;
+		else
+			i = index;
 
-#endif
 
+		for( ; i>=0 ; --i)
+		{
+			if( table[i] != l.table[i] )
+				return table[i] > l.table[i];
+		}
 
+	// they're equal
+	return true;
+	}
 
-#ifdef TTMATH_PLATFORM64
 
-	/*!
-		this method converts the value to a 32 unsigned integer
-		can return a carry if the value is too long to store it in this type
-		*** this method is created only on a 64 bit platform ***
+	/*
+		operators for comparising
 	*/
-	uint ToUInt(unsigned int & result) const
-	{
-		result = (unsigned int)table[0];
 
-		if( (table[0] >> 32) != 0 )
-			return 1;
+	bool operator<(const UInt<value_size> & l) const
+	{
+		return CmpSmaller(l);
+	}
 
-		for(uint i=1 ; i<value_size ; ++i)
-			if( table[i] != 0 )
-				return 1;
 
-	return 0;
+	bool operator>(const UInt<value_size> & l) const
+	{
+		return CmpBigger(l);
 	}
 
 
-	/*!
-		this method converts the value to a 32 unsigned integer
-		can return a carry if the value is too long to store it in this type
-		*** this method is created only on a 64 bit platform ***
-	*/
-	uint ToInt(unsigned int & result) const
+	bool operator==(const UInt<value_size> & l) const
 	{
-		return ToUInt(result);
+		return CmpEqual(l);
 	}
 
 
-	/*!
-		this method converts the value to a 32 signed integer
-		can return a carry if the value is too long to store it in this type
-		*** this method is created only on a 64 bit platform ***
-	*/
-	uint ToInt(int & result) const
+	bool operator!=(const UInt<value_size> & l) const
 	{
-	unsigned int temp;
+		return !operator==(l);
+	}
 
-		uint c = ToUInt(temp);
-		result = int(temp);
 
-		if( c || result < 0 )
-			return 1;
+	bool operator<=(const UInt<value_size> & l) const
+	{
+		return CmpSmallerEqual(l);
+	}
 
-	return 0;
+	bool operator>=(const UInt<value_size> & l) const
+	{
+		return CmpBiggerEqual(l);
 	}
 
 
-#endif
+	/*!
+	*
+	*	standard mathematical operators 
+	*
+	*/
 
+	UInt<value_size> operator-(const UInt<value_size> & p2) const
+	{
+	UInt<value_size> temp(*this);
 
+		temp.Sub(p2);
 
+	return temp;
+	}
 
-protected:
+	UInt<value_size> & operator-=(const UInt<value_size> & p2)
+	{
+		Sub(p2);
 
-	/*!
-		an auxiliary method for converting into the string
-		it returns the log (with the base 2) from x
-		where x is in <2;16>
-	*/
-	double ToStringLog2(uint x) const
+	return *this;
+	}
+
+	UInt<value_size> operator+(const UInt<value_size> & p2) const
 	{
-		static double log_tab[] = {
-			1.000000000000000000,
-			0.630929753571457437,
-			0.500000000000000000,
-			0.430676558073393050,
-			0.386852807234541586,
-			0.356207187108022176,
-			0.333333333333333333,
-			0.315464876785728718,
-			0.301029995663981195,
-			0.289064826317887859,
-			0.278942945651129843,
-			0.270238154427319741,
-			0.262649535037193547,
-			0.255958024809815489,
-			0.250000000000000000
-		};
+	UInt<value_size> temp(*this);
 
-		if( x<2 || x>16 )
-			return 0;
+		temp.Add(p2);
 
-	return log_tab[x-2];
+	return temp;
 	}
 
+	UInt<value_size> & operator+=(const UInt<value_size> & p2)
+	{
+		Add(p2);
 
-public:
+	return *this;
+	}
 
 
-	/*!	
-		an auxiliary method for converting to a string
-		it's used from Int::ToString() too (negative is set true then)
-	*/
-	template<class string_type>
-	void ToStringBase(string_type & result, uint b = 10, bool negative = false) const
+	UInt<value_size> operator*(const UInt<value_size> & p2) const
 	{
 	UInt<value_size> temp(*this);
-	uint rest, table_id, index, digits;
-	double digits_d;
-	char character;
 
-		result.clear();
+		temp.Mul(p2);
 
-		if( b<2 || b>16 )
-			return;
+	return temp;
+	}
 
-		if( !FindLeadingBit(table_id, index) )
-		{
-			result = '0';
-			return;
-		}
 
-		if( negative )
-			result = '-';
+	UInt<value_size> & operator*=(const UInt<value_size> & p2)
+	{
+		Mul(p2);
 
-		digits_d  = static_cast<double>(table_id); // for not making an overflow in uint type
-		digits_d *= TTMATH_BITS_PER_UINT;
-		digits_d += index + 1;
-		digits_d *= ToStringLog2(b);
-		digits = static_cast<uint>(digits_d) + 3; // plus some epsilon
+	return *this;
+	}
 
-		if( result.capacity() < digits )
-			result.reserve(digits);
 
-		do
-		{
-			temp.DivInt(b, &rest);
-			character = static_cast<char>(Misc::DigitToChar(rest));
-			result.insert(result.end(), character);
-		}
-		while( !temp.IsZero() );
+	UInt<value_size> operator/(const UInt<value_size> & p2) const
+	{
+	UInt<value_size> temp(*this);
 
-		size_t i1 = negative ? 1 : 0; // the first is a hyphen (when negative is true)
-		size_t i2 = result.size() - 1;
+		temp.Div(p2);
 
-		for( ; i1 < i2 ; ++i1, --i2 )
-		{
-			char tempc = static_cast<char>(result[i1]);
-			result[i1] = result[i2];
-			result[i2] = tempc;
-		}
+	return temp;
 	}
 
 
-
-	/*!	
-		this method converts the value to a string with a base equal 'b'
-	*/
-	void ToString(std::string & result, uint b = 10) const
+	UInt<value_size> & operator/=(const UInt<value_size> & p2)
 	{
-		return ToStringBase(result, b);
+		Div(p2);
+
+	return *this;
 	}
 
 
-	std::string ToString(uint b = 10) const
+	UInt<value_size> operator%(const UInt<value_size> & p2) const
 	{
-		std::string result;
-		ToStringBase(result, b);
+	UInt<value_size> temp(*this);
+	UInt<value_size> remainder;
 	
-	return result;
-	}
-
-
-#ifndef TTMATH_DONT_USE_WCHAR
+		temp.Div( p2, remainder );
 
-	void ToString(std::wstring & result, uint b = 10) const
-	{
-		return ToStringBase(result, b);
+	return remainder;
 	}
 
-	std::wstring ToWString(uint b = 10) const
+
+	UInt<value_size> & operator%=(const UInt<value_size> & p2)
 	{
-		std::wstring result;
-		ToStringBase(result, b);
+	UInt<value_size> remainder;
 	
-	return result;
+		Div( p2, remainder );
+		operator=(remainder);
+
+	return *this;
 	}
 
-#endif
 
+	/*!
+		Prefix operator e.g ++variable
+	*/
+	UInt<value_size> & operator++()
+	{
+		AddOne();
 
+	return *this;
+	}
 
-private:
 
 	/*!
-		an auxiliary method for converting from a string
+		Postfix operator e.g variable++
 	*/
-	template<class char_type>
-	uint FromStringBase(const char_type * s, uint b = 10, const char_type ** after_source = 0, bool * value_read = 0)
+	UInt<value_size> operator++(int)
 	{
-	UInt<value_size> base( b );
-	UInt<value_size> temp;
-	sint z;
-	uint c = 0;
+	UInt<value_size> temp( *this );
 
-		SetZero();
-		temp.SetZero();
-		Misc::SkipWhiteCharacters(s);
+		AddOne();
 
-		if( after_source )
-			*after_source = s;
+	return temp;
+	}
 
-		if( value_read )
-			*value_read = false;
 
-		if( b<2 || b>16 )
-			return 1;
+	UInt<value_size> & operator--()
+	{
+		SubOne();
+
+	return *this;
+	}
 
 
-		for( ; (z=Misc::CharToDigit(*s, b)) != -1 ; ++s)
-		{
-			if( value_read )
-				*value_read = true;
+	UInt<value_size> operator--(int)
+	{
+	UInt<value_size> temp( *this );
 
-			if( c == 0 )
-			{
-				temp.table[0] = z;
+		SubOne();
 
-				c += Mul(base); // !! IMPROVE ME: there can be used MulInt here
-				c += Add(temp);
-			}
-		}		
+	return temp;
+	}
+
+
+
+	/*!
+	*
+	*	bitwise operators
+	*
+	*/
 
-		if( after_source )
-			*after_source = s;
+	UInt<value_size> operator~() const
+	{
+		UInt<value_size> temp( *this );
 
-		TTMATH_LOGC("UInt::FromString", c)
+		temp.BitNot();
 
-	return (c==0)? 0 : 1;
+	return temp;
 	}
 
 
-public:
+	UInt<value_size> operator&(const UInt<value_size> & p2) const
+	{
+		UInt<value_size> temp( *this );
 
+		temp.BitAnd(p2);
 
-	/*!
-		this method converts a string into its value
-		it returns carry=1 if the value will be too big or an incorrect base 'b' is given
+	return temp;
+	}
 
-		string is ended with a non-digit value, for example:
-			"12" will be translated to 12
-			as well as:
-			"12foo" will be translated to 12 too
 
-		existing first white characters will be ommited
+	UInt<value_size> & operator&=(const UInt<value_size> & p2)
+	{
+		BitAnd(p2);
 
-		if the value from s is too large the rest digits will be skipped
+	return *this;
+	}
 
-		after_source (if exists) is pointing at the end of the parsed string
 
-		value_read (if exists) tells whether something has actually been read (at least one digit)
-	*/
-	uint FromString(const char * s, uint b = 10, const char ** after_source = 0, bool * value_read = 0)
+	UInt<value_size> operator|(const UInt<value_size> & p2) const
 	{
-		return FromStringBase(s, b, after_source, value_read);
-	}
+		UInt<value_size> temp( *this );
 
+		temp.BitOr(p2);
 
-	/*!
-		this method converts a string into its value
+	return temp;
+	}
 
-		(it returns carry=1 if the value will be too big or an incorrect base 'b' is given)
-	*/
-	uint FromString(const std::string & s, uint b = 10)
+
+	UInt<value_size> & operator|=(const UInt<value_size> & p2)
 	{
-		return FromString( s.c_str(), b );
+		BitOr(p2);
+
+	return *this;
 	}
 
 
-	/*!
-		this operator converts a string into its value (with base = 10)
-	*/
-	UInt<value_size> & operator=(const char * s)
+	UInt<value_size> operator^(const UInt<value_size> & p2) const
 	{
-		FromString(s);
+		UInt<value_size> temp( *this );
 
-	return *this;
+		temp.BitXor(p2);
+
+	return temp;
 	}
 
 
-	/*!
-		this operator converts a string into its value (with base = 10)
-	*/
-	UInt<value_size> & operator=(const std::string & s)
+	UInt<value_size> & operator^=(const UInt<value_size> & p2)
 	{
-		FromString( s.c_str() );
+		BitXor(p2);
 
 	return *this;
 	}
 
 
+	UInt<value_size> operator>>(int move) const
+	{
+	UInt<value_size> temp( *this );
 
-#ifndef TTMATH_DONT_USE_WCHAR
+		temp.Rcr(move);
 
-	/*!
-		this method converts a string into its value
-	*/
-	uint FromString(const wchar_t * s, uint b = 10, const wchar_t ** after_source = 0, bool * value_read = 0)
-	{
-		return FromStringBase(s, b, after_source, value_read);
+	return temp;
 	}
 
 
-	/*!
-		this method converts a string into its value
-
-		(it returns carry=1 if the value will be too big or an incorrect base 'b' is given)
-	*/
-	uint FromString(const std::wstring & s, uint b = 10)
+	UInt<value_size> & operator>>=(int move)
 	{
-		return FromString( s.c_str(), b );
+		Rcr(move);
+
+	return *this;
 	}
 
 
-	/*!
-		this operator converts a string into its value (with base = 10)
-	*/
-	UInt<value_size> & operator=(const wchar_t * s)
+	UInt<value_size> operator<<(int move) const
 	{
-		FromString(s);
+	UInt<value_size> temp( *this );
 
-	return *this;
+		temp.Rcl(move);
+
+	return temp;
 	}
 
 
-	/*!
-		this operator converts a string into its value (with base = 10)
-	*/
-	UInt<value_size> & operator=(const std::wstring & s)
+	UInt<value_size> & operator<<=(int move)
 	{
-		FromString( s.c_str() );
+		Rcl(move);
 
 	return *this;
 	}
 
-#endif
-
 
 	/*!
 	*
-	*	methods for comparing
+	*	input/output operators for standard streams
+	*	
+	*	(they are very simple, in the future they should be changed)
 	*
 	*/
 
 
-	/*!
-		this method returns true if 'this' is smaller than 'l'
+private:
 
-		'index' is an index of the first word from will be the comparison performed
-		(note: we start the comparison from back - from the last word, when index is -1 /default/
-		it is automatically set into the last word)
-		I introduced it for some kind of optimization made in the second division algorithm (Div2)
+
+	/*!
+		an auxiliary method for outputing to standard streams
 	*/
-	bool CmpSmaller(const UInt<value_size> & l, sint index = -1) const
+	template<class ostream_type, class string_type>
+	static ostream_type & OutputToStream(ostream_type & s, const UInt<value_size> & l)
 	{
-	sint i;
-
-		if( index==-1 || index>=sint(value_size) )
-			i = value_size - 1;
-		else
-			i = index;
-
+	string_type ss;
 
-		for( ; i>=0 ; --i)
-		{
-			if( table[i] != l.table[i] )
-				return table[i] < l.table[i];
-		}
+		l.ToString(ss);
+		s << ss;
 
-	// they're equal
-	return false;
+	return s;
 	}
 
 
-
 	/*!
-		this method returns true if 'this' is bigger than 'l'
-
-		'index' is an index of the first word from will be the comparison performed
-		(note: we start the comparison from back - from the last word, when index is -1 /default/
-		it is automatically set into the last word)
+		an auxiliary method for outputing to standard streams (char version)
 
-		I introduced it for some kind of optimization made in the second division algorithm (Div2)
+		the value is converted by ToChars() in a buffer on the stack (without allocating
+		memory), very big values and a stream with the width set are output by OutputToStream()
 	*/
-	bool CmpBigger(const UInt<value_size> & l, sint index = -1) const
+	static std::ostream & OutputToStreamChars(std::ostream & s, const UInt<value_size> & l)
 	{
-	sint i;
+		const uint size = value_size;
+		char buffer[(value_size < TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE ? value_size : 1) * TTMATH_BITS_PER_UINT / 3 + 2];
 
-		if( index==-1 || index>=sint(value_size) )
-			i = value_size - 1;
-		else
-			i = index;
+		if( size >= TTMATH_USE_DC_RADIX_CONVERSION_FROM_SIZE || s.width() != 0 )
+			return OutputToStream<std::ostream, std::string>(s, l);
 
+		ToCharsResult res = l.ToChars(buffer, buffer + sizeof(buffer));
 
-		for( ; i>=0 ; --i)
-		{
-			if( table[i] != l.table[i] )
-				return table[i] > l.table[i];
-		}
+		if( res.ec != err_ok )
+			return OutputToStream<std::ostream, std::string>(s, l);
 
-	// they're equal
-	return false;
+		s.write(buffer, res.ptr - buffer);
+
+	return s;
 	}
 
 
-	/*!
-		this method returns true if 'this' is equal 'l'
+public:
 
-		'index' is an index of the first word from will be the comparison performed
-		(note: we start the comparison from back - from the last word, when index is -1 /default/
-		it is automatically set into the last word)
+
+	/*!
+		output to standard streams
 	*/
-	bool CmpEqual(const UInt<value_size> & l, sint index = -1) const
+	friend std::ostream & operator<<(std::ostream & s, const UInt<value_size> & l)
 	{
-	sint i;
-
-		if( index==-1 || index>=sint(value_size) )
-			i = value_size - 1;
-		else
-			i = index;
+		return OutputToStreamChars(s, l);
+	}
 
 
-		for( ; i>=0 ; --i)
-			if( table[i] != l.table[i] )
-				return false;
+#ifndef TTMATH_DONT_USE_WCHAR
 
-	return true;
+	/*!
+		output to standard streams
+	*/
+	friend std::wostream & operator<<(std::wostream & s, const UInt<value_size> & l)
+	{
+		return OutputToStream<std::wostream, std::wstring>(s, l);
 	}
 
+#endif
 
 
-	/*!
-		this method returns true if 'this' is smaller than or equal 'l'
 
-		'index' is an index of the first word from will be the comparison performed
-		(note: we start the comparison from back - from the last word, when index is -1 /default/
-		it is automatically set into the last word)
+private:
+
+	/*!
+		an auxiliary method for reading from standard streams
 	*/
-	bool CmpSmallerEqual(const UInt<value_size> & l, sint index=-1) const
+	template<class istream_type, class string_type, class char_type>
+	static istream_type & InputFromStream(istream_type & s, UInt<value_size> & l)
 	{
-	sint i;
-
-		if( index==-1 || index>=sint(value_size) )
-			i = value_size - 1;
-		else
-			i = index;
-
+	string_type ss;
+	
+	// char or wchar_t for operator>>
+	char_type z;
+	
+		// operator>> omits white characters if they're set for ommiting
+		s >> z;
 
-		for( ; i>=0 ; --i)
+		// we're reading only digits (base=10)
+		while( s.good() && Misc::CharToDigit(z, 10)>=0 )
 		{
-			if( table[i] != l.table[i] )
-				return table[i] < l.table[i];
+			ss += z;
+			z = static_cast<char_type>(s.get());
 		}
 
-	// they're equal
-	return true;
+		// we're leaving the last read character
+		// (it's not belonging to the value)
+		s.unget();
+
+		l.FromString(ss);
+
+	return s;
+	}
+
+public:
+
+
+	/*!
+		input from standard streams
+	*/
+	friend std::istream & operator>>(std::istream & s, UInt<value_size> & l)
+	{
+		return InputFromStream<std::istream, std::string, char>(s, l);
 	}
 
 
+#ifndef TTMATH_DONT_USE_WCHAR
 
 	/*!
-		this method returns true if 'this' is bigger than or equal 'l'
-
-		'index' is an index of the first word from will be the comparison performed
-		(note: we start the comparison from back - from the last word, when index is -1 /default/
-		it is automatically set into the last word)
+		input from standard streams
 	*/
-	bool CmpBiggerEqual(const UInt<value_size> & l, sint index=-1) const
+	friend std::wistream & operator>>(std::wistream & s, UInt<value_size> & l)
 	{
-	sint i;
-
-		if( index==-1 || index>=sint(value_size) )
-			i = value_size - 1;
-		else
-			i = index;
-
-
-		for( ; i>=0 ; --i)
-		{
-			if( table[i] != l.table[i] )
-				return table[i] > l.table[i];
-		}
-
-	// they're equal
-	return true;
+		return InputFromStream<std::wistream, std::wstring, wchar_t>(s, l);
 	}
 
+#endif
+
 
 	/*
-		operators for comparising
+		Following methods are defined in:
+			ttmathuint_x86.h
+			ttmathuint_x86_64.h
+			ttmathuint_noasm.h
 	*/
 
-	bool operator<(const UInt<value_size> & l) const
-	{
-		return CmpSmaller(l);
-	}
+#ifdef TTMATH_NOASM
+	static uint AddTwoWords(uint a, uint b, uint carry, uint * result);
+	static uint SubTwoWords(uint a, uint b, uint carry, uint * result);
 
+#ifdef TTMATH_PLATFORM64
 
-	bool operator>(const UInt<value_size> & l) const
+	union uint_
 	{
-		return CmpBigger(l);
-	}
+		struct 
+		{
+			unsigned int low;  // 32 bit 
+			unsigned int high; // 32 bit
+		} u_;
 
+		uint u;                // 64 bit
+	};
 
-	bool operator==(const UInt<value_size> & l) const
-	{
-		return CmpEqual(l);
-	}
 
+	static void DivTwoWords2(uint a,uint b, uint c, uint * r, uint * rest);
+	static uint DivTwoWordsNormalize(uint_ & a_, uint_ & b_, uint_ & c_);
+	static uint DivTwoWordsUnnormalize(uint u, uint d);
+	static unsigned int DivTwoWordsCalculate(uint_ u_, unsigned int u3, uint_ v_);
+	static void MultiplySubtract(uint_ & u_, unsigned int & u3, unsigned int & q, uint_ v_);
 
-	bool operator!=(const UInt<value_size> & l) const
-	{
-		return !operator==(l);
-	}
+#endif // TTMATH_PLATFORM64
+#endif // TTMATH_NOASM
 
 
-	bool operator<=(const UInt<value_size> & l) const
-	{
-		return CmpSmallerEqual(l);
-	}
+	// UIntDivisor uses Div5_Reciprocal() and Div5_Precomputed()
+	template<uint> friend class UIntDivisor;
 
-	bool operator>=(const UInt<value_size> & l) const
-	{
-		return CmpBiggerEqual(l);
-	}
+	// UIntMontgomery uses Div_Less()
+	template<uint> friend class UIntMontgomery;
 
+private:
+	uint Rcl2_one(uint c);
+	uint Rcr2_one(uint c);
+	uint Rcl2(uint bits, uint c);
+	uint Rcr2(uint bits, uint c);
 
-	/*!
-	*
-	*	standard mathematical operators 
-	*
-	*/
+#ifdef TTMATH_ADX
+	static bool CheckAdx();
+	static uint SqrAddDiagonalAdx(const uint * ss, uint ss_size, uint * result);
+	static uint MulAddVectorAdx(const uint * ss, uint ss_size, uint x, uint * result);
 
-	UInt<value_size> operator-(const UInt<value_size> & p2) const
-	{
-	UInt<value_size> temp(*this);
+public:
+	static bool IsAdxSupported();
+#endif
 
-		temp.Sub(p2);
+#ifdef TTMATH_IFMA
+private:
+	static bool CheckIfma();
+	static void Mul6ToLimbs(const uint * ss, uint ss_size, uint * limbs, uint limbs_size);
+	__attribute__((target("avx512f,avx512ifma")))
+	static void Mul6Big3(const uint * ss1, uint x1size, const uint * ss2, uint x2size, uint * result, uint result_size, uint * buffer);
 
-	return temp;
-	}
+public:
+	static bool IsIfmaSupported();
+#endif
 
-	UInt<value_size> & operator-=(const UInt<value_size> & p2)
-	{
-		Sub(p2);
+public:
+	static const char * LibTypeStr();
+	static LibTypeCode LibType();
+	uint Add(const UInt<value_size> & ss2, uint c=0);
+	uint AddInt(uint value, uint index = 0);
+	uint AddTwoInts(uint x2, uint x1, uint index);
+	static uint AddVector(const uint * ss1, const uint * ss2, uint ss1_size, uint ss2_size, uint * result);
+	uint Sub(const UInt<value_size> & ss2, uint c=0);
+	uint SubInt(uint value, uint index = 0);
+	static uint SubVector(const uint * ss1, const uint * ss2, uint ss1_size, uint ss2_size, uint * result);
+	static uint SqrAddDiagonal(const uint * ss, uint ss_size, uint * result);
+	static uint MulAddVector(const uint * ss, uint ss_size, uint x, uint * result);
+	static uint MulSubVector(const uint * ss, uint ss_size, uint x, uint * result);
+	static sint FindLeadingBitInWord(uint x);
+	static sint FindLowestBitInWord(uint x);
+	static uint SetBitInWord(uint & value, uint bit);
+	static void MulTwoWords(uint a, uint b, uint * result_high, uint * result_low);
+	static void DivTwoWords(uint a,uint b, uint c, uint * r, uint * rest);
 
-	return *this;
-	}
+};
 
-	UInt<value_size> operator+(const UInt<value_size> & p2) const
-	{
-	UInt<value_size> temp(*this);
 
-		temp.Add(p2);
+/*!
+	\brief UIntMontgomery is a Montgomery context for the modular arithmetic with an odd modulus
 
-	return temp;
-	}
+	the values are kept in the Montgomery form: x*R mod n where R = beta^s
+	(beta = 2^TTMATH_BITS_PER_UINT, s - how many words the modulus n has),
+	the product of two such values is reduced by REDC (the Montgomery reduction)
+	which only multiplies and adds vectors (no division is needed)
 
-	UInt<value_size> & operator+=(const UInt<value_size> & p2)
-	{
-		Add(p2);
+	n' = -1/n mod beta, R mod n (one in the Montgomery form) and R^2 mod n
+	are calculated once in Set()
 
-	return *this;
-	}
+	example:
+		UIntMontgomery<4> mont(modulus);
 
+		for(...)
+			mont.PowMod(value[i], exponent); // value[i] = value[i]^exponent mod modulus
+*/
+template<uint value_size>
+class UIntMontgomery
+{
+	// the modulus (odd)
+	UInt<value_size> modulus;
 
-	UInt<value_size> operator*(const UInt<value_size> & p2) const
-	{
-	UInt<value_size> temp(*this);
+	// R mod n (one in the Montgomery form)
+	UInt<value_size> one;
 
-		temp.Mul(p2);
+	// R^2 mod n
+	UInt<value_size> r2;
 
-	return temp;
-	}
+	// -1/n mod beta
+	uint n0;
 
+	// how many words the modulus has (zero if the modulus is not set)
+	uint size;
 
-	UInt<value_size> & operator*=(const UInt<value_size> & p2)
-	{
-		Mul(p2);
 
-	return *this;
-	}
+public:
 
 
-	UInt<value_size> operator/(const UInt<value_size> & p2) const
+	/*!
+		the default constructor
+		the modulus is not set (Set() has to be called)
+	*/
+	UIntMontgomery()
 	{
-	UInt<value_size> temp(*this);
+		modulus.SetZero();
+		one.SetZero();
+		r2.SetZero();
+		n0   = 0;
+		size = 0;
+	}
 
-		temp.Div(p2);
 
-	return temp;
+	/*!
+		a constructor for setting the modulus
+	*/
+	UIntMontgomery(const UInt<value_size> & n)
+	{
+		Set(n);
 	}
 
 
-	UInt<value_size> & operator/=(const UInt<value_size> & p2)
+	/*!
+		setting the modulus and calculating n', R mod n and R^2 mod n
+
+		return values:
+		-  0 - ok
+		-  1 - the modulus is zero or even (the Montgomery reduction needs an odd modulus)
+	*/
+	uint Set(const UInt<value_size> & n)
 	{
-		Div(p2);
+	uint i;
 
-	return *this;
-	}
+		modulus = n;
+		one.SetZero();
+		r2.SetZero();
+		n0 = 0;
 
+		if( (n.table[0] & 1) == 0 )
+		{
+			size = 0;
+			return 1;
+		}
 
-	UInt<value_size> operator%(const UInt<value_size> & p2) const
-	{
-	UInt<value_size> temp(*this);
-	UInt<value_size> remainder;
-	
-		temp.Div( p2, remainder );
+		for(size=value_size ; size>0 && n.table[size-1]==0 ; --size);
 
-	return remainder;
-	}
+		// the inverse of n modulo beta by the Newton iteration, each step
+		// doubles the number of correct bits (n*n = 1 mod 8 so we start with 3 bits)
+		uint inv = n.table[0];
 
+		for(i=3 ; i<TTMATH_BITS_PER_UINT ; i*=2)
+			inv *= 2 - n.table[0] * inv;
 
-	UInt<value_size> & operator%=(const UInt<value_size> & p2)
-	{
-	UInt<value_size> remainder;
-	
-		Div( p2, remainder );
-		operator=(remainder);
+		n0 = uint(0) - inv;
 
-	return *this;
+		// R^2 mod n (R^2 has 2*size+1 words)
+		UInt<value_size*2+1> t, n2, rest;
+
+		t.SetZero();
+		t.table[2*size] = 1;
+		n2 = n;
+		t.Div(n2, rest);
+		r2 = rest;
+
+		// R mod n = REDC(R^2 mod n)
+		one = r2;
+		FromMontgomery(one);
+
+	return 0;
 	}
 
 
 	/*!
-		Prefix operator e.g ++variable
+		returning the modulus
 	*/
-	UInt<value_size> & operator++()
+	const UInt<value_size> & GetModulus() const
 	{
-		AddOne();
-
-	return *this;
+		return modulus;
 	}
 
 
 	/*!
-		Postfix operator e.g variable++
+		returning one in the Montgomery form (R mod n)
 	*/
-	UInt<value_size> operator++(int)
+	const UInt<value_size> & GetOne() const
 	{
-	UInt<value_size> temp( *this );
-
-		AddOne();
-
-	return temp;
+		return one;
 	}
 
 
-	UInt<value_size> & operator--()
+	/*!
+		converting a value into the Montgomery form: a = a*R mod n
+
+		'a' can be greater than the modulus (it is reduced first by UInt::Div())
+	*/
+	void ToMontgomery(UInt<value_size> & a) const
 	{
-		SubOne();
+	uint i;
 
-	return *this;
+		TTMATH_ASSERT( size != 0 )
+
+		for(i=value_size ; i>size && a.table[i-1]==0 ; --i);
+
+		if( i > size || a >= modulus )
+		{
+			UInt<value_size> rest;
+			a.Div(modulus, rest);
+			a = rest;
+		}
+
+		MulMod(a, r2);
 	}
 
 
-	UInt<value_size> operator--(int)
+	/*!
+		converting a value from the Montgomery form: a = a/R mod n
+	*/
+	void FromMontgomery(UInt<value_size> & a) const
 	{
-	UInt<value_size> temp( *this );
+	UInt<value_size*2> t;
 
-		SubOne();
+		TTMATH_ASSERT( size != 0 )
 
-	return temp;
-	}
+		t.SetZero();
+
+		for(uint i=0 ; i<value_size ; ++i)
+			t.table[i] = a.table[i];
 
+		Reduce(t, a);
+	}
 
 
 	/*!
-	*
-	*	bitwise operators
-	*
-	*/
+		the Montgomery multiplication: a = a*b/R mod n
 
-	UInt<value_size> operator~() const
+		'a' and 'b' are in the Montgomery form (they are smaller than the modulus)
+	*/
+	void MulMod(UInt<value_size> & a, const UInt<value_size> & b) const
 	{
-		UInt<value_size> temp( *this );
+	UInt<value_size*2> t;
 
-		temp.BitNot();
+		TTMATH_ASSERT( size != 0 )
 
-	return temp;
+		a.MulBig(b, t);
+		Reduce(t, a);
 	}
 
 
-	UInt<value_size> operator&(const UInt<value_size> & p2) const
+	/*!
+		the Montgomery squaring: a = a*a/R mod n
+
+		'a' is in the Montgomery form (it is smaller than the modulus)
+	*/
+	void SqrMod(UInt<value_size> & a) const
 	{
-		UInt<value_size> temp( *this );
+	UInt<value_size*2> t;
 
-		temp.BitAnd(p2);
+		TTMATH_ASSERT( size != 0 )
 
-	return temp;
+		a.SqrBig(t);
+		Reduce(t, a);
 	}
 
 
-	UInt<value_size> & operator&=(const UInt<value_size> & p2)
+	/*!
+		the modular power: a = a^pow mod n
+
+		'a' and the result are in the normal form (not in the Montgomery form),
+		'a' can be greater than the modulus
+
+		the exponent is scanned from the highest bit by the sliding window method:
+		the odd powers a^1, a^3, ..., a^(2^k - 1) are calculated first and then
+		one multiplication is made for each window of at most k bits
+		(k is selected by the length of the exponent)
+
+		return values:
+		-  0 - ok
+		-  1 - the modulus is not set (zero or even)
+		-  2 - incorrect argument (0^0)
+	*/
+	uint PowMod(UInt<value_size> & a, const UInt<value_size> & pow) const
 	{
-		BitAnd(p2);
+		if( size == 0 )
+			return 1;
 
-	return *this;
-	}
+		if( pow.IsZero() )
+		{
+			if( a.IsZero() )
+				// we don't define zero^zero
+				return 2;
+
+			a = one;
+			FromMontgomery(a);
+
+		return 0;
+		}
 
+		// odd[i] = a^(2*i+1) in the Montgomery form (the window has at most 6 bits)
+		UInt<value_size> odd[32];
+		UInt<value_size> result;
+		uint i, j, w, bits, k;
+		bool first = true;
 
-	UInt<value_size> operator|(const UInt<value_size> & p2) const
-	{
-		UInt<value_size> temp( *this );
+		pow.FindLeadingBit(i, j);
+		bits = i * TTMATH_BITS_PER_UINT + j + 1;
+		k    = PowMod_WindowSize(bits);
 
-		temp.BitOr(p2);
+		odd[0] = a;
+		ToMontgomery(odd[0]);
 
-	return temp;
-	}
+		if( k > 1 )
+		{
+			UInt<value_size> a2(odd[0]);
+			SqrMod(a2);
 
+			for(i=1 ; i < (uint(1) << (k-1)) ; ++i)
+			{
+				odd[i] = odd[i-1];
+				MulMod(odd[i], a2);
+			}
+		}
 
-	UInt<value_size> & operator|=(const UInt<value_size> & p2)
-	{
-		BitOr(p2);
+		for(i=bits ; i-- > 0 ; )
+		{
+			if( !pow.GetBit(i) )
+			{
+				if( !first )
+					SqrMod(result);
 
-	return *this;
-	}
+				continue;
+			}
 
+			// the window is from bit i to bit j (the lowest bit set in the window)
+			j = (i + 1 >= k) ? i + 1 - k : 0;
 
-	UInt<value_size> operator^(const UInt<value_size> & p2) const
-	{
-		UInt<value_size> temp( *this );
+			while( !pow.GetBit(j) )
+				++j;
 
-		temp.BitXor(p2);
+			for(w=0 ; ; --i)
+			{
+				w = (w << 1) | pow.GetBit(i);
 
-	return temp;
-	}
+				if( !first )
+					SqrMod(result);
 
+				if( i == j )
+					break;
+			}
 
-	UInt<value_size> & operator^=(const UInt<value_size> & p2)
-	{
-		BitXor(p2);
+			if( first )
+			{
+				result = odd[w >> 1];
+				first  = false;
+			}
+			else
+			{
+				MulMod(result, odd[w >> 1]);
+			}
+		}
 
-	return *this;
+		FromMontgomery(result);
+		a = result;
+
+	return 0;
 	}
 
 
-	UInt<value_size> operator>>(int move) const
+private:
+
+
+	/*!
+		the size of the window for the sliding window exponentiation
+		(bits - how many bits the exponent has)
+	*/
+	static uint PowMod_WindowSize(uint bits)
 	{
-	UInt<value_size> temp( *this );
+	uint k;
 
-		temp.Rcr(move);
+		if( bits > 671 )
+			k = 6;
+		else
+		if( bits > 239 )
+			k = 5;
+		else
+		if( bits > 79 )
+			k = 4;
+		else
+		if( bits > 23 )
+			k = 3;
+		else
+		if( bits > 7 )
+			k = 2;
+		else
+			k = 1;
 
-	return temp;
+	return k;
 	}
 
 
-	UInt<value_size> & operator>>=(int move)
-	{
-		Rcr(move);
-
-	return *this;
-	}
+	/*!
+		REDC - the Montgomery reduction: result = t/R mod n
 
+		t must be smaller than n*R
 
-	UInt<value_size> operator<<(int move) const
+		in each step the lowest word of t is cleared by adding m*n where m = t[i]*n' mod beta,
+		the row is added by MulAddVector() and its carry is saved in the cleared word,
+		at the end the carries are added to the higher half (the same as in GMP's redc_1)
+	*/
+	void Reduce(UInt<value_size*2> & t, UInt<value_size> & result) const
 	{
-	UInt<value_size> temp( *this );
+	uint i, c;
 
-		temp.Rcl(move);
+		for(i=0 ; i<size ; ++i)
+		{
+			uint m  = t.table[i] * n0;
+			t.table[i] = UInt<value_size>::MulAddVector(modulus.table, size, m, t.table + i);
+		}
 
-	return temp;
+		c = UInt<value_size>::AddVector(t.table + size, t.table, size, size, result.table);
+
+		for(i=size ; i<value_size ; ++i)
+			result.table[i] = 0;
+
+		// the result is smaller than 2*n
+		if( c != 0 || !UInt<value_size>::Div_Less(result.table, modulus.table, size) )
+			UInt<value_size>::SubVector(result.table, modulus.table, size, size, result.table);
 	}
+};
 
 
-	UInt<value_size> & operator<<=(int move)
-	{
-		Rcl(move);
 
-	return *this;
-	}
+/*!
+	this specialization is needed in order to not confuse the compiler "error: ISO C++ forbids zero-size array"
+	when compiling Mul3Big2() method
+*/
+template<>
+class UInt<0>
+{
+public:
+	uint table[1];
 
+	void Mul2Big(const UInt<0> &, UInt<0> &) { TTMATH_ASSERT(false) };
+	void SetZero() { TTMATH_ASSERT(false) };
+	uint AddTwoInts(uint, uint, uint) { TTMATH_ASSERT(false) return 0; };
+};
 
-	/*!
-	*
-	*	input/output operators for standard streams
-	*	
-	*	(they are very simple, in the future they should be changed)
-	*
-	*/
 
 
-private:
+/*!
+	\brief UIntDivisor is a precomputed divisor for dividing many values by the same UInt
+
+	the divisor is normalized (shifted so that its highest bit is set) and its reciprocal
+	is calculated once, then each division is made only by multiplications and a few
+	corrections (the quotient and the remainder are exactly the same as from UInt::Div()):
+	-  a small divisor - the schoolbook division where each quotient word is estimated
+	   by the reciprocal of the highest word of the divisor (no hardware division)
+	-  a divisor with at least TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE words -
+	   Barrett reduction with the reciprocal calculated by the Newton iteration
+	   (the same as in UInt::Div5())
+
+	example:
+		UIntDivisor<4> divisor(modulus);
+
+		for(...)
+			divisor.Mod(value[i]);
+*/
+template<uint value_size>
+class UIntDivisor
+{
+	// the divisor
+	UInt<value_size> divisor;
 
+	// the divisor shifted left by 'bits' (the highest bit in b.table[size-1] is set)
+	UInt<value_size> b;
 
-	/*!
-		an auxiliary method for outputing to standard streams
-	*/
-	template<class ostream_type, class string_type>
-	static ostream_type & OutputToStream(ostream_type & s, const UInt<value_size> & l)
-	{
-	string_type ss;
+	// the reciprocal of b (size+1 words), calculated only when the divisor has
+	// at least TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE words
+	UInt<value_size+1> x;
 
-		l.ToString(ss);
-		s << ss;
+	// the reciprocal of the highest word of b
+	uint v;
 
-	return s;
-	}
+	// how many words the divisor has (zero if the divisor is zero)
+	uint size;
+
+	uint bits;
 
 
 public:
 
 
 	/*!
-		output to standard streams
+		the default constructor
+		the divisor is zero (Div() and Mod() will return 1)
 	*/
-	friend std::ostream & operator<<(std::ostream & s, const UInt<value_size> & l)
+	UIntDivisor()
 	{
-		return OutputToStream<std::ostream, std::string>(s, l);
+		divisor.SetZero();
+		size = 0;
+		bits = 0;
+		v    = 0;
 	}
 
 
-#ifndef TTMATH_DONT_USE_WCHAR
-
 	/*!
-		output to standard streams
+		a constructor for setting the divisor
 	*/
-	friend std::wostream & operator<<(std::wostream & s, const UInt<value_size> & l)
+	UIntDivisor(const UInt<value_size> & d)
 	{
-		return OutputToStream<std::wostream, std::wstring>(s, l);
+		Set(d);
 	}
 
-#endif
-
-
-
-private:
 
 	/*!
-		an auxiliary method for reading from standard streams
+		setting the divisor and calculating its reciprocal
+
+		return values:
+		-  0 - ok
+		-  1 - the divisor is zero
 	*/
-	template<class istream_type, class string_type, class char_type>
-	static istream_type & InputFromStream(istream_type & s, UInt<value_size> & l)
+	uint Set(const UInt<value_size> & d)
 	{
-	string_type ss;
-	
-	// char or wchar_t for operator>>
-	char_type z;
-	
-		// operator>> omits white characters if they're set for ommiting
-		s >> z;
+		divisor = d;
 
-		// we're reading only digits (base=10)
-		while( s.good() && Misc::CharToDigit(z, 10)>=0 )
+		for(size=value_size ; size>0 && d.table[size-1]==0 ; --size);
+
+		if( size == 0 )
 		{
-			ss += z;
-			z = static_cast<char_type>(s.get());
+			bits = 0;
+			v    = 0;
+			return 1;
 		}
 
-		// we're leaving the last read character
-		// (it's not belonging to the value)
-		s.unget();
-
-		l.FromString(ss);
+		bits = TTMATH_BITS_PER_UINT - 1 - (uint)UInt<value_size>::FindLeadingBitInWord(d.table[size-1]);
+		b.SetZero();
+		x.SetZero();
+		UInt<value_size>::Div_ShiftLeft(d.table, size, bits, b.table);
+		v = UInt<value_size>::Div_WordReciprocal(b.table[size-1]);
 
-	return s;
-	}
+		if( size >= TTMATH_USE_NEWTON_PRECOMPUTED_DIVISION_FROM_SIZE )
+		{
+			// the buffer for Div5_Reciprocal() (3*size+8 words and the buffer for UInt::Div_Multiply())
+			const uint stack_size = (7*value_size+8 < TTMATH_STACK_BUFFER_MAX_SIZE) ? 7*value_size+8 : TTMATH_STACK_BUFFER_MAX_SIZE;
+			uint stack_buffer[stack_size];
+			std::vector<uint> heap_buffer;
 
-public:
+			uint * buffer = UInt<value_size>::Div_Buffer(stack_buffer, stack_size, heap_buffer,
+			                                             3*size + 8 + UInt<value_size>::Div_MultiplyBufferSize(size));
 
+			b.Div5_Reciprocal(b.table, size, x.table, buffer);
+		}
 
-	/*!
-		input from standard streams
-	*/
-	friend std::istream & operator>>(std::istream & s, UInt<value_size> & l)
-	{
-		return InputFromStream<std::istream, std::string, char>(s, l);
+	return 0;
 	}
 
 
-#ifndef TTMATH_DONT_USE_WCHAR
-
 	/*!
-		input from standard streams
+		returning the divisor
 	*/
-	friend std::wistream & operator>>(std::wistream & s, UInt<value_size> & l)
+	const UInt<value_size> & GetDivisor() const
 	{
-		return InputFromStream<std::wistream, std::wstring, wchar_t>(s, l);
+		return divisor;
 	}
 
-#endif
 
+	/*!
+		division value = value / divisor
 
-	/*
-		Following methods are defined in:
-			ttmathuint_x86.h
-			ttmathuint_x86_64.h
-			ttmathuint_noasm.h
+		return values:
+		-  0 - ok
+		-  1 - division by zero ('value' is not changed)
+		-  'remainder' - remainder
 	*/
+	uint Div(UInt<value_size> & value, UInt<value_size> * remainder = 0) const
+	{
+		if( size == 0 )
+			return 1;
 
-#ifdef TTMATH_NOASM
-	static uint AddTwoWords(uint a, uint b, uint carry, uint * result);
-	static uint SubTwoWords(uint a, uint b, uint carry, uint * result);
+		value.Div5_Precomputed(b.table, x.table, v, size, bits, remainder);
 
-#ifdef TTMATH_PLATFORM64
+	return 0;
+	}
 
-	union uint_
-	{
-		struct 
-		{
-			unsigned int low;  // 32 bit 
-			unsigned int high; // 32 bit
-		} u_;
 
-		uint u;                // 64 bit
-	};
+	/*!
+		division value = value / divisor
 
+		return values:
+		-  0 - ok
+		-  1 - division by zero
+		-  'remainder' - remainder
+	*/
+	uint Div(UInt<value_size> & value, UInt<value_size> & remainder) const
+	{
+		return Div(value, &remainder);
+	}
 
-	static void DivTwoWords2(uint a,uint b, uint c, uint * r, uint * rest);
-	static uint DivTwoWordsNormalize(uint_ & a_, uint_ & b_, uint_ & c_);
-	static uint DivTwoWordsUnnormalize(uint u, uint d);
-	static unsigned int DivTwoWordsCalculate(uint_ u_, unsigned int u3, uint_ v_);
-	static void MultiplySubtract(uint_ & u_, unsigned int & u3, unsigned int & q, uint_ v_);
 
-#endif // TTMATH_PLATFORM64
-#endif // TTMATH_NOASM
+	/*!
+		the remainder value = value % divisor
 
+		return values:
+		-  0 - ok
+		-  1 - division by zero ('value' is not changed)
+	*/
+	uint Mod(UInt<value_size> & value) const
+	{
+	UInt<value_size> remainder;
 
-private:
-	uint Rcl2_one(uint c);
-	uint Rcr2_one(uint c);
-	uint Rcl2(uint bits, uint c);
-	uint Rcr2(uint bits, uint c);
+		uint c = Div(value, &remainder);
 
-public:
-	static const char * LibTypeStr();
-	static LibTypeCode LibType();
-	uint Add(const UInt<value_size> & ss2, uint c=0);
-	uint AddInt(uint value, uint index = 0);
-	uint AddTwoInts(uint x2, uint x1, uint index);
-	static uint AddVector(const uint * ss1, const uint * ss2, uint ss1_size, uint ss2_size, uint * result);
-	uint Sub(const UInt<value_size> & ss2, uint c=0);
-	uint SubInt(uint value, uint index = 0);
-	static uint SubVector(const uint * ss1, const uint * ss2, uint ss1_size, uint ss2_size, uint * result);
-	static sint FindLeadingBitInWord(uint x);
-	static sint FindLowestBitInWord(uint x);
-	static uint SetBitInWord(uint & value, uint bit);
-	static void MulTwoWords(uint a, uint b, uint * result_high, uint * result_low);
-	static void DivTwoWords(uint a,uint b, uint c, uint * r, uint * rest);
+		if( c == 0 )
+			value = remainder;
 
-};
+	return c;
+	}
 
 
+	/*!
+		quotient = value / divisor and remainder = value % divisor
 
-/*!
-	this specialization is needed in order to not confuse the compiler "error: ISO C++ forbids zero-size array"
-	when compiling Mul3Big2() method
-*/
-template<>
-class UInt<0>
-{
-public:
-	uint table[1];
+		return values:
+		-  0 - ok
+		-  1 - division by zero
+	*/
+	uint DivMod(const UInt<value_size> & value, UInt<value_size> & quotient, UInt<value_size> & remainder) const
+	{
+		quotient = value;
 
-	void Mul2Big(const UInt<0> &, UInt<0> &) { TTMATH_ASSERT(false) };
-	void SetZero() { TTMATH_ASSERT(false) };
-	uint AddTwoInts(uint, uint, uint) { TTMATH_ASSERT(false) return 0; };
+	return Div(quotient, &remainder);
+	}
 };
 
 
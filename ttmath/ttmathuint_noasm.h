@@ -62,6 +62,7 @@ namespace ttmath
 		-  asm_gcc_64  - with asm for GCC (64 bit)
 		-  no_asm_32   - pure C++ version (32 bit) - without any asm code
 		-  no_asm_64   - pure C++ version (64 bit) - without any asm code
+		-  asm_gcc_64_adx - with asm for GCC (64 bit) and MULX/ADCX/ADOX instructions
 	*/
 	template<uint value_size>
 	const char * UInt<value_size>::LibTypeStr()
@@ -774,6 +775,101 @@ namespace ttmath
 
 
 
+	/*!
+		this static method is used by the squaring algorithms
+
+		it doubles the 'result' vector (which has ss_size*2 words) and adds
+		the squares of the words from 'ss' on the diagonal:
+			result = 2*result + ss[0]^2 + ss[1]^2 * B^2 + ss[2]^2 * B^4 + ...
+		where B = 2^TTMATH_BITS_PER_UINT
+
+		if 'result' is the sum of the products ss[i]*ss[j] (i<j) then after this method
+		'result' is equal ss*ss and there is no carry
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::SqrAddDiagonal(const uint * ss, uint ss_size, uint * result)
+	{
+	uint i, r2, r1, high, c = 0, c_shift = 0;
+
+		for(i=0 ; i<ss_size ; ++i)
+		{
+			MulTwoWords(ss[i], ss[i], &r2, &r1);
+
+			high            = result[i*2] >> (TTMATH_BITS_PER_UINT - 1);
+			result[i*2]     = (result[i*2] << 1) | c_shift;
+			c_shift         = result[i*2 + 1] >> (TTMATH_BITS_PER_UINT - 1);
+			result[i*2 + 1] = (result[i*2 + 1] << 1) | high;
+
+			c = AddTwoWords(result[i*2],     r1, c, &result[i*2]);
+			c = AddTwoWords(result[i*2 + 1], r2, c, &result[i*2 + 1]);
+		}
+
+		c += c_shift;
+
+		TTMATH_VECTOR_LOGC("UInt::SqrAddDiagonal", c, result, ss_size*2)
+
+	return c;
+	}
+
+
+	/*!
+		this static method multiplies the vector 'ss' by one word 'x' and adds the product
+		to the 'result' vector (addmul):
+			result = result + ss * x
+
+		-  ss_size - size of the ss (and size of the result too)
+		-  the method returns the highest word of the sum (the carry which should be
+		   added to result[ss_size])
+
+		(this method is used by the schoolbook multiplication and by the division)
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulAddVector(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+	uint i, r2, r1, c = 0;
+
+		for(i=0 ; i<ss_size ; ++i)
+		{
+			MulTwoWords(ss[i], x, &r2, &r1);
+			r2 += AddTwoWords(r1, c, 0, &r1);
+			c   = r2 + AddTwoWords(result[i], r1, 0, &result[i]);
+		}
+
+		TTMATH_VECTOR_LOGC("UInt::MulAddVector", c, result, ss_size)
+
+	return c;
+	}
+
+
+	/*!
+		this static method multiplies the vector 'ss' by one word 'x' and subtracts the product
+		from the 'result' vector (submul):
+			result = result - ss * x
+
+		-  ss_size - size of the ss (and size of the result too)
+		-  the method returns the borrow (the word which should be subtracted
+		   from result[ss_size])
+
+		(this method is used by the division)
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulSubVector(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+	uint i, r2, r1, c = 0;
+
+		for(i=0 ; i<ss_size ; ++i)
+		{
+			MulTwoWords(ss[i], x, &r2, &r1);
+			r2 += AddTwoWords(r1, c, 0, &r1);
+			c   = r2 + SubTwoWords(result[i], r1, 0, &result[i]);
+		}
+
+		TTMATH_VECTOR_LOGC("UInt::MulSubVector", c, result, ss_size)
+
+	return c;
+	}
+
+
 	/*!
 	 *
 	 * Division
@@ -70,6 +70,7 @@ namespace ttmath
 		-  asm_gcc_64  - with asm for GCC (64 bit)
 		-  no_asm_32   - pure C++ version (32 bit) - without any asm code
 		-  no_asm_64   - pure C++ version (64 bit) - without any asm code
+		-  asm_gcc_64_adx - with asm for GCC (64 bit) and MULX/ADCX/ADOX instructions
 	*/
 	template<uint value_size>
 	const char * UInt<value_size>::LibTypeStr()
@@ -1539,6 +1540,301 @@ namespace ttmath
 
 
 
+	/*!
+		this static method is used by the squaring algorithms
+
+		it doubles the 'result' vector (which has ss_size*2 words) and adds
+		the squares of the words from 'ss' on the diagonal:
+			result = 2*result + ss[0]^2 + ss[1]^2 * B^2 + ss[2]^2 * B^4 + ...
+		where B = 2^32
+
+		if 'result' is the sum of the products ss[i]*ss[j] (i<j) then after this method
+		'result' is equal ss*ss and there is no carry
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::SqrAddDiagonal(const uint * ss, uint ss_size, uint * result)
+	{
+		TTMATH_ASSERT( ss_size > 0 )
+
+		uint c;
+
+		/*
+			there are two chains of carries: from doubling the result (kept in ebx)
+			and from adding the squares (kept in ecx), they are remembered as 0 or -1
+			because 'mul' changes the flags
+		*/
+
+		#ifndef __GNUC__
+
+			//	this part might be compiled with for example visual c
+			uint counter = ss_size;
+
+			__asm
+			{
+				pushad
+
+				mov esi, [ss]
+				mov edi, [result]
+				xor ebx, ebx
+				xor ecx, ecx
+
+			ttmath_loop:
+				mov eax, [esi]
+				mul eax
+
+				neg ebx
+				rcl dword ptr [edi], 1
+				rcl dword ptr [edi+4], 1
+				sbb ebx, ebx
+
+				neg ecx
+				adc [edi], eax
+				adc [edi+4], edx
+				sbb ecx, ecx
+
+				lea esi, [esi+4]
+				lea edi, [edi+8]
+				dec [counter]
+			jnz ttmath_loop
+
+				neg ebx
+				neg ecx
+				add ecx, ebx
+				mov [c], ecx
+
+				popad
+			}
+
+		#endif
+
+
+		#ifdef __GNUC__
+
+		//	this part should be compiled with gcc
+		uint dummy1, dummy2, dummy3, dummy4, dummy5;
+
+			__asm__ __volatile__(
+				"push %%ecx							\n"   // the counter is kept on the stack
+				"xor %%ebx, %%ebx					\n"
+				"xor %%ecx, %%ecx					\n"
+			"1:										\n"
+				"mov (%%esi), %%eax					\n"
+				"mull %%eax							\n"   // edx:eax = ss[i]^2
+
+				"neg %%ebx							\n"   // setting cf from ebx
+				"rcll $1, (%%edi)					\n"
+				"rcll $1, 4(%%edi)					\n"
+				"sbb %%ebx, %%ebx					\n"
+
+				"neg %%ecx							\n"   // setting cf from ecx
+				"adc %%eax, (%%edi)					\n"
+				"adc %%edx, 4(%%edi)				\n"
+				"sbb %%ecx, %%ecx					\n"
+
+				"lea 4(%%esi), %%esi				\n"
+				"lea 8(%%edi), %%edi				\n"
+				"decl (%%esp)						\n"
+			"jnz 1b									\n"
+
+				"pop %%eax							\n"
+				"neg %%ebx							\n"
+				"neg %%ecx							\n"
+				"add %%ebx, %%ecx					\n"
+
+				: "=c" (c), "=a" (dummy1), "=b" (dummy2), "=d" (dummy3), "=S" (dummy4), "=D" (dummy5)
+				: "0" (ss_size), "4" (ss), "5" (result)
+				: "cc", "memory" );
+
+		#endif
+
+		TTMATH_VECTOR_LOGC("UInt::SqrAddDiagonal", c, result, ss_size*2)
+
+	return c;
+	}
+
+
+	/*!
+		this static method multiplies the vector 'ss' by one word 'x' and adds the product
+		to the 'result' vector (addmul):
+			result = result + ss * x
+
+		-  ss_size - size of the ss (and size of the result too)
+		-  the method returns the highest word of the sum (the carry which should be
+		   added to result[ss_size])
+
+		(this method is used by the schoolbook multiplication and by the division)
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulAddVector(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+		if( ss_size == 0 )
+			return 0;
+
+		uint c;
+
+		#ifndef __GNUC__
+
+			//	this part might be compiled with for example visual c
+			__asm
+			{
+				pushad
+
+				mov esi, [ss]
+				mov edi, [result]
+				mov ecx, [ss_size]
+				xor ebx, ebx               // ebx - the carry word
+
+			ttmath_loop:
+				mov eax, [esi]
+				mul dword ptr [x]          // edx:eax = ss[i] * x
+
+				add eax, ebx
+				adc edx, 0
+				add [edi], eax
+				adc edx, 0
+				mov ebx, edx
+
+				lea esi, [esi+4]
+				lea edi, [edi+4]
+				dec ecx
+			jnz ttmath_loop
+
+				mov [c], ebx
+
+				popad
+			}
+
+		#endif
+
+
+		#ifdef __GNUC__
+
+		//	this part should be compiled with gcc
+		uint dummy1, dummy2, dummy3, dummy4, dummy5;
+
+			__asm__ __volatile__(
+				"push %%ebx							\n"   // x is kept on the stack
+				"xor %%ebx, %%ebx					\n"   // ebx - the carry word
+			"1:										\n"
+				"mov (%%esi), %%eax					\n"
+				"mull (%%esp)						\n"   // edx:eax = ss[i] * x
+
+				"add %%ebx, %%eax					\n"
+				"adc $0, %%edx						\n"
+				"add %%eax, (%%edi)					\n"
+				"adc $0, %%edx						\n"
+				"mov %%edx, %%ebx					\n"
+
+				"lea 4(%%esi), %%esi				\n"
+				"lea 4(%%edi), %%edi				\n"
+				"dec %%ecx							\n"
+			"jnz 1b									\n"
+
+				"pop %%eax							\n"
+
+				: "=b" (c), "=c" (dummy1), "=S" (dummy2), "=D" (dummy3), "=a" (dummy4), "=d" (dummy5)
+				: "0" (x), "1" (ss_size), "2" (ss), "3" (result)
+				: "cc", "memory" );
+
+		#endif
+
+		TTMATH_VECTOR_LOGC("UInt::MulAddVector", c, result, ss_size)
+
+	return c;
+	}
+
+
+	/*!
+		this static method multiplies the vector 'ss' by one word 'x' and subtracts the product
+		from the 'result' vector (submul):
+			result = result - ss * x
+
+		-  ss_size - size of the ss (and size of the result too)
+		-  the method returns the borrow (the word which should be subtracted
+		   from result[ss_size])
+
+		(this method is used by the division)
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulSubVector(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+		if( ss_size == 0 )
+			return 0;
+
+		uint c;
+
+		#ifndef __GNUC__
+
+			//	this part might be compiled with for example visual c
+			__asm
+			{
+				pushad
+
+				mov esi, [ss]
+				mov edi, [result]
+				mov ecx, [ss_size]
+				xor ebx, ebx               // ebx - the borrow word
+
+			ttmath_loop:
+				mov eax, [esi]
+				mul dword ptr [x]          // edx:eax = ss[i] * x
+
+				add eax, ebx
+				adc edx, 0
+				sub [edi], eax
+				adc edx, 0
+				mov ebx, edx
+
+				lea esi, [esi+4]
+				lea edi, [edi+4]
+				dec ecx
+			jnz ttmath_loop
+
+				mov [c], ebx
+
+				popad
+			}
+
+		#endif
+
+
+		#ifdef __GNUC__
+
+		//	this part should be compiled with gcc
+		uint dummy1, dummy2, dummy3, dummy4, dummy5;
+
+			__asm__ __volatile__(
+				"push %%ebx							\n"   // x is kept on the stack
+				"xor %%ebx, %%ebx					\n"   // ebx - the borrow word
+			"1:										\n"
+				"mov (%%esi), %%eax					\n"
+				"mull (%%esp)						\n"   // edx:eax = ss[i] * x
+
+				"add %%ebx, %%eax					\n"
+				"adc $0, %%edx						\n"
+				"sub %%eax, (%%edi)					\n"
+				"adc $0, %%edx						\n"
+				"mov %%edx, %%ebx					\n"
+
+				"lea 4(%%esi), %%esi				\n"
+				"lea 4(%%edi), %%edi				\n"
+				"dec %%ecx							\n"
+			"jnz 1b									\n"
+
+				"pop %%eax							\n"
+
+				: "=b" (c), "=c" (dummy1), "=S" (dummy2), "=D" (dummy3), "=a" (dummy4), "=d" (dummy5)
+				: "0" (x), "1" (ss_size), "2" (ss), "3" (result)
+				: "cc", "memory" );
+
+		#endif
+
+		TTMATH_VECTOR_LOGC("UInt::MulSubVector", c, result, ss_size)
+
+	return c;
+	}
+
+
 	/*!
 	 *
 	 * Division
@@ -70,6 +70,10 @@
 #include <intrin.h>
 #endif
 
+#ifdef TTMATH_IFMA
+#include <immintrin.h>
+#endif
+
 
 namespace ttmath
 {
@@ -85,6 +89,9 @@ namespace ttmath
 			uint __fastcall ttmath_sbb_x64(uint* p1, const uint* p2, uint nSize, uint c);
 			uint __fastcall ttmath_subindexed_x64(uint* p1, uint nSize, uint nPos, uint nValue);
 			uint __fastcall ttmath_subvector_x64(const uint * ss1, const uint * ss2, uint ss1_size, uint ss2_size, uint * result);
+			uint __fastcall ttmath_sqradddiagonal_x64(const uint * ss, uint ss_size, uint * result);
+			uint __fastcall ttmath_muladdvector_x64(const uint * ss, uint ss_size, uint x, uint * result);
+			uint __fastcall ttmath_mulsubvector_x64(const uint * ss, uint ss_size, uint x, uint * result);
 			uint __fastcall ttmath_rcl_x64(uint* p1, uint nSize, uint nLowestBit);
 			uint __fastcall ttmath_rcr_x64(uint* p1, uint nSize, uint nLowestBit);
 			uint __fastcall ttmath_div_x64(uint* pnValHi, uint* pnValLo, uint nDiv);
@@ -103,6 +110,8 @@ namespace ttmath
 		  asm_gcc_64  - with asm for GCC (64 bit)
 		  no_asm_32   - pure C++ version (32 bit) - without any asm code
 		  no_asm_64   - pure C++ version (64 bit) - without any asm code
+		  asm_gcc_64_adx - with asm for GCC (64 bit) and MULX/ADCX/ADOX instructions
+		                   (selected at runtime if the processor supports them)
 	*/
 	template<uint value_size>
 	const char * UInt<value_size>::LibTypeStr()
@@ -115,6 +124,13 @@ namespace ttmath
 			static const char info[] = "asm_gcc_64";
 		#endif
 
+		#ifdef TTMATH_ADX
+			static const char info_adx[] = "asm_gcc_64_adx";
+
+			if( IsAdxSupported() )
+				return info_adx;
+		#endif
+
 	return info;
 	}
 
@@ -133,10 +149,130 @@ namespace ttmath
 			LibTypeCode info = asm_gcc_64;
 		#endif
 
+		#ifdef TTMATH_ADX
+			if( IsAdxSupported() )
+				info = asm_gcc_64_adx;
+		#endif
+
 	return info;
 	}
 
 
+#ifdef TTMATH_ADX
+
+	/*!
+		this method checks (by using cpuid) whether the processor supports
+		BMI2 (MULX instruction) and ADX (ADCX and ADOX instructions) extensions
+
+		the instructions don't use any new registers so the operating system
+		doesn't have to support them
+	*/
+	template<uint value_size>
+	bool UInt<value_size>::CheckAdx()
+	{
+	uint a, b, c, d;
+
+		__asm__ __volatile__(
+			"cpuid						\n"
+			: "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+			: "0" (0), "2" (0) );
+
+		if( a < 7 )
+			return false;
+
+		__asm__ __volatile__(
+			"cpuid						\n"
+			: "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+			: "0" (7), "2" (0) );
+
+		// leaf 7, ebx: bit 8 - BMI2, bit 19 - ADX
+	return (b & (uint(1) << 8)) != 0 && (b & (uint(1) << 19)) != 0;
+	}
+
+
+	/*!
+		this method returns true if the processor supports MULX, ADCX and ADOX instructions,
+		in such a case the multiplication kernels (MulAddVector() and SqrAddDiagonal())
+		are using them
+
+		cpuid is called only once
+	*/
+	template<uint value_size>
+	bool UInt<value_size>::IsAdxSupported()
+	{
+		static const bool adx = CheckAdx();
+
+	return adx;
+	}
+
+#endif
+
+
+#ifdef TTMATH_IFMA
+
+	/*!
+		this method checks (by using cpuid) whether the processor supports
+		AVX-512F and AVX-512 IFMA extensions and whether the operating system
+		saves the AVX-512 registers (xgetbv)
+	*/
+	template<uint value_size>
+	bool UInt<value_size>::CheckIfma()
+	{
+	uint a, b, c, d;
+
+		__asm__ __volatile__(
+			"cpuid						\n"
+			: "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+			: "0" (0), "2" (0) );
+
+		if( a < 7 )
+			return false;
+
+		__asm__ __volatile__(
+			"cpuid						\n"
+			: "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+			: "0" (1), "2" (0) );
+
+		// leaf 1, ecx: bit 27 - OSXSAVE (xgetbv is available)
+		if( (c & (uint(1) << 27)) == 0 )
+			return false;
+
+		__asm__ __volatile__(
+			"xgetbv						\n"
+			: "=a" (a), "=d" (d)
+			: "c" (0) );
+
+		// XCR0: SSE, AVX, opmask, upper halves of ZMM0-15 and ZMM16-31 registers
+		if( (a & 0xe6) != 0xe6 )
+			return false;
+
+		__asm__ __volatile__(
+			"cpuid						\n"
+			: "=a" (a), "=b" (b), "=c" (c), "=d" (d)
+			: "0" (7), "2" (0) );
+
+		// leaf 7, ebx: bit 16 - AVX-512F, bit 21 - AVX-512 IFMA
+	return (b & (uint(1) << 16)) != 0 && (b & (uint(1) << 21)) != 0;
+	}
+
+
+	/*!
+		this method returns true if the processor supports AVX-512 IFMA instructions,
+		in such a case Mul6() and Mul6Big() are using them
+
+		cpuid is called only once
+	*/
+	template<uint value_size>
+	bool UInt<value_size>::IsIfmaSupported()
+	{
+		static const bool ifma = CheckIfma();
+
+	return ifma;
+	}
+
+#endif
+
+
 	/*!
 	*
 	*	basic mathematic functions
@@ -1107,6 +1243,488 @@ namespace ttmath
 
 
 
+	/*!
+		this static method is used by the squaring algorithms
+
+		it doubles the 'result' vector (which has ss_size*2 words) and adds
+		the squares of the words from 'ss' on the diagonal:
+			result = 2*result + ss[0]^2 + ss[1]^2 * B^2 + ss[2]^2 * B^4 + ...
+		where B = 2^64
+
+		if 'result' is the sum of the products ss[i]*ss[j] (i<j) then after this method
+		'result' is equal ss*ss and there is no carry
+
+		***this method is created only on a 64bit platform***
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::SqrAddDiagonal(const uint * ss, uint ss_size, uint * result)
+	{
+		TTMATH_ASSERT( ss_size > 0 )
+
+		uint c;
+
+		#ifndef __GNUC__
+			c = ttmath_sqradddiagonal_x64(ss, ss_size, result);
+		#endif
+
+
+		#ifdef __GNUC__
+		uint dummy1, dummy2, dummy3, dummy4;
+
+			#ifdef TTMATH_ADX
+				if( IsAdxSupported() )
+					return SqrAddDiagonalAdx(ss, ss_size, result);
+			#endif
+
+			/*
+				there are two chains of carries: from doubling the result (kept in r8)
+				and from adding the squares (kept in r9), they are remembered as 0 or -1
+				because 'mul' changes the flags
+			*/
+			__asm__ __volatile__(
+				"xor %%r8, %%r8						\n"
+				"xor %%r9, %%r9						\n"
+			"1:										\n"
+				"mov (%%rsi), %%rax					\n"
+				"mul %%rax							\n"   // rdx:rax = ss[i]^2
+
+				"mov (%%rdi), %%r10					\n"
+				"mov 8(%%rdi), %%r11				\n"
+
+				"neg %%r8							\n"   // setting cf from r8
+				"adc %%r10, %%r10					\n"
+				"adc %%r11, %%r11					\n"
+				"sbb %%r8, %%r8						\n"
+
+				"neg %%r9							\n"   // setting cf from r9
+				"adc %%rax, %%r10					\n"
+				"adc %%rdx, %%r11					\n"
+				"sbb %%r9, %%r9						\n"
+
+				"mov %%r10, (%%rdi)					\n"
+				"mov %%r11, 8(%%rdi)				\n"
+
+				"lea 8(%%rsi), %%rsi				\n"
+				"lea 16(%%rdi), %%rdi				\n"
+				"dec %%rcx							\n"
+			"jnz 1b									\n"
+
+				"sub %%r8, %%rcx					\n"   // rcx is zero here
+				"sub %%r9, %%rcx					\n"
+
+				: "=c" (c), "=a" (dummy1), "=d" (dummy2), "=S" (dummy3), "=D" (dummy4)
+				: "0" (ss_size), "3" (ss), "4" (result)
+				: "%r8", "%r9", "%r10", "%r11", "cc", "memory" );
+
+		#endif
+
+		TTMATH_VECTOR_LOGC("UInt::SqrAddDiagonal", c, result, ss_size*2)
+
+	return c;
+	}
+
+
+	/*!
+		this static method multiplies the vector 'ss' by one word 'x' and adds the product
+		to the 'result' vector (addmul):
+			result = result + ss * x
+
+		-  ss_size - size of the ss (and size of the result too)
+		-  the method returns the highest word of the sum (the carry which should be
+		   added to result[ss_size])
+
+		(this method is used by the schoolbook multiplication and by the division)
+
+		***this method is created only on a 64bit platform***
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulAddVector(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+		if( ss_size == 0 )
+			return 0;
+
+		uint c;
+
+		#ifndef __GNUC__
+			c = ttmath_muladdvector_x64(ss, ss_size, x, result);
+		#endif
+
+
+		#ifdef __GNUC__
+		uint dummy1, dummy2, dummy3, dummy4;
+
+			#ifdef TTMATH_ADX
+				if( IsAdxSupported() )
+					return MulAddVectorAdx(ss, ss_size, x, result);
+			#endif
+
+			__asm__ __volatile__(
+				"xor %[c], %[c]						\n"   // c - the carry word
+			"1:										\n"
+				"mov (%%rsi), %%rax					\n"
+				"mulq %[x]							\n"   // rdx:rax = ss[i] * x
+
+				"add %[c], %%rax					\n"
+				"adc $0, %%rdx						\n"
+				"add %%rax, (%%rdi)					\n"
+				"adc $0, %%rdx						\n"
+				"mov %%rdx, %[c]					\n"
+
+				"lea 8(%%rsi), %%rsi				\n"
+				"lea 8(%%rdi), %%rdi				\n"
+				"dec %%rcx							\n"
+			"jnz 1b									\n"
+
+				: [c] "=&r" (c), "=c" (dummy1), "=S" (dummy2), "=D" (dummy3), "=&a" (dummy4)
+				: "1" (ss_size), "2" (ss), "3" (result), [x] "r" (x)
+				: "%rdx", "cc", "memory" );
+
+		#endif
+
+		TTMATH_VECTOR_LOGC("UInt::MulAddVector", c, result, ss_size)
+
+	return c;
+	}
+
+
+#ifdef TTMATH_ADX
+
+	/*!
+		the same as SqrAddDiagonal() but with MULX, ADCX and ADOX instructions
+
+		MULX doesn't change the flags so both chains of carries are kept in the flags:
+		CF for doubling the result (ADCX) and OF for adding the squares (ADOX)
+
+		***this method is created only on a 64bit platform***
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::SqrAddDiagonalAdx(const uint * ss, uint ss_size, uint * result)
+	{
+		TTMATH_ASSERT( ss_size > 0 )
+
+		uint c;
+		uint dummy1, dummy2;
+
+			__asm__ __volatile__(
+				"xor %%r8d, %%r8d					\n"   // r8 = 0, cf = 0, of = 0
+			"1:										\n"
+				"mov (%%rsi), %%rdx					\n"
+				"mulx %%rdx, %%rax, %%r9			\n"   // r9:rax = ss[i]^2
+
+				"mov (%%rdi), %%r10					\n"
+				"mov 8(%%rdi), %%r11				\n"
+
+				"adcx %%r10, %%r10					\n"
+				"adcx %%r11, %%r11					\n"
+				"adox %%rax, %%r10					\n"
+				"adox %%r9, %%r11					\n"
+
+				"mov %%r10, (%%rdi)					\n"
+				"mov %%r11, 8(%%rdi)				\n"
+
+				"lea 8(%%rsi), %%rsi				\n"
+				"lea 16(%%rdi), %%rdi				\n"
+				"lea -1(%%rcx), %%rcx				\n"   // lea and jrcxz don't change the flags
+				"jrcxz 2f							\n"
+				"jmp 1b								\n"
+			"2:										\n"
+				"adcx %%r8, %%rcx					\n"   // rcx is zero here
+				"adox %%r8, %%rcx					\n"
+
+				: "=c" (c), "=S" (dummy1), "=D" (dummy2)
+				: "0" (ss_size), "1" (ss), "2" (result)
+				: "%rax", "%rdx", "%r8", "%r9", "%r10", "%r11", "cc", "memory" );
+
+		TTMATH_VECTOR_LOGC("UInt::SqrAddDiagonalAdx", c, result, ss_size*2)
+
+	return c;
+	}
+
+
+	/*!
+		the same as MulAddVector() but with MULX, ADCX and ADOX instructions
+
+		there are two chains of carries: CF (ADCX) when adding the high word of the previous
+		product to the low word of the next one, and OF (ADOX) when adding the product to 'result',
+		the loop is unrolled twice
+
+		***this method is created only on a 64bit platform***
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulAddVectorAdx(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+		TTMATH_ASSERT( ss_size > 0 )
+
+		uint c;
+		uint dummy1, dummy2, dummy3;
+
+			__asm__ __volatile__(
+				"mov %%rcx, %%r11					\n"
+				"shr $1, %%rcx						\n"   // rcx - how many pairs of words
+				"xor %%r10d, %%r10d					\n"   // r10 - the high word of the previous product
+				"test $1, %%r11b					\n"   // cf = 0, of = 0
+				"jz 1f								\n"
+
+				"mulx (%%rsi), %%r8, %%r10			\n"   // the first word when ss_size is odd
+				"adox (%%rdi), %%r8					\n"
+				"mov %%r8, (%%rdi)					\n"
+				"lea 8(%%rsi), %%rsi				\n"
+				"lea 8(%%rdi), %%rdi				\n"
+			"1:										\n"
+				"jrcxz 3f							\n"
+			"2:										\n"
+				"mulx (%%rsi), %%r8, %%r9			\n"   // r9:r8 = ss[i] * x
+				"adcx %%r10, %%r8					\n"
+				"adox (%%rdi), %%r8					\n"
+				"mov %%r8, (%%rdi)					\n"
+
+				"mulx 8(%%rsi), %%r10, %%r11		\n"   // r11:r10 = ss[i+1] * x
+				"adcx %%r9, %%r10					\n"
+				"adox 8(%%rdi), %%r10				\n"
+				"mov %%r10, 8(%%rdi)				\n"
+				"mov %%r11, %%r10					\n"
+
+				"lea 16(%%rsi), %%rsi				\n"
+				"lea 16(%%rdi), %%rdi				\n"
+				"lea -1(%%rcx), %%rcx				\n"   // lea and jrcxz don't change the flags
+				"jrcxz 3f							\n"
+				"jmp 2b								\n"
+			"3:										\n"
+				"mov $0, %%eax						\n"
+				"adcx %%r10, %%rax					\n"   // rax = r10 + cf + of (there is no carry from this sum)
+				"adox %%rcx, %%rax					\n"   // rcx is zero here
+
+				: "=a" (c), "=c" (dummy1), "=S" (dummy2), "=D" (dummy3)
+				: "1" (ss_size), "2" (ss), "3" (result), "d" (x)
+				: "%r8", "%r9", "%r10", "%r11", "cc", "memory" );
+
+		TTMATH_VECTOR_LOGC("UInt::MulAddVectorAdx", c, result, ss_size)
+
+	return c;
+	}
+
+#endif
+
+
+	/*!
+		this static method multiplies the vector 'ss' by one word 'x' and subtracts the product
+		from the 'result' vector (submul):
+			result = result - ss * x
+
+		-  ss_size - size of the ss (and size of the result too)
+		-  the method returns the borrow (the word which should be subtracted
+		   from result[ss_size])
+
+		(this method is used by the division)
+
+		***this method is created only on a 64bit platform***
+	*/
+	template<uint value_size>
+	uint UInt<value_size>::MulSubVector(const uint * ss, uint ss_size, uint x, uint * result)
+	{
+		if( ss_size == 0 )
+			return 0;
+
+		uint c;
+
+		#ifndef __GNUC__
+			c = ttmath_mulsubvector_x64(ss, ss_size, x, result);
+		#endif
+
+
+		#ifdef __GNUC__
+		uint dummy1, dummy2, dummy3, dummy4;
+
+			__asm__ __volatile__(
+				"xor %[c], %[c]						\n"   // c - the borrow word
+			"1:										\n"
+				"mov (%%rsi), %%rax					\n"
+				"mulq %[x]							\n"   // rdx:rax = ss[i] * x
+
+				"add %[c], %%rax					\n"
+				"adc $0, %%rdx						\n"
+				"sub %%rax, (%%rdi)					\n"
+				"adc $0, %%rdx						\n"
+				"mov %%rdx, %[c]					\n"
+
+				"lea 8(%%rsi), %%rsi				\n"
+				"lea 8(%%rdi), %%rdi				\n"
+				"dec %%rcx							\n"
+			"jnz 1b									\n"
+
+				: [c] "=&r" (c), "=c" (dummy1), "=S" (dummy2), "=D" (dummy3), "=&a" (dummy4)
+				: "1" (ss_size), "2" (ss), "3" (result), [x] "r" (x)
+				: "%rdx", "cc", "memory" );
+
+		#endif
+
+		TTMATH_VECTOR_LOGC("UInt::MulSubVector", c, result, ss_size)
+
+	return c;
+	}
+
+
+#ifdef TTMATH_IFMA
+
+	/*!
+		an auxiliary method for the IFMA multiplication
+
+		it converts the ss vector (ss_size words) into limbs_size limbs of 52 bits
+		(limbs_size is equal (ss_size*64 + 51) / 52)
+	*/
+	template<uint value_size>
+	void UInt<value_size>::Mul6ToLimbs(const uint * ss, uint ss_size, uint * limbs, uint limbs_size)
+	{
+	const uint mask = (uint(1) << 52) - 1;
+
+		for(uint i=0 ; i<limbs_size ; ++i)
+		{
+			uint bit    = i * 52;
+			uint word   = bit / TTMATH_BITS_PER_UINT;
+			uint offset = bit % TTMATH_BITS_PER_UINT;
+			uint limb   = ss[word] >> offset;
+
+			if( offset > TTMATH_BITS_PER_UINT - 52 && word + 1 < ss_size )
+				limb |= ss[word+1] << (TTMATH_BITS_PER_UINT - offset);
+
+			limbs[i] = limb & mask;
+		}
+	}
+
+
+	/*!
+		an auxiliary method for the IFMA multiplication (product scanning)
+
+		the values are converted to 52-bit limbs, the 'b' limbs are surrounded by eight zeroes
+		on both sides so for eight columns (c, c+1, ... c+7) of the product we can load
+		b[c-p], b[c+1-p], ... b[c+7-p] by one (unaligned) load and multiply them by a[p],
+		the low 52 bits of the products are added to the columns c+i and the high 52 bits
+		to the columns c+i+1 (there are four pairs of accumulators to hide the latency
+		of vpmadd52luq and vpmadd52huq)
+
+		a sum in one column is smaller than 2*min(limbs1,limbs2)*2^52 so it fits in a word,
+		at the end the carries are propagated and the limbs are converted back to words
+
+		'buffer' has to have Mul6BufferSize(x1size, x2size) words,
+		'result' has result_size words (result_size >= x1size + x2size)
+	*/
+	template<uint value_size>
+	void UInt<value_size>::Mul6Big3(const uint * ss1, uint x1size, const uint * ss2, uint x2size,
+									uint * result, uint result_size, uint * buffer)
+	{
+	const uint mask = (uint(1) << 52) - 1;
+	uint limbs1  = (x1size * TTMATH_BITS_PER_UINT + 51) / 52;
+	uint limbs2  = (x2size * TTMATH_BITS_PER_UINT + 51) / 52;
+	uint columns = limbs1 + limbs2;
+	uint * a     = buffer;
+	uint * b     = a + limbs1;
+	uint * r     = b + limbs2 + 16;
+	uint c, p, i;
+
+		TTMATH_ASSERT( result_size >= x1size + x2size )
+
+		Mul6ToLimbs(ss1, x1size, a, limbs1);
+		Mul6ToLimbs(ss2, x2size, b + 8, limbs2);
+
+		for(i=0 ; i<8 ; ++i)
+		{
+			b[i] = 0;
+			b[limbs2 + 8 + i] = 0;
+		}
+
+		__m512i hi_prev = _mm512_setzero_si512();
+
+		for(c=0 ; c<columns ; c+=8)
+		{
+			__m512i lo0 = _mm512_setzero_si512(), hi0 = _mm512_setzero_si512();
+			__m512i lo1 = _mm512_setzero_si512(), hi1 = _mm512_setzero_si512();
+			__m512i lo2 = _mm512_setzero_si512(), hi2 = _mm512_setzero_si512();
+			__m512i lo3 = _mm512_setzero_si512(), hi3 = _mm512_setzero_si512();
+
+			// a[p] is used for the columns from p to p+limbs2-1
+			uint p_first = (c + 1 > limbs2) ? c + 1 - limbs2 : 0;
+			uint p_last  = (c + 8 < limbs1) ? c + 8 : limbs1;
+			const uint * bc = b + 8 + c;
+
+			for(p=p_first ; p+4 <= p_last ; p+=4)
+			{
+				__m512i b0 = _mm512_loadu_si512((const void*)(bc - p));
+				__m512i b1 = _mm512_loadu_si512((const void*)(bc - p - 1));
+				__m512i b2 = _mm512_loadu_si512((const void*)(bc - p - 2));
+				__m512i b3 = _mm512_loadu_si512((const void*)(bc - p - 3));
+				__m512i a0 = _mm512_set1_epi64(sint(a[p]));
+				__m512i a1 = _mm512_set1_epi64(sint(a[p+1]));
+				__m512i a2 = _mm512_set1_epi64(sint(a[p+2]));
+				__m512i a3 = _mm512_set1_epi64(sint(a[p+3]));
+
+				lo0 = _mm512_madd52lo_epu64(lo0, a0, b0);
+				hi0 = _mm512_madd52hi_epu64(hi0, a0, b0);
+				lo1 = _mm512_madd52lo_epu64(lo1, a1, b1);
+				hi1 = _mm512_madd52hi_epu64(hi1, a1, b1);
+				lo2 = _mm512_madd52lo_epu64(lo2, a2, b2);
+				hi2 = _mm512_madd52hi_epu64(hi2, a2, b2);
+				lo3 = _mm512_madd52lo_epu64(lo3, a3, b3);
+				hi3 = _mm512_madd52hi_epu64(hi3, a3, b3);
+			}
+
+			for( ; p<p_last ; ++p)
+			{
+				__m512i b0 = _mm512_loadu_si512((const void*)(bc - p));
+				__m512i a0 = _mm512_set1_epi64(sint(a[p]));
+
+				lo0 = _mm512_madd52lo_epu64(lo0, a0, b0);
+				hi0 = _mm512_madd52hi_epu64(hi0, a0, b0);
+			}
+
+			__m512i lo = _mm512_add_epi64(_mm512_add_epi64(lo0, lo1), _mm512_add_epi64(lo2, lo3));
+			__m512i hi = _mm512_add_epi64(_mm512_add_epi64(hi0, hi1), _mm512_add_epi64(hi2, hi3));
+
+			// the high parts belong to the next columns: (hi_prev[7], hi[0], ... hi[6])
+			// (the maskz version because GCC 12 gives a false warning with _mm512_alignr_epi64)
+			lo = _mm512_add_epi64(lo, _mm512_maskz_alignr_epi64(0xff, hi, hi_prev, 7));
+			_mm512_storeu_si512((void*)(r + c), lo);
+			hi_prev = hi;
+		}
+
+		// c is the first column after the last block of eight columns
+		// (it gets only the high part from the last column of the block)
+		uint tail[8];
+		_mm512_storeu_si512((void*)tail, hi_prev);
+		r[c] = tail[7];
+
+		for(i=0 ; i<result_size ; ++i)
+			result[i] = 0;
+
+		// propagating the carries and converting the limbs back to words
+		uint carry = 0;
+
+		for(p=0 ; p<=c ; ++p)
+		{
+			uint sum  = r[p] + carry;
+			uint limb = sum & mask;
+			carry     = sum >> 52;
+
+			if( limb != 0 )
+			{
+				uint bit    = p * 52;
+				uint word   = bit / TTMATH_BITS_PER_UINT;
+				uint offset = bit % TTMATH_BITS_PER_UINT;
+
+				TTMATH_ASSERT( word < result_size )
+				result[word] |= limb << offset;
+
+				if( offset > TTMATH_BITS_PER_UINT - 52 && word + 1 < result_size )
+					result[word+1] |= limb >> (TTMATH_BITS_PER_UINT - offset);
+			}
+		}
+
+		TTMATH_ASSERT( carry == 0 )
+		TTMATH_VECTOR_LOG("UInt::Mul6Big3", result, result_size)
+	}
+
+#endif
+
+
 	/*!
 	 *
 	 * Division
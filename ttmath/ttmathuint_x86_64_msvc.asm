@@ -53,6 +53,10 @@ PUBLIC	ttmath_sbb_x64
 PUBLIC	ttmath_subindexed_x64
 PUBLIC	ttmath_subvector_x64
 
+PUBLIC	ttmath_sqradddiagonal_x64
+PUBLIC	ttmath_muladdvector_x64
+PUBLIC	ttmath_mulsubvector_x64
+
 PUBLIC	ttmath_rcl_x64
 PUBLIC	ttmath_rcr_x64
 
@@ -363,6 +367,136 @@ ttmath_subvector_x64				ENDP
 
 
 
+;----------------------------------------
+
+        ALIGN       8
+
+;----------------------------------------
+
+ttmath_sqradddiagonal_x64	PROC
+        ; rcx = ss
+        ; rdx = ss_size
+        ; r8 = result
+
+        ; result = 2*result + ss[0]^2 + ss[1]^2 * B^2 + ...
+        ; r9  = carry from doubling the result (0 or -1)
+        ; r11 = carry from adding the squares (0 or -1)
+
+        mov		r10, rcx
+        mov		rcx, rdx
+        xor		r9, r9
+        xor		r11, r11
+
+		ALIGN 16
+loop1:
+		mov		rax, qword ptr [r10]
+		mul		rax
+
+		neg		r9
+		rcl		qword ptr [r8], 1
+		rcl		qword ptr [r8+8], 1
+		sbb		r9, r9
+
+		neg		r11
+		adc		qword ptr [r8], rax
+		adc		qword ptr [r8+8], rdx
+		sbb		r11, r11
+
+		lea		r10, [r10+8]
+		lea		r8, [r8+16]
+		dec		rcx
+		jnz		loop1
+
+		neg		r9
+		neg		r11
+		lea		rax, [r9+r11]
+
+		ret
+
+ttmath_sqradddiagonal_x64	ENDP
+
+;----------------------------------------
+
+        ALIGN       8
+
+;----------------------------------------
+
+ttmath_muladdvector_x64	PROC
+        ; rcx = ss
+        ; rdx = ss_size
+        ; r8 = x
+        ; r9 = result
+
+        ; result = result + ss * x
+        ; r11 = the carry word
+
+        mov		r10, rcx
+        mov		rcx, rdx
+        xor		r11, r11
+
+		ALIGN 16
+loop1:
+		mov		rax, qword ptr [r10]
+		mul		r8
+
+		add		rax, r11
+		adc		rdx, 0
+		add		qword ptr [r9], rax
+		adc		rdx, 0
+		mov		r11, rdx
+
+		lea		r10, [r10+8]
+		lea		r9, [r9+8]
+		dec		rcx
+		jnz		loop1
+
+		mov		rax, r11
+
+		ret
+
+ttmath_muladdvector_x64	ENDP
+
+;----------------------------------------
+
+        ALIGN       8
+
+;----------------------------------------
+
+ttmath_mulsubvector_x64	PROC
+        ; rcx = ss
+        ; rdx = ss_size
+        ; r8 = x
+        ; r9 = result
+
+        ; result = result - ss * x
+        ; r11 = the borrow word
+
+        mov		r10, rcx
+        mov		rcx, rdx
+        xor		r11, r11
+
+		ALIGN 16
+loop1:
+		mov		rax, qword ptr [r10]
+		mul		r8
+
+		add		rax, r11
+		adc		rdx, 0
+		sub		qword ptr [r9], rax
+		adc		rdx, 0
+		mov		r11, rdx
+
+		lea		r10, [r10+8]
+		lea		r9, [r9+8]
+		dec		rcx
+		jnz		loop1
+
+		mov		rax, r11
+
+		ret
+
+ttmath_mulsubvector_x64	ENDP
+
 ;----------------------------------------
 
         ALIGN       8